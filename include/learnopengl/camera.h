@@ -10,6 +10,7 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <learnopengl/frustum.h>
 #include <vector>
 
 // abstraction to stay away from windowing system specific input methods
@@ -26,13 +27,28 @@ const float PITCH = 0.0f;
 const float SPEED = 5.0f;
 const float SENSITIVITY = 0.1f;
 const float ZOOM = 45.0f;
+const float PERSPECTIVE_ASPECT = 800.0f / 600.0f;
+const float PERSPECTIVE_NEAR = 0.1f;
+const float PERSPECTIVE_FAR = 100.0f;
 
 class Camera {
 public:
 	// vector and scalar constructors
 	Camera(glm::vec3 position = glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3 up = glm::vec3(0.0f, 1.0f, 0.0f), float yaw = YAW, float pitch = PITCH);
 	Camera(float xPos, float yPos, float zPos, float xUp, float yUp, float zUp, float yaw, float pitch);
-	glm::mat4 getViewMatrix();
+	// the matrices are cached and only rebuilt after the camera moved, turned, zoomed or changed its projection
+	const glm::mat4& getViewMatrix();
+	// perspective over the current zoom; cheap to call every frame, nothing changes unless the arguments do
+	void setPerspective(float aspectRatio, float nearPlane, float farPlane);
+	const glm::mat4& getProjectionMatrix();
+	const glm::mat4& getViewProjectionMatrix();
+	// world-space view frustum of the view and setPerspective's projection, with normalized planes
+	const Frustum& getFrustum();
+	// world-space view frustum for this camera's view and the given projection
+	Frustum getFrustum(const glm::mat4& projection);
+	// bumped by every change to the view or projection; work depending only on the camera, such as
+	// culling results or shadow cascades, can be kept while it stays the same
+	unsigned long long getVersion() const;
 	void processKeyboard(CameraMovement direction, float deltaTime);
 	void processMouseMovement(float xOffset, float yOffset, GLboolean constrainPitch = true);
 	void processMouseScroll(float yOffset);
@@ -40,6 +56,7 @@ public:
 	glm::vec3 getFront();
 	float getFOV();
 	float getYaw();
+	// rebuilds the camera vectors and marks the view dirty
 	void setYaw(float yaw);
 private:
 	// camera attributes
@@ -55,5 +72,21 @@ private:
 	float movementSpeed;
 	float mouseSensitivity;
 	float zoom;
+	// projection
+	float aspectRatio;
+	float nearPlane;
+	float farPlane;
+	// cached matrices, valid unless their dirty flag is set
+	glm::mat4 view;
+	glm::mat4 projection;
+	glm::mat4 viewProjection;
+	Frustum frustum;
+	bool viewDirty;
+	bool projectionDirty;
+	// viewProjection and frustum
+	bool combinedDirty;
+	unsigned long long version;
 	void updateCameraVectors();
+	void markViewDirty();
+	void markProjectionDirty();
 };
\ No newline at end of file
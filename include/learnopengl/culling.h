@@ -0,0 +1,99 @@
+/**
+ * @file culling.h
+ * @brief Batched frustum culling of bounding spheres and boxes
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <learnopengl/frustum.h>
+#include <cstddef>
+#include <iostream>
+#include <vector>
+
+/**
+ * @class BoundingSpheres - bounding spheres stored as a structure of arrays
+ * padded to a multiple of 8, culled by Culling's current path.
+ */
+class BoundingSpheres {
+public:
+	void clear();
+	std::size_t size() const;
+	// index of the new sphere
+	unsigned int add(const glm::vec3& center, float radius);
+	void set(unsigned int i, const glm::vec3& center, float radius);
+	// one sphere per matrix, the local sphere transformed; radii grow by the largest axis scale
+	void assign(const glm::mat4* matrices, std::size_t count, const glm::vec3& center, float radius);
+	// replace visible with the indices of the spheres intersecting frustum, in order; returns the count
+	std::size_t cull(const Frustum& frustum, std::vector<unsigned int>& visible) const;
+private:
+	friend class Culling;
+	std::size_t count = 0;
+	std::vector<float> centerX, centerY, centerZ, radius;
+	void resize(std::size_t count);
+};
+
+/**
+ * @class BoundingBoxes - axis-aligned boxes stored as a structure of arrays
+ * padded to a multiple of 8. Each plane tests the corner farthest along its
+ * normal, so a box is only rejected when it lies entirely outside one plane.
+ */
+class BoundingBoxes {
+public:
+	void clear();
+	std::size_t size() const;
+	// index of the new box
+	unsigned int add(const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+	void set(unsigned int i, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+	// one box per matrix, the box around the transformed local box
+	void assign(const glm::mat4* matrices, std::size_t count, const glm::vec3& boundsMin, const glm::vec3& boundsMax);
+	// replace visible with the indices of the boxes intersecting frustum, in order; returns the count
+	std::size_t cull(const Frustum& frustum, std::vector<unsigned int>& visible) const;
+private:
+	friend class Culling;
+	std::size_t count = 0;
+	std::vector<float> minX, minY, minZ, maxX, maxY, maxZ;
+	void resize(std::size_t count);
+};
+
+/**
+ * @class Culling - runs the cull() of BoundingSpheres and BoundingBoxes.
+ * The path is picked once from what the CPU supports: AVX2 tests 8 bounds
+ * per step and writes their indices with one store, SSE tests 4, and the
+ * scalar path needs neither. Batches of at least PARALLEL_THRESHOLD are
+ * split into CHUNK_SIZE runs over parallelFor and compacted in order
+ * afterwards. It also counts the bounds tested and how many were rejected,
+ * for diagnostics.
+ */
+class Culling {
+public:
+	enum class Path { SCALAR, SSE, AVX2 };
+	// the fastest path this CPU and build support
+	static Path getBestPath();
+	static Path getPath();
+	// for comparisons; paths the CPU lacks fall back to the best supported one
+	static void setPath(Path path);
+	static const char* getPathName(Path path);
+	// whether batches of at least PARALLEL_THRESHOLD are split over parallelFor, on by default
+	static void setParallel(bool parallel);
+	static bool getParallel();
+	static unsigned long long getTested();
+	static unsigned long long getCulled();
+	static void resetCounters();
+	static void printCounters(std::ostream& out = std::cout);
+private:
+	friend class BoundingSpheres;
+	friend class BoundingBoxes;
+	Culling() {}
+	static const std::size_t PARALLEL_THRESHOLD = 262144;
+	// a multiple of 8 so only the last chunk holds padding
+	static const std::size_t CHUNK_SIZE = 32768;
+	static Path path;
+	static bool parallel;
+	static unsigned long long tested;
+	static unsigned long long culled;
+	// arrays of the bounds' layout; spheres use 4, boxes 6
+	static std::size_t cull(const float* const* arrays, bool boxes, std::size_t count, const Frustum& frustum,
+		std::vector<unsigned int>& visible);
+};
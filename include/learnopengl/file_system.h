@@ -0,0 +1,41 @@
+/**
+ * @file file_system.h
+ * @brief Read-only file mapping and directory helpers
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @class MappedFile - maps a whole file read-only into the address space
+ * (mmap on POSIX, a file mapping on Windows). The contents are paged in on
+ * first touch and can be handed to the driver without an intermediate copy.
+ */
+class MappedFile {
+public:
+	MappedFile();
+	MappedFile(const MappedFile& other) = delete;
+	MappedFile& operator=(const MappedFile& other) = delete;
+	~MappedFile();
+	bool open(const std::string& path);
+	void close();
+	bool isOpen() const;
+	const char* data() const;
+	std::size_t size() const;
+private:
+	const char* mapping;
+	std::size_t length;
+#ifdef _WIN32
+	void* fileHandle;
+	void* mappingHandle;
+#endif
+};
+
+// create every missing directory along a '/' separated path
+void makeDirectories(const std::string& path);
+
+// absolute path with '.', '..' and symbolic links resolved, the path itself if it does not exist
+std::string canonicalPath(const std::string& path);
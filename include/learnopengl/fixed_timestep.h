@@ -0,0 +1,50 @@
+/**
+ * @file fixed_timestep.h
+ * @brief Fixed simulation ticks decoupled from the render rate
+ * @date October 2026
+ */
+
+#pragma once
+
+/**
+ * @class FixedTimestepLoop - paces a simulation that always advances by the
+ * same tick, whatever the frame rate. advance() adds the real time since the
+ * last frame, scaled by the time scale, to an accumulator and hands back how
+ * many whole ticks it holds; the remainder becomes getAlpha(), the fraction
+ * of a tick to blend the last two simulated states by when rendering. Time
+ * is kept in doubles on a steady clock, so it neither loses precision over a
+ * long session nor jumps with the wall clock. A frame longer than
+ * MAX_FRAME_SECONDS only counts that long, so a stall slows the simulation
+ * down instead of making every later frame catch up.
+ */
+class FixedTimestepLoop {
+public:
+	static const double DEFAULT_TICK;
+	static const double MAX_FRAME_SECONDS;
+	explicit FixedTimestepLoop(double tick = DEFAULT_TICK);
+	// seconds of simulation per tick
+	double getTick() const;
+	// simulated seconds per real second, above 1 the simulation runs faster than real time and 0 pauses it
+	void setTimeScale(double scale);
+	double getTimeScale() const;
+	// call once per frame; the number of ticks to simulate before rendering
+	unsigned int advance();
+	// the moment on now()'s clock that tick i of the last advance() stands for, so input stamped with now()
+	// can be applied to the tick it happened in
+	double getTickTime(unsigned int i) const;
+	// how far the accumulator is into the next tick, in [0, 1)
+	float getAlpha() const;
+	// simulated seconds and ticks since construction
+	double getTime() const;
+	unsigned long long getTickCount() const;
+	// seconds on a steady clock since its first use
+	static double now();
+private:
+	double tick;
+	double timeScale;
+	double lastFrame;
+	double accumulator;
+	// ticks returned by the last advance()
+	unsigned int lastCount;
+	unsigned long long ticks;
+};
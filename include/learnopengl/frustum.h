@@ -0,0 +1,26 @@
+/**
+ * @file frustum.h
+ * @brief View frustum planes and single bounds tests
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+/**
+ * @struct Frustum - the six planes of a clip matrix, extracted from its rows
+ * (Gribb and Hartmann). Normals point inwards and are normalized, so
+ * dot(xyz, p) + w is the signed distance of p from a plane.
+ */
+struct Frustum {
+	enum Plane { LEFT, RIGHT, BOTTOM, TOP, NEAR_PLANE, FAR_PLANE, NUM_PLANES };
+	glm::vec4 planes[NUM_PLANES];
+	// planes in the space clip maps from: world space for a view-projection matrix
+	static Frustum fromMatrix(const glm::mat4& clip);
+	// the same frustum in the space model maps from, so object-space bounds can be tested as they are
+	Frustum transformed(const glm::mat4& model) const;
+	// false only when the bounds lie entirely outside one plane
+	bool intersectsSphere(const glm::vec3& center, float radius) const;
+	bool intersectsBox(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const;
+};
@@ -0,0 +1,125 @@
+/**
+ * @file geometry_arena.h
+ * @brief Shared vertex and index buffers sub-allocated between meshes
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include <learnopengl/vertex_format.h>
+#include <cstddef>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class GeometryArena;
+
+/**
+ * @class FreeListAllocator - hands out ranges of a linear space. Free ranges
+ * are kept by offset, to merge neighbors when a range is freed, and by size,
+ * for a best-fit search. Sizes and offsets are in caller-chosen units.
+ */
+class FreeListAllocator {
+public:
+	static const std::size_t INVALID = ~std::size_t(0);
+	explicit FreeListAllocator(std::size_t capacity = 0);
+	// INVALID if no free range is large enough
+	std::size_t allocate(std::size_t size);
+	void free(std::size_t offset, std::size_t size);
+	// append free space at the end
+	void grow(std::size_t capacity);
+	// everything below used is allocated, the rest is one free range, as after compaction
+	void reset(std::size_t capacity, std::size_t used);
+	std::size_t getCapacity() const;
+	std::size_t getFree() const;
+	std::size_t getLargestFree() const;
+	// 0 while the free space is one range, approaching 1 as it splinters
+	float getFragmentation() const;
+private:
+	std::size_t capacity;
+	std::size_t freeSpace;
+	std::map<std::size_t, std::size_t> rangesByOffset;
+	std::multimap<std::size_t, std::size_t> rangesBySize;
+	void insertRange(std::size_t offset, std::size_t size);
+	void eraseRange(std::map<std::size_t, std::size_t>::iterator range);
+};
+
+/**
+ * @class GeometryHandle - owns an allocation in a GeometryArena and frees it
+ * when destroyed. Move-only, so a Mesh holding one stays movable.
+ */
+class GeometryHandle {
+public:
+	GeometryHandle();
+	GeometryHandle(const GeometryHandle& other) = delete;
+	GeometryHandle& operator=(const GeometryHandle& other) = delete;
+	GeometryHandle(GeometryHandle&& other) noexcept;
+	GeometryHandle& operator=(GeometryHandle&& other) noexcept;
+	~GeometryHandle();
+	// null for an empty handle
+	GeometryArena* getArena() const;
+	unsigned int getAllocation() const;
+private:
+	friend class GeometryArena;
+	GeometryArena* arena;
+	unsigned int allocation;
+	GeometryHandle(GeometryArena* arena, unsigned int allocation);
+};
+
+/**
+ * @class GeometryArena - one vertex buffer, index buffer and VAO per vertex
+ * layout, shared by every mesh of that layout. Meshes draw their range with
+ * glDrawElementsBaseVertex, so drawing a model binds one VAO instead of one
+ * per mesh. The buffers double when full; when the free space splinters
+ * they are compacted by copying the live ranges to the front on the GPU.
+ * Offsets change when that happens, so query them per draw instead of
+ * caching them. Freeing is bookkeeping only and works without a context.
+ */
+class GeometryArena {
+public:
+	// the arena of a layout, created on first use
+	static GeometryArena& get(const VertexFormat& format);
+	// copy vertices, laid out in the arena's format, and indexBytes of index data in
+	GeometryHandle allocate(const void* vertices, std::size_t numVertices, const void* indices, std::size_t indexBytes);
+	GLint getBaseVertex(unsigned int allocation) const;
+	// bytes into the index buffer, for the draw call's indices pointer
+	std::size_t getIndexOffset(unsigned int allocation) const;
+	GLuint getVAO() const;
+	// move every live range to the front of its buffer
+	void compact();
+	static void printStats(std::ostream& out = std::cout);
+private:
+	friend class GeometryHandle;
+	struct Allocation {
+		// in vertices
+		std::size_t vertexOffset, numVertices;
+		// in INDEX_UNIT words, keeping 16 and 32-bit index data aligned
+		std::size_t indexOffset, indexUnits;
+		bool live;
+	};
+	static const std::size_t INITIAL_VERTICES = 1 << 16;
+	static const std::size_t INITIAL_INDEX_UNITS = 1 << 17;
+	static const std::size_t INDEX_UNIT = 4;
+	// compact ahead of an allocation past this fragmentation, once at least a quarter of a buffer is free
+	static constexpr float COMPACT_FRAGMENTATION = 0.5f;
+	static std::unordered_map<unsigned int, std::unique_ptr<GeometryArena>> arenas;
+	VertexFormat format;
+	unsigned int stride;
+	GLuint vao, vertexBuffer, indexBuffer;
+	FreeListAllocator vertexSpace, indexSpace;
+	std::vector<Allocation> allocations;
+	std::vector<unsigned int> unusedAllocations;
+	unsigned int numCompactions;
+	explicit GeometryArena(const VertexFormat& format);
+	void free(unsigned int allocation);
+	// allocate in one of the buffers, compacting or growing it if needed
+	std::size_t allocateRange(bool vertices, std::size_t size);
+	// move the live ranges of one buffer to the front of a new buffer of capacity units
+	void relocate(bool vertices, std::size_t capacity);
+	// point the VAO at the current buffers
+	void setupVertexArray();
+	bool isFragmented(const FreeListAllocator& space) const;
+};
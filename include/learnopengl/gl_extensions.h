@@ -0,0 +1,80 @@
+/**
+ * @file gl_extensions.h
+ * @brief Entry points and tokens beyond the OpenGL 3.3 core profile loaded by glad
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+
+// ARB_get_program_binary (core in 4.1)
+#ifndef GL_PROGRAM_BINARY_RETRIEVABLE_HINT
+#define GL_PROGRAM_BINARY_RETRIEVABLE_HINT 0x8257
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+typedef void (APIENTRYP PFNGLGETPROGRAMBINARYPROC_EXT)(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, void* binary);
+typedef void (APIENTRYP PFNGLPROGRAMBINARYPROC_EXT)(GLuint program, GLenum binaryFormat, const void* binary, GLsizei length);
+typedef void (APIENTRYP PFNGLPROGRAMPARAMETERIPROC_EXT)(GLuint program, GLenum pname, GLint value);
+
+// KHR_parallel_shader_compile / ARB_parallel_shader_compile
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_MAX_SHADER_COMPILER_THREADS_KHR 0x91B0
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC_EXT)(GLuint count);
+
+// ARB_buffer_storage (core in 4.4)
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#define GL_MAP_COHERENT_BIT 0x0080
+#define GL_DYNAMIC_STORAGE_BIT 0x0100
+#define GL_CLIENT_STORAGE_BIT 0x0200
+#endif
+typedef void (APIENTRYP PFNGLBUFFERSTORAGEPROC_EXT)(GLenum target, GLsizeiptr size, const void* data, GLbitfield flags);
+
+// EXT_texture_compression_s3tc, with the sRGB variants of EXT_texture_sRGB
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGB_S3TC_DXT1_EXT 0x83F0
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+#ifndef GL_COMPRESSED_SRGB_S3TC_DXT1_EXT
+#define GL_COMPRESSED_SRGB_S3TC_DXT1_EXT 0x8C4C
+#define GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT 0x8C4F
+#endif
+
+// ARB_texture_compression_bptc (core in 4.2)
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#define GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM 0x8E8D
+#endif
+
+/**
+ * @class GLExtensions - resolves optional entry points once a context is
+ * current. Every feature flag stays false when the driver lacks support, so
+ * callers can always fall back to the plain 3.3 path.
+ */
+class GLExtensions {
+public:
+	// query extensions and resolve entry points, only the first call does any work
+	static void load();
+	static bool isSupported(const char* extension);
+	// feature flags
+	static bool programBinary;
+	static bool parallelShaderCompile;
+	static bool bufferStorage;
+	// BC1-BC3 and BC7 uploads; BC4 and BC5 (RGTC) are core
+	static bool textureCompressionS3TC;
+	static bool textureCompressionBPTC;
+	// entry points
+	static PFNGLGETPROGRAMBINARYPROC_EXT getProgramBinary;
+	static PFNGLPROGRAMBINARYPROC_EXT programBinaryLoad;
+	static PFNGLPROGRAMPARAMETERIPROC_EXT programParameteri;
+	static PFNGLMAXSHADERCOMPILERTHREADSKHRPROC_EXT maxShaderCompilerThreads;
+	static PFNGLBUFFERSTORAGEPROC_EXT bufferStorageAllocate;
+private:
+	GLExtensions() {}
+	static bool loaded;
+	static int version;
+};
@@ -0,0 +1,78 @@
+/**
+ * @file gl_state.h
+ * @brief Shadowed OpenGL state that skips redundant binds
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include <iostream>
+
+/**
+ * @class GLState - shadows the bound program, textures per unit, vertex array,
+ * array and element buffers, framebuffers and the blend/depth/cull state of
+ * the current context, and only forwards calls that change something. Every
+ * call is counted as issued or elided. State changed with raw gl* calls is
+ * invisible to the shadow, so code mixing the two must call invalidate()
+ * afterwards, and deleted objects must be forgotten since names get reused.
+ */
+class GLState {
+public:
+	enum Category { PROGRAM, TEXTURE, VERTEX_ARRAY, BUFFER, FRAMEBUFFER, RENDER_STATE, NUM_CATEGORIES };
+	static void useProgram(GLuint program);
+	// unit is GL_TEXTURE0 + i, as for glActiveTexture
+	static void activeTexture(GLenum unit);
+	// bind to the active unit
+	static void bindTexture(GLenum target, GLuint texture);
+	// bind to texture unit i, only switching the active unit if the binding changes
+	static void bindTexture(unsigned int unit, GLenum target, GLuint texture);
+	static void bindVertexArray(GLuint vertexArray);
+	static void bindBuffer(GLenum target, GLuint buffer);
+	static void bindFramebuffer(GLenum target, GLuint framebuffer);
+	static void enable(GLenum capability);
+	static void disable(GLenum capability);
+	static void blendFunc(GLenum source, GLenum destination);
+	static void depthFunc(GLenum function);
+	static void cullFace(GLenum mode);
+	// call right before or after deleting the object
+	static void forgetProgram(GLuint program);
+	static void forgetTexture(GLuint texture);
+	static void forgetVertexArray(GLuint vertexArray);
+	static void forgetBuffer(GLuint buffer);
+	static void forgetFramebuffer(GLuint framebuffer);
+	// mark everything unknown, the next call of each kind is always forwarded
+	static void invalidate();
+	static unsigned long long getIssued(Category category);
+	static unsigned long long getElided(Category category);
+	static void resetCounters();
+	static void printCounters(std::ostream& out = std::cout);
+private:
+	GLState() {}
+	static const GLuint UNKNOWN = 0xFFFFFFFF;
+	static const unsigned int MAX_TEXTURE_UNITS = 32;
+	// GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP, GL_TEXTURE_2D_MULTISAMPLE, GL_TEXTURE_3D
+	static const unsigned int NUM_TEXTURE_TARGETS = 4;
+	// GL_BLEND, GL_DEPTH_TEST, GL_CULL_FACE
+	static const unsigned int NUM_CAPABILITIES = 3;
+	static GLuint program;
+	static GLuint activeUnit;
+	static GLuint textures[MAX_TEXTURE_UNITS][NUM_TEXTURE_TARGETS];
+	static GLuint vertexArray;
+	static GLuint arrayBuffer;
+	static GLuint elementBuffer;
+	static GLuint drawFramebuffer;
+	static GLuint readFramebuffer;
+	static GLuint capabilities[NUM_CAPABILITIES];
+	static GLenum blendSource;
+	static GLenum blendDestination;
+	static GLenum depthFunction;
+	static GLenum cullMode;
+	static unsigned long long issued[NUM_CATEGORIES];
+	static unsigned long long elided[NUM_CATEGORIES];
+	// count the call, true if it has to be forwarded
+	static bool update(Category category, GLuint& shadow, GLuint value);
+	static int textureTargetIndex(GLenum target);
+	static int capabilityIndex(GLenum capability);
+	static void setCapability(GLenum capability, bool enabled);
+};
@@ -0,0 +1,42 @@
+/**
+ * @file hash.h
+ * @brief FNV-1a hashing utilities
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+
+// 64-bit FNV-1a parameters
+constexpr std::uint64_t FNV_OFFSET_BASIS = 0xcbf29ce484222325ULL;
+constexpr std::uint64_t FNV_PRIME = 0x100000001b3ULL;
+
+// hash a run of bytes, optionally continuing from a previously computed hash
+constexpr std::uint64_t fnv1a(const char* data, std::size_t length, std::uint64_t hash = FNV_OFFSET_BASIS) {
+	for (std::size_t i = 0; i < length; i++) {
+		hash ^= static_cast<unsigned char>(data[i]);
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+// hash a null-terminated string, optionally continuing from a previously computed hash
+constexpr std::uint64_t fnv1aString(const char* str, std::uint64_t hash = FNV_OFFSET_BASIS) {
+	for (; *str; str++) {
+		hash ^= static_cast<unsigned char>(*str);
+		hash *= FNV_PRIME;
+	}
+	return hash;
+}
+
+// fixed-width lowercase hex, e.g. for naming cache files after a hash
+inline std::string toHexString(std::uint64_t hash) {
+	static const char* HEX = "0123456789abcdef";
+	char digits[17] = {};
+	for (int i = 15; i >= 0; i--, hash >>= 4)
+		digits[i] = HEX[hash & 0xf];
+	return digits;
+}
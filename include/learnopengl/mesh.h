@@ -10,8 +10,12 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <string>
 #include <vector>
 #include <learnopengl/shader_g.h>
+#include <learnopengl/meshlets.h>
+#include <learnopengl/vertex_format.h>
+#include <learnopengl/geometry_arena.h>
 
 struct Vertex {
 	glm::vec3 position;
@@ -19,9 +23,32 @@ struct Vertex {
 	glm::vec2 texCoords;
 };
 
+// one level of detail, a range of the mesh's index buffer drawn against the shared vertices
+struct MeshLod {
+	unsigned int firstIndex;
+	unsigned int numIndices;
+	// object-space distance the simplified surface deviates from the full one, 0 for full detail
+	float error;
+};
+
+// what a material texture is used for; the Nth texture of a kind is sampled through "material.texture_<kind>N"
+enum class TextureKind {
+	DIFFUSE,
+	SPECULAR,
+	NORMAL,
+	HEIGHT
+};
+
+const unsigned int NUM_TEXTURE_KINDS = 4;
+// textures of one kind beyond this are not bound
+const unsigned int MAX_TEXTURES_PER_KIND = 4;
+
+// "texture_diffuse" for TextureKind::DIFFUSE and so on
+const char* getTextureKindName(TextureKind kind);
+
 struct Texture {
 	unsigned int id;
-	std::string type;
+	TextureKind kind;
 	std::string path;
 };
 
@@ -31,12 +58,81 @@ public:
 	std::vector<Vertex> vertices;
 	std::vector<unsigned int> indices;
 	std::vector<Texture> textures;
-	Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures);
-	void draw(Shader& shader);
+	// the vectors are moved in, pass them with std::move to avoid copying;
+	// indices holds every LOD back to back, no lods means a single full-detail level
+	Mesh(std::vector<Vertex> vertices, std::vector<unsigned int> indices, std::vector<Texture> textures,
+		const VertexFormat& format = VertexFormat(), std::vector<MeshLod> lods = std::vector<MeshLod>());
+	// upload straight from external memory such as a mapped cache file, the vertex and index vectors stay empty
+	Mesh(const Vertex* vertices, unsigned int numVertices, const unsigned int* indices, unsigned int numIndices,
+		std::vector<Texture> textures, const glm::vec3& boundsMin, const glm::vec3& boundsMax,
+		const VertexFormat& format = VertexFormat(), std::vector<MeshLod> lods = std::vector<MeshLod>());
+	// owns its range of the geometry arena, so meshes are moved rather than copied
+	Mesh(const Mesh& other) = delete;
+	Mesh& operator=(const Mesh& other) = delete;
+	Mesh(Mesh&& other) = default;
+	Mesh& operator=(Mesh&& other) = default;
+	// lods past the coarsest one draw the coarsest
+	void draw(Shader& shader, unsigned int lod = 0);
+	// instances copies, the per-instance attributes have to be set up on getVAO() already
+	void drawInstanced(Shader& shader, GLsizei instances, unsigned int lod = 0);
+	// full detail, skipping meshlets outside the frustum or facing away from cameraPosition (object space);
+	// meshes too small to be split draw whole
+	void drawClusters(Shader& shader, const glm::mat4& modelViewProjection, const glm::vec3& cameraPosition,
+		bool cullBackfaces = true);
+	// free vertices and indices once they live on the GPU, drawing does not need them
+	void releaseCpuData();
+	// shared by every mesh of the same vertex format
 	unsigned int getVAO();
-	unsigned int getNumIndices();
+	unsigned int getNumIndices(unsigned int lod = 0);
+	// byte offset of a LOD in the shared index buffer, for glDrawElementsBaseVertex
+	const void* getIndexOffset(unsigned int lod = 0) const;
+	// first vertex of the mesh in the shared vertex buffer; like the index offset it moves when the arena compacts
+	GLint getBaseVertex() const;
+	unsigned int getNumLods() const;
+	const MeshLod& getLod(unsigned int lod) const;
+	const Meshlets& getMeshlets() const;
+	// GL_UNSIGNED_SHORT for meshes with at most 65536 vertices, GL_UNSIGNED_INT otherwise
+	GLenum getIndexType() const;
+	const VertexFormat& getFormat() const;
+	// object-space axis-aligned bounding box
+	const glm::vec3& getBoundsMin() const;
+	const glm::vec3& getBoundsMax() const;
+	// object-space bounding sphere around the box center
+	const glm::vec3& getSphereCenter() const;
+	float getSphereRadius() const;
 private:
-	// render data
-	unsigned int vbo, vao, ebo;
-	void setupMesh();
+	// render data, a range of the vertex and index buffers of the arena for format
+	GeometryHandle geometry;
+	// of every LOD together
+	unsigned int numIndices;
+	GLenum indexType;
+	std::vector<MeshLod> lods;
+	VertexFormat format;
+	glm::vec3 boundsMin, boundsMax;
+	glm::vec3 sphereCenter;
+	float sphereRadius;
+	// clusters of the full-detail LOD, empty for small meshes
+	Meshlets meshlets;
+	// visible index ranges of the last drawClusters, kept to avoid reallocating every frame
+	std::vector<unsigned int> rangeStarts;
+	std::vector<GLsizei> rangeCounts;
+	std::vector<const void*> rangeOffsets;
+	std::vector<GLint> rangeBaseVertices;
+	// a texture and the unit it is bound to; units are fixed per kind and number, the same for every mesh,
+	// so a program's sampler uniforms never change once set
+	struct TextureBinding {
+		GLuint texture;
+		unsigned int unit;
+		// only hashed when a program is first seen
+		std::string sampler;
+	};
+	std::vector<TextureBinding> bindings;
+	// Shader::getProgramSerial of every program whose samplers this mesh has assigned; GL recycles program names
+	std::vector<unsigned long long> boundPrograms;
+	void setupMesh(const Vertex* vertexData, unsigned int numVertices, const unsigned int* indexData);
+	// vertices in the layout of format
+	std::vector<unsigned char> packVertices(const Vertex* vertexData, unsigned int numVertices) const;
+	void setupBindings();
+	// bind textures and per-mesh uniforms ahead of a draw, assigning the samplers on first use of a program
+	void bind(Shader& shader);
 };
\ No newline at end of file
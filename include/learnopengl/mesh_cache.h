@@ -0,0 +1,96 @@
+/**
+ * @file mesh_cache.h
+ * @brief Binary .lmesh cache of imported models
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <glm/glm.hpp>
+#include <learnopengl/file_system.h>
+#include <learnopengl/mesh.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @class MeshCache - reads and writes .lmesh files, which hold a model's
+ * meshes as ready-to-upload vertex and index blobs together with their
+ * LOD table, texture references and bounds. A cache file is memory mapped and its blobs
+ * are handed to the driver in place. Entries record a hash of the source
+ * asset, so editing the asset makes the entry stale and it gets rebuilt.
+ *
+ * Layout: Header | MeshRecord[numMeshes] | LodRecord[numLods] | TextureRecord[numTextureRefs] |
+ * string table | vertex and index blobs (vertex blobs 16-byte aligned)
+ */
+class MeshCache {
+public:
+	struct TextureRef {
+		TextureKind kind;
+		std::string path;
+	};
+	MeshCache();
+	MeshCache(const MeshCache& other) = delete;
+	MeshCache& operator=(const MeshCache& other) = delete;
+	// map the cache entry of a source asset, fails if it is missing, stale or malformed
+	bool open(const std::string& sourcePath, std::uint64_t sourceHash);
+	void close();
+	unsigned int getNumMeshes() const;
+	// pointers into the mapping, valid until the cache is closed
+	const Vertex* getVertices(unsigned int mesh) const;
+	unsigned int getNumVertices(unsigned int mesh) const;
+	const unsigned int* getIndices(unsigned int mesh) const;
+	unsigned int getNumIndices(unsigned int mesh) const;
+	glm::vec3 getBoundsMin(unsigned int mesh) const;
+	glm::vec3 getBoundsMax(unsigned int mesh) const;
+	std::vector<MeshLod> getLods(unsigned int mesh) const;
+	std::vector<TextureRef> getTextures(unsigned int mesh) const;
+	// write the cache entry of a source asset from meshes that still hold their vertex and index data
+	static void store(const std::string& sourcePath, std::uint64_t sourceHash, const std::vector<Mesh>& meshes);
+	static std::string getPath(const std::string& sourcePath);
+	static void setDirectory(const std::string& directory);
+private:
+	static const std::uint32_t MAGIC = 0x48534d4c; // "LMSH"
+	static const std::uint32_t VERSION = 4;
+	static const std::size_t BLOB_ALIGNMENT = 16;
+	struct Header {
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint64_t sourceHash;
+		std::uint32_t vertexSize;
+		std::uint32_t numMeshes;
+		std::uint32_t numLods;
+		std::uint32_t numTextureRefs;
+		std::uint32_t stringTableSize;
+	};
+	struct MeshRecord {
+		std::uint64_t vertexOffset;
+		std::uint64_t indexOffset;
+		std::uint32_t numVertices;
+		std::uint32_t numIndices;
+		float boundsMin[3];
+		float boundsMax[3];
+		std::uint32_t firstLod;
+		std::uint32_t numLods;
+		std::uint32_t firstTextureRef;
+		std::uint32_t numTextureRefs;
+	};
+	struct LodRecord {
+		std::uint32_t firstIndex;
+		std::uint32_t numIndices;
+		float error;
+	};
+	struct TextureRecord {
+		std::uint32_t kind;
+		std::uint32_t pathOffset;
+		std::uint32_t pathLength;
+	};
+	MappedFile file;
+	const Header* header;
+	const MeshRecord* meshes;
+	const LodRecord* lods;
+	const TextureRecord* textures;
+	const char* strings;
+	static std::string directory;
+	bool validate() const;
+};
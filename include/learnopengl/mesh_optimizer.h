@@ -0,0 +1,45 @@
+/**
+ * @file mesh_optimizer.h
+ * @brief Import-time reordering of mesh geometry for the post-transform vertex cache
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <learnopengl/mesh.h>
+#include <vector>
+
+/**
+ * @class MeshOptimizer - reorders a triangle list so the GPU transforms each
+ * vertex as few times as possible. optimize() runs every stage in order:
+ * duplicate vertices are welded, triangles are reordered with Tipsify
+ * (Sander et al. 2007), clusters of them are sorted front-to-back to reduce
+ * overdraw, and vertices are renumbered in first-use order for fetch
+ * locality. The stages are thread-safe and only touch their arguments.
+ */
+class MeshOptimizer {
+public:
+	// post-transform cache efficiency under a simulated FIFO cache
+	struct Stats {
+		// average cache miss ratio, transformed vertices per triangle (0.5 to 3)
+		float acmr;
+		// average transform to vertex ratio, transformed vertices per vertex (1 is ideal)
+		float atvr;
+	};
+	static const unsigned int CACHE_SIZE = 16;
+	// how much overdraw sorting may worsen the ACMR of a cluster
+	static constexpr float OVERDRAW_THRESHOLD = 1.05f;
+	static void optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+	static Stats analyze(const std::vector<unsigned int>& indices, unsigned int numVertices, unsigned int cacheSize = CACHE_SIZE);
+	// merge bitwise identical vertices, dropping unreferenced ones
+	static void weldVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+	// Tipsify, fans around vertices chosen to keep the last cacheSize vertices hot
+	static void optimizeVertexCache(std::vector<unsigned int>& indices, unsigned int numVertices, unsigned int cacheSize = CACHE_SIZE);
+	// sort cache-optimized triangles in clusters, outward facing clusters first
+	static void optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices,
+		float threshold = OVERDRAW_THRESHOLD, unsigned int cacheSize = CACHE_SIZE);
+	// renumber vertices in the order the triangles first use them
+	static void optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices);
+private:
+	MeshOptimizer() {}
+};
@@ -0,0 +1,29 @@
+/**
+ * @file mesh_simplifier.h
+ * @brief Quadric error edge-collapse simplification for mesh LODs
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <learnopengl/mesh.h>
+#include <cstddef>
+#include <vector>
+
+/**
+ * @class MeshSimplifier - reduces a triangle list by collapsing edges in order
+ * of their quadric error (Garland and Heckbert 1997). The result indexes the
+ * original vertices, so every LOD of a mesh shares one vertex buffer. Vertices
+ * on open borders only slide along the border; vertices on attribute seams,
+ * where one position has several vertices, stay in place so UVs and normals
+ * never tear. Collapses that would flip a triangle are skipped.
+ */
+class MeshSimplifier {
+public:
+	// indices for at most targetIndexCount indices, or fewer triangles than requested if vertices are locked;
+	// error receives the largest object-space distance a collapsed vertex moved from the original surface
+	static std::vector<unsigned int> simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+		std::size_t targetIndexCount, float* error = nullptr);
+private:
+	MeshSimplifier() {}
+};
@@ -0,0 +1,41 @@
+/**
+ * @file meshlets.h
+ * @brief Small triangle clusters of a mesh with per-cluster culling
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <vector>
+
+struct Vertex;
+
+/**
+ * @class Meshlets - splits a range of a mesh's index buffer into consecutive
+ * clusters of at most MAX_VERTICES vertices and MAX_TRIANGLES triangles, so
+ * each cluster is still a plain index range. Every cluster keeps a bounding
+ * sphere and a cone bounding its triangle normals. cull() tests four clusters
+ * at a time with SSE against the view frustum and, optionally, the cone, and
+ * returns the index ranges left to draw with glMultiDrawElements.
+ */
+class Meshlets {
+public:
+	static const unsigned int MAX_VERTICES = 64;
+	static const unsigned int MAX_TRIANGLES = 124;
+	void build(const Vertex* vertices, unsigned int numVertices, const unsigned int* indices, unsigned int firstIndex,
+		unsigned int numIndices);
+	unsigned int getNumMeshlets() const;
+	// first index and index count of every visible range, neighboring clusters merged; planes and camera come
+	// from modelViewProjection and cameraPosition in object space, so the model matrix should not shear
+	void cull(const glm::mat4& modelViewProjection, const glm::vec3& cameraPosition, bool cullBackfaces,
+		std::vector<unsigned int>& rangeStarts, std::vector<GLsizei>& rangeCounts) const;
+private:
+	std::vector<unsigned int> firstIndices;
+	std::vector<unsigned int> numIndices;
+	// structure of arrays padded to a multiple of 4 for the SIMD pass
+	std::vector<float> centerX, centerY, centerZ, radius;
+	std::vector<float> axisX, axisY, axisZ, cutoff;
+	void addMeshlet(const Vertex* vertices, const unsigned int* indices, unsigned int first, unsigned int count);
+};
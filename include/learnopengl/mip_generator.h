@@ -0,0 +1,36 @@
+/**
+ * @file mip_generator.h
+ * @brief Mip chains built on the CPU with SIMD filters
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <vector>
+
+enum class MipFilter {
+	// 2x2 average, what glGenerateMipmap does on most drivers
+	BOX,
+	// 6x6 Kaiser-windowed sinc, sharper distant detail at the cost of slight ringing
+	KAISER
+};
+
+/**
+ * @class MipGenerator - halves 8-bit images with a separable filter. Pixels
+ * are expanded to linear float RGBA, decoding sRGB color through a table
+ * when srgb is set, so the averages are taken in linear light; alpha always
+ * stays linear. Rows are filtered with AVX or SSE where available and the
+ * output rows are split into bands over parallelFor.
+ */
+class MipGenerator {
+public:
+	// the next level, max(width / 2, 1) by max(height / 2, 1) with the same components
+	static std::vector<unsigned char> downsample(const unsigned char* pixels, int width, int height, int components, bool srgb,
+		MipFilter filter);
+	// levels 1 to 1x1, each made from the one before
+	static std::vector<std::vector<unsigned char>> generate(const unsigned char* pixels, int width, int height, int components,
+		bool srgb, MipFilter filter);
+private:
+	MipGenerator() {}
+	static const int BAND_ROWS = 16;
+};
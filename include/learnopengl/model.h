@@ -10,30 +10,111 @@
 #include <glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
-#include <stb_image.h>
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
 #include <assimp/postprocess.h>
 #include <learnopengl/shader_g.h>
 #include <learnopengl/mesh.h>
+#include <learnopengl/culling.h>
+#include <learnopengl/mesh_optimizer.h>
+#include <learnopengl/mesh_simplifier.h>
+#include <learnopengl/stream_buffer.h>
+#include <learnopengl/texture_cache.h>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 #include <iostream>
 
 class Model {
 public:
-	Model(const char* path);
-	void draw(Shader& shader);
+	// flipTextures flips the textures vertically while they are decoded, every mesh is uploaded in vertexFormat
+	Model(const char* path, bool flipTextures = false, const VertexFormat& vertexFormat = VertexFormat());
+	// lods past a mesh's coarsest level draw its coarsest
+	void draw(Shader& shader, unsigned int lod = 0);
+	// only the meshes whose bounds intersect the world-space frustum when placed by model
+	void draw(Shader& shader, const glm::mat4& model, const Frustum& frustum, unsigned int lod = 0);
+	// one instance per matrix, read by the shader as a mat4 at INSTANCE_MATRIX_LOCATION (3-6); the matrices
+	// are streamed through the model's instance buffer, so they may change every call
+	void drawInstanced(Shader& shader, const glm::mat4* matrices, std::size_t count, unsigned int lod = 0);
+	// full detail with meshlet culling; model should be a rotation, translation and uniform scale
+	void drawClusters(Shader& shader, const glm::mat4& model, const glm::mat4& viewProjection, const glm::vec3& cameraPosition,
+		bool cullBackfaces = true);
 	unsigned int getNumMeshes();
+	// object-space bounding sphere of the whole model
+	const glm::vec3& getBoundsCenter() const;
+	float getBoundsRadius() const;
+	// shared by every mesh with the same vertex format, draw with the base vertex
 	unsigned int getMeshVAO(unsigned int meshIndex);
-	unsigned int getMeshNumIndices(unsigned int meshIndex);
+	unsigned int getMeshNumIndices(unsigned int meshIndex, unsigned int lod = 0);
+	// byte offset of a LOD in the shared index buffer
+	const void* getMeshIndexOffset(unsigned int meshIndex, unsigned int lod = 0);
+	GLint getMeshBaseVertex(unsigned int meshIndex);
+	unsigned int getMeshNumLods(unsigned int meshIndex);
+	// LOD levels of the most detailed mesh
+	unsigned int getNumLods() const;
+	// projected diameter in pixels of the model's bounding sphere, huge once the camera is inside it
+	float getScreenSize(const glm::mat4& modelView, const glm::mat4& projection, float viewportHeight) const;
+	// coarsest LOD whose error stays under LOD_PIXEL_ERROR pixels at screenSize; switching away from
+	// previousLod needs a margin of LOD_HYSTERESIS, so objects near a threshold do not pop back and forth
+	unsigned int selectLod(float screenSize, unsigned int previousLod = 0) const;
+	GLenum getMeshIndexType(unsigned int meshIndex);
 	unsigned int getTextureID(unsigned int textureIndex);
+	// free the CPU copy of every mesh's geometry, for models that are only drawn
+	void releaseMeshData();
+	static constexpr float LOD_PIXEL_ERROR = 1.0f;
+	static constexpr float LOD_HYSTERESIS = 0.25f;
+	static const GLuint INSTANCE_MATRIX_LOCATION = 3;
 private:
+	static const unsigned int MAX_LODS = 5;
+	// meshes this small are drawn at full detail only
+	static const std::size_t MIN_LOD_TRIANGLES = 64;
+	// CPU-side result of converting one aiMesh, texture ids are resolved once uploaded
+	struct MeshData {
+		std::vector<Vertex> vertices;
+		// every LOD back to back
+		std::vector<unsigned int> indices;
+		std::vector<MeshLod> lods;
+		std::vector<Texture> textures;
+		// post-transform cache efficiency as imported and after MeshOptimizer
+		MeshOptimizer::Stats original, optimized;
+	};
 	std::vector<Mesh> meshes;
 	std::vector<Texture> texturesLoaded;
+	// index into texturesLoaded by material path
+	std::unordered_map<std::string, unsigned int> textureIndices;
+	// keeps the shared textures alive as long as the model
+	std::vector<TextureHandle> textureHandles;
 	std::string directory;
+	bool flipTextures;
+	VertexFormat vertexFormat;
+	glm::vec3 boundsCenter;
+	float boundsRadius;
+	// object-space box of every mesh
+	BoundingBoxes meshBoxes;
+	// meshes passing the last cull, kept to avoid reallocating every frame
+	std::vector<unsigned int> visibleMeshes;
+	// instance matrices of drawInstanced
+	StreamBuffer instances;
+	// vertex arrays whose instance attributes are enabled, they are shared with every model of the same format
+	std::vector<GLuint> instancedVAOs;
+	// worst error of each LOD across the meshes, relative to boundsRadius
+	std::vector<float> lodErrors;
 	void loadModel(std::string path);
-	void processNode(aiNode* node, const aiScene* scene);
-	Mesh processMesh(aiMesh* mesh, const aiScene* scene);
-	std::vector<Texture> loadMaterialTextures(aiMaterial* mat, aiTextureType type, std::string typeName);
-	unsigned int textureFromFile(const char* path, const std::string directory, bool gamma = false);
+	// rebuild the meshes from the .lmesh cache, false if there is no up-to-date entry
+	bool loadCached(const std::string& path, std::uint64_t sourceHash);
+	// continue hash over every material library an OBJ source names, since the cache also holds the material textures
+	std::uint64_t hashMaterialLibraries(const char* source, std::size_t size, std::uint64_t hash) const;
+	void processNode(aiNode* node, const aiScene* scene, std::vector<aiMesh*>& sceneMeshes);
+	// thread-safe, only reads the scene; the geometry comes out welded and reordered by MeshOptimizer
+	MeshData processMesh(aiMesh* mesh, const aiScene* scene) const;
+	// append simplified levels, each with about half the triangles of the one before
+	void buildLods(MeshData& data) const;
+	// bounding spheres and LOD errors, once the meshes exist
+	void computeLodErrors();
+	// append the material's textures of one type, ids are filled in by loadTextures
+	void loadMaterialTextures(aiMaterial* mat, aiTextureType type, TextureKind kind, std::vector<Texture>& textures) const;
+	// fetch every texture not loaded yet from the shared cache, new ones show a placeholder until uploaded
+	void loadTextures(const std::vector<Texture>& refs);
+	// loaded textures matching the paths of refs
+	std::vector<Texture> resolveTextures(const std::vector<Texture>& refs) const;
 };
\ No newline at end of file
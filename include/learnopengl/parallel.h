@@ -0,0 +1,19 @@
+/**
+ * @file parallel.h
+ * @brief Minimal data-parallel loop over worker threads
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+// number of threads parallelFor spreads work over, including the calling thread
+unsigned int workerCount();
+
+// run body(i) for every i in [0, count), the calling thread takes part and returns once all are done;
+// iterations are handed out one at a time so uneven work (e.g. textures of different sizes) balances.
+// The workers are started once and reused; a loop started while another holds them, or from inside a
+// loop, runs on the calling thread alone
+void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body);
@@ -0,0 +1,38 @@
+/**
+ * @file program_cache.h
+ * @brief Persistent on-disk cache of linked program binaries
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include <cstdint>
+#include <string>
+
+/**
+ * @class ProgramCache - stores linked programs with glGetProgramBinary and
+ * restores them with glProgramBinary on later launches. Entries are keyed by
+ * a hash of every stage's final source text (defines included) and the
+ * driver's vendor, renderer and version strings, so a driver update or a
+ * shader edit simply misses. Any binary the driver rejects is treated as a
+ * miss and the caller compiles from source as usual.
+ */
+class ProgramCache {
+public:
+	// hash of the stage sources, null entries are skipped but still keep their slot in the key
+	static std::uint64_t computeKey(const char* const* sources, unsigned int count);
+	// try to link the program from a cached binary, returns false on a miss or rejected binary
+	static bool load(std::uint64_t key, unsigned int program);
+	// must be called before glLinkProgram so the driver keeps the binary retrievable
+	static void prepare(unsigned int program);
+	// write a successfully linked program to the cache
+	static void store(std::uint64_t key, unsigned int program);
+	static void setDirectory(const std::string& directory);
+private:
+	ProgramCache() {}
+	static const std::uint32_t MAGIC = 0x4250474c; // "LGPB"
+	static const std::uint32_t VERSION = 1;
+	static std::string directory;
+	static std::string getPath(std::uint64_t key);
+};
@@ -12,10 +12,18 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <vector>
+#include <learnopengl/shader_preprocessor.h>
+#include <learnopengl/uniform_cache.h>
 
 class Shader {
 public:
     Shader(const char* vertexPath, const char* fragmentPath, const char* geometryPath = nullptr);
+    // build the variant of the program selected by the given preprocessor definitions
+    Shader(const char* vertexPath, const char* fragmentPath, const ShaderDefines& defines, const char* geometryPath = nullptr);
+    // take ownership of an already linked program built from the given files
+    Shader(unsigned int program, const char* vertexPath, const char* fragmentPath, const char* geometryPath = nullptr,
+        const ShaderDefines& defines = ShaderDefines());
     Shader(const Shader& other) = delete;
     Shader(Shader&& other) = delete;
     Shader& operator=(const Shader& rhs) = delete;
@@ -23,25 +31,47 @@ public:
     ~Shader();
     void use() const;
     unsigned int getID() const;
+    // changes whenever this shader gets a new program and is never reused, unlike GL program names
+    unsigned long long getProgramSerial() const;
+    // swap in a program built from new sources, keeping the current one if compilation fails
+    bool reload(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode = std::string());
+    // file the given stage was loaded from, empty if the stage is absent
+    const std::string& getSourcePath(GLenum shaderType) const;
+    const ShaderDefines& getDefines() const;
+    // preprocess the vertex, fragment and optional geometry stage, dependencies receives every file read
+    static bool loadSources(const std::string paths[3], const ShaderDefines& defines, std::string code[3],
+        std::vector<std::string>* dependencies = nullptr);
+    // cached location of an active uniform, -1 if it does not exist
+    int getUniformLocation(UniformName name) const;
     // uniform utilities
-    void setBool(const std::string& name, bool value) const;
-    void setInt(const std::string& name, int value) const;
-    void setFloat(const std::string& name, float value) const;
-    void setVec2(const std::string& name, const glm::vec2& value) const;
-    void setVec2(const std::string& name, float x, float y) const;
-    void setVec3(const std::string& name, const glm::vec3& value) const;
-    void setVec3(const std::string& name, float x, float y, float z) const;
-    void setVec4(const std::string& name, const glm::vec4& value) const;
-    void setVec4(const std::string& name, float x, float y, float z, float w) const;
-    void setMat2(const std::string& name, const glm::mat2& mat) const;
-    void setMat3(const std::string& name, const glm::mat3& mat) const;
-    void setMat4(const std::string& name, const glm::mat4& mat) const;
+    void setBool(UniformName name, bool value) const;
+    void setInt(UniformName name, int value) const;
+    void setFloat(UniformName name, float value) const;
+    void setVec2(UniformName name, const glm::vec2& value) const;
+    void setVec2(UniformName name, float x, float y) const;
+    void setVec3(UniformName name, const glm::vec3& value) const;
+    void setVec3(UniformName name, float x, float y, float z) const;
+    void setVec4(UniformName name, const glm::vec4& value) const;
+    void setVec4(UniformName name, float x, float y, float z, float w) const;
+    void setMat2(UniformName name, const glm::mat2& mat) const;
+    void setMat3(UniformName name, const glm::mat3& mat) const;
+    void setMat4(UniformName name, const glm::mat4& mat) const;
+    // typed setter, only compiles when the value matches the UniformId's type
+    template<typename T>
+    void set(UniformId<T> uniform, const typename UniformValue<T>::type& value) const {
+        uploadUniform(uniforms.getLocation(uniform), value);
+    }
 private:
     static const unsigned int INFO_LOG_SIZE = 1024;
+    static unsigned long long nextProgramSerial;
     unsigned int id;
+    unsigned long long programSerial;
+    UniformCache uniforms;
+    std::string sourcePaths[3];
+    ShaderDefines defines;
     // private utility methods
-    const char* readShaderCode(const char* shaderPath);
+    bool link(unsigned int program, const char* vShaderCode, const char* fShaderCode, const char* gShaderCode);
     unsigned int compileShader(GLenum shaderType, const char* shaderCode);
-    void checkCompileErrors(GLuint shader, GLenum shaderType = GL_NONE);
+    bool checkCompileErrors(GLuint shader, GLenum shaderType = GL_NONE);
     std::string shaderTypeToString(GLenum shaderType);
 };
\ No newline at end of file
@@ -0,0 +1,74 @@
+/**
+ * @file shader_library.h
+ * @brief Batched shader program compilation
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include <learnopengl/shader_g.h>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @class ShaderLibrary - builds every registered program as one batch. All
+ * glCompileShader and glLinkProgram calls are issued before any status is
+ * queried, so drivers with KHR_parallel_shader_compile (or a deferred
+ * compiler) can work on all of them at once. A program is only waited on
+ * the first time it is requested.
+ */
+class ShaderLibrary {
+public:
+	ShaderLibrary();
+	ShaderLibrary(const ShaderLibrary& other) = delete;
+	ShaderLibrary& operator=(const ShaderLibrary& other) = delete;
+	// register a program, geometry shader is optional
+	void add(const std::string& name, const char* vertexPath, const char* fragmentPath, const char* geometryPath = nullptr);
+	// register a variant of a program selected by preprocessor definitions
+	void add(const std::string& name, const char* vertexPath, const char* fragmentPath, const ShaderDefines& defines,
+		const char* geometryPath = nullptr);
+	// issue compilation and linking of every registered program without blocking
+	void compileAll();
+	// true once the driver has finished the program, never blocks
+	bool isReady(const std::string& name);
+	// the finished program, blocking on the driver only if it is still being built
+	Shader& get(const std::string& name);
+	// finish every program that has not been requested yet
+	void finishAll();
+	// per-program compile/link times in milliseconds: issuing, blocking on status queries and, where the
+	// driver reports completion, when it was first seen done
+	void printTimings(std::ostream& out = std::cout) const;
+private:
+	typedef std::chrono::steady_clock Clock;
+	struct Program {
+		std::string name;
+		std::string paths[3];
+		ShaderDefines defines;
+		std::string sources[3];
+		unsigned int stages[3];
+		unsigned int id;
+		std::uint64_t cacheKey;
+		bool fromCache;
+		bool issued;
+		Clock::time_point issueStart;
+		double issueMs;
+		// time blocked in status queries when the program was finished
+		double waitMs;
+		// since issueStart, when GL_COMPLETION_STATUS_KHR first reported done, negative until then
+		double readyMs;
+		std::unique_ptr<Shader> shader;
+	};
+	static const GLenum STAGE_TYPES[3];
+	std::vector<Program> programs;
+	std::unordered_map<std::string, std::size_t> indices;
+	Program& find(const std::string& name);
+	void issue(Program& program);
+	bool pollCompletion(Program& program);
+	void finish(Program& program);
+};
@@ -1,7 +1,7 @@
 /**
  * @file shader_m.h
  * @brief Shader class supporting matrices and vectors
- * @date Created: July 2023 | Last modified: November 2024
+ * @date Created: July 2023 | Last modified: October 2026
  * @see https://learnopengl.com/Getting-started/Transformations
  */
 
@@ -15,10 +15,12 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <learnopengl/uniform_cache.h>
 
 class Shader {
 private:
     unsigned int id;
+    UniformCache uniforms;
 public:
     Shader(const char* vertexPath, const char* fragmentPath);
     ~Shader();
@@ -27,18 +29,25 @@ public:
     Shader& operator=(const Shader& other) = delete;
     Shader& operator=(Shader&& other) = delete;
     void use();
-    void setBool(const std::string& name, bool value) const;
-    void setInt(const std::string& name, int value) const;
-    void setFloat(const std::string& name, float value) const;
-    void setVec2(const std::string& name, const glm::vec2& value) const;
-    void setVec2(const std::string& name, float x, float y) const;
-    void setVec3(const std::string& name, const glm::vec3& value) const;
-    void setVec3(const std::string& name, float x, float y, float z) const;
-    void setVec4(const std::string& name, const glm::vec4& value) const;
-    void setVec4(const std::string& name, float x, float y, float z, float w) const;
-    void setMat2(const std::string& name, const glm::mat2& mat) const;
-    void setMat3(const std::string& name, const glm::mat3& mat) const;
-    void setMat4(const std::string& name, const glm::mat4& mat) const;
+    // cached location of an active uniform, -1 if it does not exist
+    int getUniformLocation(UniformName name) const;
+    void setBool(UniformName name, bool value) const;
+    void setInt(UniformName name, int value) const;
+    void setFloat(UniformName name, float value) const;
+    void setVec2(UniformName name, const glm::vec2& value) const;
+    void setVec2(UniformName name, float x, float y) const;
+    void setVec3(UniformName name, const glm::vec3& value) const;
+    void setVec3(UniformName name, float x, float y, float z) const;
+    void setVec4(UniformName name, const glm::vec4& value) const;
+    void setVec4(UniformName name, float x, float y, float z, float w) const;
+    void setMat2(UniformName name, const glm::mat2& mat) const;
+    void setMat3(UniformName name, const glm::mat3& mat) const;
+    void setMat4(UniformName name, const glm::mat4& mat) const;
+    // typed setter, only compiles when the value matches the UniformId's type
+    template<typename T>
+    void set(UniformId<T> uniform, const typename UniformValue<T>::type& value) const {
+        uploadUniform(uniforms.getLocation(uniform), value);
+    }
 };
 
 #endif
@@ -0,0 +1,39 @@
+/**
+ * @file shader_preprocessor.h
+ * @brief GLSL #include expansion and define injection
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+// preprocessor definitions for one shader variant, e.g. { { "NR_LIGHTS", "128" }, { "PCF", "1" } }
+typedef std::vector<std::pair<std::string, std::string>> ShaderDefines;
+
+/**
+ * @class ShaderPreprocessor - turns a shader file into a single source string.
+ * '#include "file"' directives are resolved relative to the including file,
+ * then like '#include <file>' against the include directories, and every
+ * file is expanded once; defines are injected right after '#version' so
+ * shaders can provide defaults with '#ifndef'. '#line' directives keep driver
+ * error messages pointing at the original file (by include index) and line.
+ */
+class ShaderPreprocessor {
+public:
+	// dependencies receives every file read, the root file first
+	static bool process(const std::string& path, const ShaderDefines& defines, std::string& output, std::vector<std::string>* dependencies = nullptr);
+	// canonical "NAME=VALUE;..." string identifying a variant regardless of define order
+	static std::string variantKey(const ShaderDefines& defines);
+	// searched for '#include <file>', "include/" (shared GLSL next to the C++ headers) by default
+	static void addIncludeDirectory(const std::string& directory);
+private:
+	ShaderPreprocessor() {}
+	static const unsigned int MAX_INCLUDE_DEPTH = 16;
+	static std::vector<std::string> includeDirectories;
+	static bool expand(const std::string& path, std::string& output, std::vector<std::string>& included, unsigned int depth);
+	// path of an included file, empty if it is found nowhere
+	static std::string resolveInclude(const std::string& directory, const std::string& name, bool angled);
+};
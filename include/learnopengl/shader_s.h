@@ -1,7 +1,7 @@
 /**
  * @file shader_s.h
  * @brief Shader class
- * @date Created: July 2023 | Last modified: November 2024
+ * @date Created: July 2023 | Last modified: October 2026
  * @see https://learnopengl.com/Getting-started/Shaders
  */
 
@@ -14,10 +14,12 @@
 #include <fstream>
 #include <sstream>
 #include <iostream>
+#include <learnopengl/uniform_cache.h>
 
 class Shader {
 private:
 	unsigned int id;
+	UniformCache uniforms;
 public:
 	Shader(const char* vertexPath, const char* fragmentPath);
 	~Shader();
@@ -26,9 +28,16 @@ public:
 	Shader& operator=(const Shader& other) = delete;
 	Shader& operator=(Shader&& other) = delete;
 	void use();
-	void setBool(const std::string& name, bool value) const;
-	void setInt(const std::string& name, int value) const;
-	void setFloat(const std::string& name, float value) const;
+	// cached location of an active uniform, -1 if it does not exist
+	int getUniformLocation(UniformName name) const;
+	void setBool(UniformName name, bool value) const;
+	void setInt(UniformName name, int value) const;
+	void setFloat(UniformName name, float value) const;
+	// typed setter, only compiles when the value matches the UniformId's type
+	template<typename T>
+	void set(UniformId<T> uniform, const typename UniformValue<T>::type& value) const {
+		uploadUniform(uniforms.getLocation(uniform), value);
+	}
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,33 @@
+/**
+ * @file shader_variants.h
+ * @brief Cache of define-based shader program variants
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <learnopengl/shader_g.h>
+#include <learnopengl/shader_preprocessor.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @class ShaderVariants - every variant of one set of shader files, keyed by
+ * ShaderPreprocessor::variantKey. A variant is compiled the first time it is
+ * requested and reused afterwards, so equal define sets given in any order
+ * share one program.
+ */
+class ShaderVariants {
+public:
+	ShaderVariants(const char* vertexPath, const char* fragmentPath, const char* geometryPath = nullptr);
+	ShaderVariants(const ShaderVariants& other) = delete;
+	ShaderVariants& operator=(const ShaderVariants& other) = delete;
+	Shader& get(const ShaderDefines& defines = ShaderDefines());
+	std::size_t size() const;
+private:
+	std::string vertexPath;
+	std::string fragmentPath;
+	std::string geometryPath;
+	std::unordered_map<std::string, std::unique_ptr<Shader>> variants;
+};
@@ -0,0 +1,64 @@
+/**
+ * @file shader_watcher.h
+ * @brief Shader hot-reloading through a background file watcher
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <learnopengl/shader_g.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ShaderWatcher - watches the source files of registered shaders on a
+ * background thread (inotify on Linux, timestamp polling elsewhere), including
+ * every file they #include. When a file changes the thread preprocesses the
+ * program's sources again and queues them; the
+ * render thread calls update() once per frame to rebuild and swap queued
+ * programs. A program that fails to compile leaves the previous one in place.
+ * update() never waits on the watcher thread or on disk.
+ */
+class ShaderWatcher {
+public:
+	ShaderWatcher();
+	ShaderWatcher(const ShaderWatcher& other) = delete;
+	ShaderWatcher& operator=(const ShaderWatcher& other) = delete;
+	~ShaderWatcher();
+	// the shader must outlive the watcher or be unwatched first
+	void watch(Shader& shader);
+	void unwatch(Shader& shader);
+	// swap in every program whose sources changed, call at a frame boundary
+	void update();
+private:
+	struct Entry {
+		Shader* shader;
+		std::string stagePaths[3];
+		ShaderDefines defines;
+		// stage files and everything they include
+		std::vector<std::string> dependencies;
+		std::vector<long long> timestamps;
+		bool dirty;
+	};
+	struct Pending {
+		Shader* shader;
+		std::string sources[3];
+	};
+	std::vector<Entry> entries;
+	std::vector<Pending> pending;
+	std::mutex entriesMutex;
+	std::mutex pendingMutex;
+	std::atomic<bool> running;
+	std::thread worker;
+	int inotifyFd;
+	std::vector<std::pair<int, std::string>> watchedDirectories;
+	void run();
+	bool waitForChanges();
+	void markChanged(const std::string& path);
+	void addDirectoryWatch(const std::string& path);
+	void setDependencies(Shader* shader, const std::vector<std::string>& dependencies);
+	static long long getTimestamp(const std::string& path);
+};
@@ -0,0 +1,52 @@
+/**
+ * @file stream_buffer.h
+ * @brief Fenced ring buffer for data rewritten every frame
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include <cstddef>
+
+/**
+ * @class StreamBuffer - a GL buffer split into NUM_REGIONS regions that
+ * write() fills in turn. Leaving a region fences it and entering one waits
+ * for its fence, so data is never overwritten while the GPU may still read
+ * it and the buffer is never reallocated to orphan it; with a region about a
+ * frame's worth of data that wait only blocks when the GPU falls a whole
+ * ring behind. The buffer is persistently mapped when ARB_buffer_storage is
+ * available and mapped unsynchronized per write otherwise. Storage is
+ * created on the first write and grows when a write exceeds a region.
+ */
+class StreamBuffer {
+public:
+	static const unsigned int NUM_REGIONS = 3;
+	explicit StreamBuffer(GLenum target, std::size_t regionSize = DEFAULT_REGION_SIZE);
+	// owns the buffer, so it is moved rather than copied
+	StreamBuffer(const StreamBuffer& other) = delete;
+	StreamBuffer& operator=(const StreamBuffer& other) = delete;
+	StreamBuffer(StreamBuffer&& other) noexcept;
+	StreamBuffer& operator=(StreamBuffer&& other) noexcept;
+	~StreamBuffer();
+	// copy size bytes in and return their byte offset; leaves the buffer bound to the target
+	std::size_t write(const void* data, std::size_t size);
+	// 0 before the first write; changes when the buffer grows
+	GLuint getBuffer() const;
+private:
+	static const std::size_t DEFAULT_REGION_SIZE = 256 << 10;
+	// offsets of every write, enough for any vertex attribute
+	static const std::size_t ALIGNMENT = 64;
+	GLenum target;
+	GLuint buffer;
+	unsigned char* mapping;
+	std::size_t regionSize;
+	unsigned int region;
+	// next free byte
+	std::size_t cursor;
+	GLsync fences[NUM_REGIONS];
+	void create(std::size_t regionSize);
+	void destroy();
+	// fence the current region and wait until the next one is free
+	void advance();
+};
@@ -0,0 +1,69 @@
+/**
+ * @file texture_cache.h
+ * @brief Process-wide cache of shared, reference-counted textures
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <learnopengl/texture_streamer.h>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+
+/**
+ * @class TextureHandle - counted reference to a texture in the TextureCache.
+ * Copies share the texture, which is deleted once the last handle is gone.
+ */
+class TextureHandle {
+public:
+	TextureHandle();
+	TextureHandle(const TextureHandle& other);
+	TextureHandle(TextureHandle&& other) noexcept;
+	TextureHandle& operator=(TextureHandle other);
+	~TextureHandle();
+	// 0 for an empty handle
+	unsigned int getID() const;
+private:
+	friend class TextureCache;
+	std::uint64_t key;
+	unsigned int id;
+	// adopts a reference the cache already counted
+	TextureHandle(std::uint64_t key, unsigned int id);
+};
+
+/**
+ * @class TextureCache - shares textures between every user in the process.
+ * Entries are keyed by a hash of the file contents and the sampling options,
+ * so the same image reached through different paths, or loaded by several
+ * models, is decoded and uploaded once. Files are hashed once per canonical
+ * path. Only use it from the context thread.
+ */
+class TextureCache {
+public:
+	static TextureHandle load(const std::string& path, const TextureOptions& options = TextureOptions());
+	static unsigned long long getHits();
+	static unsigned long long getMisses();
+	static std::size_t getNumTextures();
+	// estimated GPU memory of every uploaded texture
+	static std::size_t getResidentBytes();
+	static void printStats(std::ostream& out = std::cout);
+private:
+	TextureCache() {}
+	friend class TextureHandle;
+	struct Entry {
+		unsigned int id;
+		unsigned int references;
+		std::string path;
+	};
+	static std::unordered_map<std::uint64_t, Entry> entries;
+	// canonical path -> content hash
+	static std::unordered_map<std::string, std::uint64_t> contentHashes;
+	static unsigned long long hits;
+	static unsigned long long misses;
+	static std::uint64_t computeKey(const std::string& canonical, const TextureOptions& options);
+	static void acquire(std::uint64_t key);
+	static void release(std::uint64_t key);
+};
@@ -0,0 +1,88 @@
+/**
+ * @file texture_compressor.h
+ * @brief CPU block compression of textures with a KTX file cache
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include <learnopengl/mip_generator.h>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct TextureOptions;
+
+// what an image holds, which decides the block format it is compressed to
+enum class TextureContent {
+	// BC1 when opaque, BC7 (BC3 without BPTC support) with alpha, BC4 when grey
+	COLOR,
+	// BC5 keeping x and y, shaders rebuild z as sqrt(1 - x^2 - y^2)
+	NORMAL_MAP,
+	// BC4 of the first channel
+	HEIGHT_MAP
+};
+
+enum class BlockFormat {
+	NONE,
+	BC1,
+	BC3,
+	BC4,
+	BC5,
+	BC7
+};
+
+// a block-compressed mip chain
+struct CompressedImage {
+	BlockFormat format = BlockFormat::NONE;
+	bool srgb = false;
+	// components of the source image; BC4 from a 3 or 4 component image is grey and sampled as .rrr
+	int components = 0;
+	struct Level {
+		int width, height;
+		std::vector<unsigned char> data;
+	};
+	std::vector<Level> levels;
+	std::size_t getSize() const;
+};
+
+/**
+ * @class TextureCompressor - encodes 8-bit images to BC1/3/4/5/7 on the CPU.
+ * Rows of blocks are spread over threads with parallelFor and block bounds
+ * use SSE2; mips come from MipGenerator. BC7 is encoded in mode 6 only, one subset with
+ * 4-bit indices, which is fast and still beats BC3 on color with alpha.
+ * Results are cached as KTX 1.1 files under the cache directory, named after
+ * the image path and keyed by a hash of the source bytes and the options
+ * affecting the encoding.
+ */
+class TextureCompressor {
+public:
+	// bumped whenever the encoders change, invalidating every cached file
+	static const std::uint32_t VERSION = 2;
+	// driver support as found by GLExtensions::load(), which has to have run on the context thread
+	static bool isSupported(BlockFormat format);
+	// NONE if the driver supports no fitting format
+	static BlockFormat chooseFormat(const unsigned char* pixels, int width, int height, int components, const TextureOptions& options);
+	// the full mip chain down to 1x1 when mipmaps is set, otherwise level 0 only; srgb also filters the mips in linear light
+	static CompressedImage compress(const unsigned char* pixels, int width, int height, int components, BlockFormat format,
+		bool srgb, bool mipmaps, MipFilter filter);
+	// identifies an encoding of the source bytes under options on this driver
+	static std::uint64_t computeKey(const char* source, std::size_t size, const TextureOptions& options);
+	// <cache directory>/<hash of path>.ktx
+	static std::string getCachePath(const std::string& path);
+	static void setCacheDirectory(const std::string& directory);
+	// false unless the file exists, is intact and was written for key
+	static bool readKtx(const std::string& path, std::uint64_t key, CompressedImage& image);
+	static bool writeKtx(const std::string& path, std::uint64_t key, const CompressedImage& image);
+	static GLenum getInternalFormat(BlockFormat format, bool srgb);
+	// bytes per 4x4 block
+	static std::size_t getBlockSize(BlockFormat format);
+private:
+	TextureCompressor() {}
+	static std::string cacheDirectory;
+	// expand to RGBA: one component becomes grey, two stay red and green, alpha is opaque unless present
+	static std::vector<unsigned char> toRGBA(const unsigned char* pixels, int width, int height, int components);
+	static void encodeLevel(const unsigned char* rgba, int width, int height, BlockFormat format, unsigned char* out);
+};
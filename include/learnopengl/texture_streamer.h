@@ -0,0 +1,140 @@
+/**
+ * @file texture_streamer.h
+ * @brief Asynchronous texture loading through a ring of pixel buffer objects
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include <learnopengl/mip_generator.h>
+#include <learnopengl/texture_compressor.h>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// how a streamed texture is sampled once its real data has arrived
+struct TextureOptions {
+	GLint wrap = GL_REPEAT;
+	// images with an alpha channel use GL_CLAMP_TO_EDGE instead of wrap, avoiding semi-transparent borders
+	bool clampAlpha = false;
+	GLint minFilter = GL_LINEAR_MIPMAP_LINEAR;
+	GLint magFilter = GL_LINEAR;
+	// built on the CPU by MipGenerator, glGenerateMipmap is never used
+	bool mipmaps = true;
+	MipFilter mipFilter = MipFilter::BOX;
+	bool flipVertically = false;
+	bool srgb = false;
+	// force 1-4 components per pixel, 0 keeps the image's own layout
+	int channels = 0;
+	// block-compress 2D textures from files, cached as KTX files under cache/textures
+	bool compress = true;
+	TextureContent content = TextureContent::COLOR;
+};
+
+/**
+ * @class TextureStreamer - loads textures without stalling the frame. load()
+ * returns a texture holding a 1x1 grey placeholder right away while worker
+ * threads decode the file. update(), called once per frame, copies decoded
+ * images into a ring of pixel buffer slots and issues glTexSubImage2D from
+ * them, stopping once the frame's byte budget is spent. Each slot is fenced
+ * so it is only overwritten after the GPU has consumed it. The ring is
+ * persistently mapped when ARB_buffer_storage is available and mapped
+ * unsynchronized per slot otherwise. 2D textures loaded from files are
+ * block-compressed by TextureCompressor on the decode threads, or read back
+ * from its KTX cache, falling back to uncompressed upload where the driver
+ * supports no fitting format. Mip chains are built on the decode threads as
+ * well and every level is uploaded, compressed ones cached with the rest.
+ */
+class TextureStreamer {
+public:
+	static unsigned int load(const std::string& path, const TextureOptions& options = TextureOptions());
+	// stream into an existing texture object
+	static void load(unsigned int texture, const std::string& path, const TextureOptions& options = TextureOptions());
+	// faces in +X, -X, +Y, -Y, +Z, -Z order, uploaded together once all are decoded
+	static unsigned int loadCubemap(const std::vector<std::string>& faces, const TextureOptions& options = TextureOptions());
+	// queue already decoded pixels, they are copied so the caller may free them right away and mipmapped on a decode thread
+	static void upload(unsigned int texture, int width, int height, int components, const unsigned char* pixels,
+		const TextureOptions& options = TextureOptions());
+	// upload decoded images within the frame budget, call once per frame on the context thread
+	static void update();
+	// block until every queued texture is uploaded
+	static void finish();
+	// at least one image is uploaded per update() even if it alone exceeds the budget
+	static void setFrameBudget(std::size_t bytes);
+	// GPU memory of an uploaded texture including its mipmaps, 0 while it shows the placeholder
+	static std::size_t getSize(unsigned int texture);
+	// delete the texture and drop any upload still queued for it
+	static void destroy(unsigned int texture);
+private:
+	TextureStreamer() {}
+	struct Image {
+		// stbi_image_free for decoded images, delete[] for copies passed to upload()
+		unsigned char* pixels;
+		bool decoded;
+		int width, height, components;
+		// levels 1 and below of pixels
+		std::vector<std::vector<unsigned char>> mips;
+		// replaces pixels and mips when levels is not empty
+		CompressedImage compressed;
+	};
+	struct Job {
+		GLuint texture;
+		// orders jobs against destroy(), texture names get reused
+		unsigned long long serial;
+		GLenum target;
+		TextureOptions options;
+		std::vector<std::string> paths;
+		std::vector<Image> images;
+		std::size_t getSize() const;
+	};
+	// joins the decode threads on exit, no GL calls since the context is gone by then
+	struct Workers {
+		std::vector<std::thread> threads;
+		~Workers();
+	};
+	static const unsigned int MAX_WORKERS = 4;
+	static const unsigned int NUM_SLOTS = 4;
+	static const std::size_t SLOT_SIZE = 4 << 20;
+	static const std::size_t DEFAULT_FRAME_BUDGET = 8 << 20;
+	static std::size_t frameBudget;
+	// pixel buffer ring, only touched on the context thread
+	static GLuint ring;
+	static unsigned char* mapping;
+	static GLsync fences[NUM_SLOTS];
+	static unsigned int nextSlot;
+	static std::unordered_map<GLuint, std::size_t> sizes;
+	// texture -> first serial still valid for it
+	static std::unordered_map<GLuint, unsigned long long> destroyed;
+	// shared with the decode threads
+	static std::mutex mutex;
+	static std::condition_variable wake;
+	static std::condition_variable decoded;
+	static std::deque<Job> queue;
+	static std::deque<Job> ready;
+	// queued, decoding, or ready jobs
+	static std::size_t outstanding;
+	static unsigned long long nextSerial;
+	static bool stopping;
+	static Workers workers;
+	static void createPlaceholder(GLuint texture, GLenum target);
+	static void enqueue(Job& job);
+	static bool isDestroyed(const Job& job);
+	static void decode();
+	static Image decodeImage(const std::string& path, const TextureOptions& options, GLenum target);
+	static void uploadJobs(std::vector<Job>& jobs);
+	static void uploadJob(Job& job);
+	static void transfer(GLenum target, GLint level, const unsigned char* pixels, int width, int height, int components, GLenum format);
+	static void transferCompressed(GLenum target, const CompressedImage& image);
+	// copy data into the next free ring slot, returns the slot
+	static unsigned int stage(const unsigned char* data, std::size_t size);
+	static void createRing();
+	static unsigned int acquireSlot();
+	static void release(Job& job);
+	static GLenum getFormat(int components);
+};
@@ -0,0 +1,140 @@
+/**
+ * @file uniform_cache.h
+ * @brief Uniform location cache populated by program reflection
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+#include <learnopengl/hash.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#ifndef NDEBUG
+// how a uniform name was spelled, "name" or "name[index]member" when index is set, so debug builds can tell
+// a hash collision from a match; name is null when only the hash is known and runs to its terminator when
+// length is npos. Only valid for the duration of the call it is passed to
+struct UniformSpelling {
+	const char* name;
+	std::size_t length;
+	int index;
+	const char* member;
+	constexpr UniformSpelling() : name(nullptr), length(0), index(-1), member("") {}
+	constexpr UniformSpelling(const char* name, std::size_t length = std::string::npos, int index = -1, const char* member = "")
+		: name(name), length(length), index(index), member(member) {}
+	std::string str() const;
+};
+#else
+// release builds look uniforms up by hash alone
+struct UniformSpelling {
+	constexpr UniformSpelling() {}
+	constexpr UniformSpelling(const char*, std::size_t = 0, int = -1, const char* = "") {}
+};
+#endif
+
+// compile-time hashed uniform name produced by the _u literal, e.g. "lights[3].position"_u
+struct UniformLiteral {
+	std::uint64_t hash;
+	UniformSpelling spelling;
+};
+
+constexpr UniformLiteral operator"" _u(const char* name, std::size_t length) {
+	return UniformLiteral{ fnv1a(name, length), UniformSpelling(name, length) };
+}
+
+// a uniform name reduced to its hash so that lookups never allocate
+struct UniformName {
+	std::uint64_t hash;
+	UniformSpelling spelling;
+	constexpr UniformName(const char* name) : hash(fnv1aString(name)), spelling(name) {}
+	constexpr UniformName(UniformLiteral name) : hash(name.hash), spelling(name.spelling) {}
+	// hashes on every call, prefer a literal or a UniformId in per-frame code
+	explicit UniformName(const std::string& name) : hash(fnv1a(name.data(), name.size())), spelling(name.data(), name.size()) {}
+};
+
+/**
+ * @struct UniformId - a uniform name hash tagged with the C++ type of its value.
+ * Setting a uniform through a UniformId only compiles when the value matches
+ * that type, so passing a vec3 to a mat4 uniform is caught at compile time.
+ */
+template<typename T>
+struct UniformId {
+	std::uint64_t hash;
+	UniformSpelling spelling;
+	constexpr UniformId(UniformLiteral name) : hash(name.hash), spelling(name.spelling) {}
+	constexpr UniformId(std::uint64_t hash, UniformSpelling spelling) : hash(hash), spelling(spelling) {}
+};
+
+// hash of "array[index]member" computed without building the string, for per-frame array uniforms
+template<typename T>
+constexpr UniformId<T> uniformElement(const char* array, unsigned int index, const char* member = "") {
+	UniformSpelling spelling(array, std::string::npos, static_cast<int>(index), member);
+	char digits[10] = {};
+	int numDigits = 0;
+	do {
+		digits[numDigits++] = static_cast<char>('0' + index % 10);
+		index /= 10;
+	} while (index);
+	std::uint64_t hash = fnv1aString(array);
+	hash = fnv1a("[", 1, hash);
+	while (numDigits)
+		hash = fnv1a(&digits[--numDigits], 1, hash);
+	hash = fnv1a("]", 1, hash);
+	return UniformId<T>(fnv1aString(member, hash), spelling);
+}
+
+// keeps the value argument of a typed setter out of template deduction so the UniformId alone fixes the type
+template<typename T>
+struct UniformValue {
+	typedef T type;
+};
+
+// glUniform* dispatch for every type a UniformId may carry
+inline void uploadUniform(int location, bool value) { glUniform1i(location, static_cast<int>(value)); }
+inline void uploadUniform(int location, int value) { glUniform1i(location, value); }
+inline void uploadUniform(int location, float value) { glUniform1f(location, value); }
+inline void uploadUniform(int location, const glm::vec2& value) { glUniform2fv(location, 1, &value[0]); }
+inline void uploadUniform(int location, const glm::vec3& value) { glUniform3fv(location, 1, &value[0]); }
+inline void uploadUniform(int location, const glm::vec4& value) { glUniform4fv(location, 1, &value[0]); }
+inline void uploadUniform(int location, const glm::mat2& mat) { glUniformMatrix2fv(location, 1, GL_FALSE, &mat[0][0]); }
+inline void uploadUniform(int location, const glm::mat3& mat) { glUniformMatrix3fv(location, 1, GL_FALSE, &mat[0][0]); }
+inline void uploadUniform(int location, const glm::mat4& mat) { glUniformMatrix4fv(location, 1, GL_FALSE, &mat[0][0]); }
+
+/**
+ * @class UniformCache - flat, open-addressed table mapping uniform name hashes
+ * to locations. Filled once after linking by enumerating the program's active
+ * uniforms, so setting a uniform no longer needs a glGetUniformLocation call.
+ * Debug builds also keep each name and check it on every hit, so a name whose
+ * hash collides with an active uniform's is reported instead of writing to it.
+ */
+class UniformCache {
+public:
+	UniformCache();
+	// enumerate the active uniforms of a linked program, replacing any previous contents
+	void reflect(unsigned int program);
+	void clear();
+	// returns -1 (ignored by glUniform*) when the uniform is not active
+	int getLocation(UniformName name) const;
+	template<typename T>
+	int getLocation(UniformId<T> uniform) const { return getLocation(UniformLiteral{ uniform.hash, uniform.spelling }); }
+	unsigned int size() const;
+	// copy the current value of every uniform active in both programs, e.g. across a hot reload
+	static void copyValues(unsigned int from, unsigned int to);
+private:
+	struct Slot {
+		std::uint64_t hash;
+		int location;
+#ifndef NDEBUG
+		std::string name;
+#endif
+	};
+	static const int EMPTY = -1;
+	std::vector<Slot> slots;
+	unsigned int count;
+	void insert(const char* name, std::size_t length, int location);
+	void place(Slot slot);
+	void grow();
+};
@@ -0,0 +1,30 @@
+// Decoding for the compact Mesh vertex formats, see VertexFormat in mesh.h.
+// VertexFormat::getDefines() provides the matching defines for the shader.
+// Packed normals and half-float texture coordinates need no decoding.
+
+#ifdef QUANTIZED_POSITIONS
+// mesh bounds, set by Mesh::draw
+uniform vec3 positionOffset;
+uniform vec3 positionScale;
+#endif
+
+// aPos holds 16-bit unsigned normalized coordinates across the mesh bounds
+vec3 decodePosition(vec3 position) {
+#ifdef QUANTIZED_POSITIONS
+	return positionOffset + position * positionScale;
+#else
+	return position;
+#endif
+}
+
+// aNormal.xy holds the normal mapped onto an octahedron and unfolded into a square
+vec3 decodeNormal(vec3 normal) {
+#ifdef OCTAHEDRAL_NORMALS
+	vec3 n = vec3(normal.xy, 1.0 - abs(normal.x) - abs(normal.y));
+	if (n.z < 0.0)
+		n.xy = (1.0 - abs(n.yx)) * vec2(n.x >= 0.0 ? 1.0 : -1.0, n.y >= 0.0 ? 1.0 : -1.0);
+	return normalize(n);
+#else
+	return normal;
+#endif
+}
@@ -0,0 +1,40 @@
+/**
+ * @file vertex_format.h
+ * @brief GPU vertex layouts of Mesh
+ * @date October 2026
+ */
+
+#pragma once
+
+#include <glad/glad.h>
+#include <learnopengl/shader_preprocessor.h>
+
+/**
+ * @struct VertexFormat - how Mesh stores its vertices in GPU memory, the CPU
+ * copy always uses Vertex. The default matches Vertex (32 bytes); compact()
+ * packs every attribute into 16 bytes. Shaders read positions and normals
+ * through vertex_format.glsl when a format needs decoding.
+ */
+struct VertexFormat {
+	enum Normals {
+		FLOAT_NORMALS,
+		// GL_INT_2_10_10_10_REV, still read as a vec3
+		PACKED_NORMALS,
+		// two 16-bit components, needs decodeNormal()
+		OCTAHEDRAL_NORMALS
+	};
+	Normals normals = FLOAT_NORMALS;
+	// GL_HALF_FLOAT, still read as a vec2
+	bool halfTexCoords = false;
+	// 16 bits per axis across the mesh bounds, needs decodePosition()
+	bool quantizedPositions = false;
+	static VertexFormat compact();
+	bool isCompact() const;
+	unsigned int getStride() const;
+	// defines selecting the decoding in vertex_format.glsl
+	ShaderDefines getDefines() const;
+	// distinct for every layout
+	unsigned int getKey() const;
+	// point attributes 0-2 of the bound vertex array at the bound GL_ARRAY_BUFFER
+	void setupAttributes() const;
+};
@@ -17,7 +17,14 @@ Camera::Camera(
 	pitch(pitch),
 	movementSpeed(SPEED),
 	mouseSensitivity(SENSITIVITY),
-	zoom(ZOOM) {
+	zoom(ZOOM),
+	aspectRatio(PERSPECTIVE_ASPECT),
+	nearPlane(PERSPECTIVE_NEAR),
+	farPlane(PERSPECTIVE_FAR),
+	viewDirty(true),
+	projectionDirty(true),
+	combinedDirty(true),
+	version(0) {
 	updateCameraVectors();
 }
 
@@ -32,16 +39,64 @@ Camera::Camera(
 	pitch(pitch),
 	movementSpeed(SPEED),
 	mouseSensitivity(SENSITIVITY),
-	zoom(ZOOM) {
+	zoom(ZOOM),
+	aspectRatio(PERSPECTIVE_ASPECT),
+	nearPlane(PERSPECTIVE_NEAR),
+	farPlane(PERSPECTIVE_FAR),
+	viewDirty(true),
+	projectionDirty(true),
+	combinedDirty(true),
+	version(0) {
 	updateCameraVectors();
 }
 
-glm::mat4 Camera::getViewMatrix() {
-	return glm::lookAt(position, position + front, up);
+const glm::mat4& Camera::getViewMatrix() {
+	if (viewDirty) {
+		view = glm::lookAt(position, position + front, up);
+		viewDirty = false;
+	}
+	return view;
+}
+
+void Camera::setPerspective(float aspectRatio, float nearPlane, float farPlane) {
+	if (aspectRatio == this->aspectRatio && nearPlane == this->nearPlane && farPlane == this->farPlane)
+		return;
+	this->aspectRatio = aspectRatio;
+	this->nearPlane = nearPlane;
+	this->farPlane = farPlane;
+	markProjectionDirty();
+}
+
+const glm::mat4& Camera::getProjectionMatrix() {
+	if (projectionDirty) {
+		projection = glm::perspective(glm::radians(zoom), aspectRatio, nearPlane, farPlane);
+		projectionDirty = false;
+	}
+	return projection;
+}
+
+const glm::mat4& Camera::getViewProjectionMatrix() {
+	if (combinedDirty) {
+		viewProjection = getProjectionMatrix() * getViewMatrix();
+		frustum = Frustum::fromMatrix(viewProjection);
+		combinedDirty = false;
+	}
+	return viewProjection;
+}
+
+const Frustum& Camera::getFrustum() {
+	getViewProjectionMatrix();
+	return frustum;
+}
+
+Frustum Camera::getFrustum(const glm::mat4& projection) {
+	return Frustum::fromMatrix(projection * getViewMatrix());
 }
 
 void Camera::processKeyboard(CameraMovement direction, float deltaTime) {
 	float velocity = movementSpeed * deltaTime;
+	if (velocity == 0.0f)
+		return;
 	if (direction == CameraMovement::FORWARD)
 		position += front * velocity;
 	if (direction == CameraMovement::BACKWARD)
@@ -50,9 +105,12 @@ void Camera::processKeyboard(CameraMovement direction, float deltaTime) {
 		position -= right * velocity;
 	if (direction == CameraMovement::RIGHT)
 		position += right * velocity;
+	markViewDirty();
 }
 
 void Camera::processMouseMovement(float xOffset, float yOffset, GLboolean constrainPitch) {
+	if (xOffset == 0.0f && yOffset == 0.0f)
+		return;
 	xOffset *= mouseSensitivity;
 	yOffset *= mouseSensitivity;
 	yaw += xOffset;
@@ -67,11 +125,14 @@ void Camera::processMouseMovement(float xOffset, float yOffset, GLboolean constr
 }
 
 void Camera::processMouseScroll(float yOffset) {
+	float previousZoom = zoom;
 	zoom -= (float)yOffset;
 	if (zoom < 1.0f)
 		zoom = 1.0f;
 	if (zoom > 45.0f)
 		zoom = 45.0f;
+	if (zoom != previousZoom)
+		markProjectionDirty();
 }
 
 void Camera::updateCameraVectors() {
@@ -82,6 +143,19 @@ void Camera::updateCameraVectors() {
 	front = glm::normalize(cameraFront);
 	right = glm::normalize(glm::cross(front, worldUp));
 	up = glm::normalize(glm::cross(right, front));
+	markViewDirty();
+}
+
+void Camera::markViewDirty() {
+	viewDirty = true;
+	combinedDirty = true;
+	version++;
+}
+
+void Camera::markProjectionDirty() {
+	projectionDirty = true;
+	combinedDirty = true;
+	version++;
 }
 
 glm::vec3 Camera::getPosition() { return position; }
@@ -90,6 +164,13 @@ glm::vec3 Camera::getFront() { return front; }
 
 float Camera::getFOV() { return zoom; }
 
+unsigned long long Camera::getVersion() const { return version; }
+
 float Camera::getYaw() { return yaw; }
 
-void Camera::setYaw(float yaw) { this->yaw = yaw; }
\ No newline at end of file
+void Camera::setYaw(float yaw) {
+	if (yaw == this->yaw)
+		return;
+	this->yaw = yaw;
+	updateCameraVectors();
+}
\ No newline at end of file
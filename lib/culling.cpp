@@ -0,0 +1,423 @@
+/**
+ * @file culling.cpp
+ * @brief Batched frustum culling of bounding spheres and boxes
+ * @date October 2026
+ */
+
+#include <learnopengl/culling.h>
+#include <learnopengl/parallel.h>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CULLING_SSE
+#include <emmintrin.h>
+#endif
+// the AVX2 path is compiled for x86-64 regardless of the build flags and only taken when the CPU reports it
+#if defined(_M_X64) || (defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__)))
+#define CULLING_AVX2
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#define CULLING_AVX2_TARGET
+#else
+#define CULLING_AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+Culling::Path Culling::path = Culling::getBestPath();
+bool Culling::parallel = true;
+unsigned long long Culling::tested = 0;
+unsigned long long Culling::culled = 0;
+
+namespace {
+
+// cull [begin, end) and write the surviving indices to out, which has room for end - begin + 8; returns how many
+typedef std::size_t (*Kernel)(const float* const* arrays, std::size_t begin, std::size_t end, const Frustum& frustum,
+	unsigned int* out);
+
+// the set lanes of every 8-lane mask in order, so a mask's indices are one add and one store
+struct LaneTable {
+	unsigned int lanes[256][8];
+	unsigned int counts[256];
+	LaneTable() {
+		for (unsigned int mask = 0; mask < 256; mask++) {
+			counts[mask] = 0;
+			for (unsigned int lane = 0; lane < 8; lane++) {
+				lanes[mask][lane] = 0;
+				if (mask & (1u << lane))
+					lanes[mask][counts[mask]++] = lane;
+			}
+		}
+	}
+};
+
+const LaneTable& getLaneTable() {
+	static const LaneTable table;
+	return table;
+}
+
+// every path associates the sums the same way so they agree on bounds touching a plane
+std::size_t cullSpheresScalar(const float* const* arrays, std::size_t begin, std::size_t end, const Frustum& frustum,
+	unsigned int* out) {
+	std::size_t written = 0;
+	for (std::size_t i = begin; i < end; i++) {
+		bool inside = true;
+		for (const glm::vec4& plane : frustum.planes)
+			inside &= (arrays[0][i] * plane.x + arrays[1][i] * plane.y) + (arrays[2][i] * plane.z + plane.w) >= -arrays[3][i];
+		out[written] = static_cast<unsigned int>(i);
+		written += inside;
+	}
+	return written;
+}
+
+// a box as center and half extents: the corner farthest along a normal lies |normal| . extents past the center
+std::size_t cullBoxesScalar(const float* const* arrays, std::size_t begin, std::size_t end, const Frustum& frustum,
+	unsigned int* out) {
+	std::size_t written = 0;
+	for (std::size_t i = begin; i < end; i++) {
+		float center[3], extent[3];
+		for (int axis = 0; axis < 3; axis++) {
+			center[axis] = (arrays[axis][i] + arrays[axis + 3][i]) * 0.5f;
+			extent[axis] = (arrays[axis + 3][i] - arrays[axis][i]) * 0.5f;
+		}
+		bool inside = true;
+		for (const glm::vec4& plane : frustum.planes)
+			inside &= (center[0] * plane.x + center[1] * plane.y) + (center[2] * plane.z + plane.w)
+				+ ((extent[0] * std::fabs(plane.x) + extent[1] * std::fabs(plane.y)) + extent[2] * std::fabs(plane.z)) >= 0.0f;
+		out[written] = static_cast<unsigned int>(i);
+		written += inside;
+	}
+	return written;
+}
+
+// the lanes past end hold padding or the next chunk's bounds
+unsigned int trimMask(unsigned int mask, std::size_t block, std::size_t end, unsigned int width) {
+	return end - block < width ? mask & ((1u << (end - block)) - 1) : mask;
+}
+
+#ifdef CULLING_SSE
+std::size_t cullSpheresSSE(const float* const* arrays, std::size_t begin, std::size_t end, const Frustum& frustum,
+	unsigned int* out) {
+	const LaneTable& table = getLaneTable();
+	std::size_t written = 0;
+	for (std::size_t block = begin; block < end; block += 4) {
+		__m128 x = _mm_loadu_ps(arrays[0] + block);
+		__m128 y = _mm_loadu_ps(arrays[1] + block);
+		__m128 z = _mm_loadu_ps(arrays[2] + block);
+		__m128 negativeR = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(arrays[3] + block));
+		__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (const glm::vec4& plane : frustum.planes) {
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_mul_ps(y, _mm_set1_ps(plane.y))),
+				_mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w)));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, negativeR));
+		}
+		unsigned int mask = trimMask(static_cast<unsigned int>(_mm_movemask_ps(inside)), block, end, 4);
+		__m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.lanes[mask]));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + written), _mm_add_epi32(lanes, _mm_set1_epi32(static_cast<int>(block))));
+		written += table.counts[mask];
+	}
+	return written;
+}
+
+std::size_t cullBoxesSSE(const float* const* arrays, std::size_t begin, std::size_t end, const Frustum& frustum,
+	unsigned int* out) {
+	const LaneTable& table = getLaneTable();
+	const __m128 half = _mm_set1_ps(0.5f);
+	std::size_t written = 0;
+	for (std::size_t block = begin; block < end; block += 4) {
+		__m128 center[3], extent[3];
+		for (int axis = 0; axis < 3; axis++) {
+			__m128 boundsMin = _mm_loadu_ps(arrays[axis] + block);
+			__m128 boundsMax = _mm_loadu_ps(arrays[axis + 3] + block);
+			center[axis] = _mm_mul_ps(_mm_add_ps(boundsMin, boundsMax), half);
+			extent[axis] = _mm_mul_ps(_mm_sub_ps(boundsMax, boundsMin), half);
+		}
+		__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (const glm::vec4& plane : frustum.planes) {
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(center[0], _mm_set1_ps(plane.x)), _mm_mul_ps(center[1], _mm_set1_ps(plane.y))),
+				_mm_add_ps(_mm_mul_ps(center[2], _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w)));
+			__m128 reach = _mm_add_ps(_mm_add_ps(_mm_mul_ps(extent[0], _mm_set1_ps(std::fabs(plane.x))),
+				_mm_mul_ps(extent[1], _mm_set1_ps(std::fabs(plane.y)))), _mm_mul_ps(extent[2], _mm_set1_ps(std::fabs(plane.z))));
+			inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(distance, reach), _mm_setzero_ps()));
+		}
+		unsigned int mask = trimMask(static_cast<unsigned int>(_mm_movemask_ps(inside)), block, end, 4);
+		__m128i lanes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(table.lanes[mask]));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(out + written), _mm_add_epi32(lanes, _mm_set1_epi32(static_cast<int>(block))));
+		written += table.counts[mask];
+	}
+	return written;
+}
+#endif
+
+#ifdef CULLING_AVX2
+CULLING_AVX2_TARGET std::size_t cullSpheresAVX2(const float* const* arrays, std::size_t begin, std::size_t end,
+	const Frustum& frustum, unsigned int* out) {
+	const LaneTable& table = getLaneTable();
+	std::size_t written = 0;
+	for (std::size_t block = begin; block < end; block += 8) {
+		__m256 x = _mm256_loadu_ps(arrays[0] + block);
+		__m256 y = _mm256_loadu_ps(arrays[1] + block);
+		__m256 z = _mm256_loadu_ps(arrays[2] + block);
+		__m256 negativeR = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(arrays[3] + block));
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (const glm::vec4& plane : frustum.planes) {
+			__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, _mm256_set1_ps(plane.x)), _mm256_mul_ps(y, _mm256_set1_ps(plane.y))),
+				_mm256_add_ps(_mm256_mul_ps(z, _mm256_set1_ps(plane.z)), _mm256_set1_ps(plane.w)));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, negativeR, _CMP_GE_OQ));
+		}
+		unsigned int mask = trimMask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), block, end, 8);
+		__m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.lanes[mask]));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + written),
+			_mm256_add_epi32(lanes, _mm256_set1_epi32(static_cast<int>(block))));
+		written += table.counts[mask];
+	}
+	return written;
+}
+
+CULLING_AVX2_TARGET std::size_t cullBoxesAVX2(const float* const* arrays, std::size_t begin, std::size_t end,
+	const Frustum& frustum, unsigned int* out) {
+	const LaneTable& table = getLaneTable();
+	const __m256 half = _mm256_set1_ps(0.5f);
+	std::size_t written = 0;
+	for (std::size_t block = begin; block < end; block += 8) {
+		__m256 center[3], extent[3];
+		for (int axis = 0; axis < 3; axis++) {
+			__m256 boundsMin = _mm256_loadu_ps(arrays[axis] + block);
+			__m256 boundsMax = _mm256_loadu_ps(arrays[axis + 3] + block);
+			center[axis] = _mm256_mul_ps(_mm256_add_ps(boundsMin, boundsMax), half);
+			extent[axis] = _mm256_mul_ps(_mm256_sub_ps(boundsMax, boundsMin), half);
+		}
+		__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		for (const glm::vec4& plane : frustum.planes) {
+			__m256 distance = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(center[0], _mm256_set1_ps(plane.x)),
+				_mm256_mul_ps(center[1], _mm256_set1_ps(plane.y))), _mm256_add_ps(_mm256_mul_ps(center[2], _mm256_set1_ps(plane.z)),
+				_mm256_set1_ps(plane.w)));
+			__m256 reach = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(extent[0], _mm256_set1_ps(std::fabs(plane.x))),
+				_mm256_mul_ps(extent[1], _mm256_set1_ps(std::fabs(plane.y)))), _mm256_mul_ps(extent[2], _mm256_set1_ps(std::fabs(plane.z))));
+			inside = _mm256_and_ps(inside, _mm256_cmp_ps(_mm256_add_ps(distance, reach), _mm256_setzero_ps(), _CMP_GE_OQ));
+		}
+		unsigned int mask = trimMask(static_cast<unsigned int>(_mm256_movemask_ps(inside)), block, end, 8);
+		__m256i lanes = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.lanes[mask]));
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(out + written),
+			_mm256_add_epi32(lanes, _mm256_set1_epi32(static_cast<int>(block))));
+		written += table.counts[mask];
+	}
+	return written;
+}
+
+bool hasAVX2() {
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 1);
+	// the OS must also save the YMM registers
+	bool avx = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && (_xgetbv(0) & 6) == 6;
+	__cpuid(info, 0);
+	if (!avx || info[0] < 7)
+		return false;
+	__cpuidex(info, 7, 0);
+	return (info[1] & (1 << 5)) != 0;
+#else
+	// the path is picked during static initialization, possibly before libgcc's own constructor
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+Kernel getKernel(Culling::Path path, bool boxes) {
+	switch (path) {
+#ifdef CULLING_AVX2
+	case Culling::Path::AVX2:
+		return boxes ? cullBoxesAVX2 : cullSpheresAVX2;
+#endif
+#ifdef CULLING_SSE
+	case Culling::Path::SSE:
+		return boxes ? cullBoxesSSE : cullSpheresSSE;
+#endif
+	default:
+		return boxes ? cullBoxesScalar : cullSpheresScalar;
+	}
+}
+
+}
+
+void BoundingSpheres::clear() {
+	resize(0);
+}
+
+std::size_t BoundingSpheres::size() const {
+	return count;
+}
+
+unsigned int BoundingSpheres::add(const glm::vec3& center, float radius) {
+	resize(count + 1);
+	set(static_cast<unsigned int>(count - 1), center, radius);
+	return static_cast<unsigned int>(count - 1);
+}
+
+void BoundingSpheres::set(unsigned int i, const glm::vec3& center, float radius) {
+	centerX[i] = center.x;
+	centerY[i] = center.y;
+	centerZ[i] = center.z;
+	this->radius[i] = radius;
+}
+
+void BoundingSpheres::assign(const glm::mat4* matrices, std::size_t count, const glm::vec3& center, float radius) {
+	resize(count);
+	for (std::size_t i = 0; i < count; i++) {
+		const glm::mat4& matrix = matrices[i];
+		float scale = std::max(glm::length(glm::vec3(matrix[0])), std::max(glm::length(glm::vec3(matrix[1])),
+			glm::length(glm::vec3(matrix[2]))));
+		set(static_cast<unsigned int>(i), glm::vec3(matrix * glm::vec4(center, 1.0f)), radius * scale);
+	}
+}
+
+std::size_t BoundingSpheres::cull(const Frustum& frustum, std::vector<unsigned int>& visible) const {
+	const float* arrays[] = { centerX.data(), centerY.data(), centerZ.data(), radius.data() };
+	return Culling::cull(arrays, false, count, frustum, visible);
+}
+
+void BoundingSpheres::resize(std::size_t count) {
+	this->count = count;
+	std::size_t padded = (count + 7) & ~std::size_t(7);
+	for (std::vector<float>* array : { &centerX, &centerY, &centerZ, &radius })
+		array->resize(padded, 0.0f);
+}
+
+void BoundingBoxes::clear() {
+	resize(0);
+}
+
+std::size_t BoundingBoxes::size() const {
+	return count;
+}
+
+unsigned int BoundingBoxes::add(const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+	resize(count + 1);
+	set(static_cast<unsigned int>(count - 1), boundsMin, boundsMax);
+	return static_cast<unsigned int>(count - 1);
+}
+
+void BoundingBoxes::set(unsigned int i, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+	minX[i] = boundsMin.x;
+	minY[i] = boundsMin.y;
+	minZ[i] = boundsMin.z;
+	maxX[i] = boundsMax.x;
+	maxY[i] = boundsMax.y;
+	maxZ[i] = boundsMax.z;
+}
+
+void BoundingBoxes::assign(const glm::mat4* matrices, std::size_t count, const glm::vec3& boundsMin, const glm::vec3& boundsMax) {
+	resize(count);
+	glm::vec3 center = 0.5f * (boundsMin + boundsMax);
+	glm::vec3 extent = 0.5f * (boundsMax - boundsMin);
+	for (std::size_t i = 0; i < count; i++) {
+		// the transformed box reaches |M| * extent along each axis (Arvo)
+		glm::mat3 absolute(matrices[i]);
+		for (int column = 0; column < 3; column++)
+			absolute[column] = glm::abs(absolute[column]);
+		glm::vec3 worldCenter(matrices[i] * glm::vec4(center, 1.0f));
+		glm::vec3 worldExtent = absolute * extent;
+		set(static_cast<unsigned int>(i), worldCenter - worldExtent, worldCenter + worldExtent);
+	}
+}
+
+std::size_t BoundingBoxes::cull(const Frustum& frustum, std::vector<unsigned int>& visible) const {
+	const float* arrays[] = { minX.data(), minY.data(), minZ.data(), maxX.data(), maxY.data(), maxZ.data() };
+	return Culling::cull(arrays, true, count, frustum, visible);
+}
+
+void BoundingBoxes::resize(std::size_t count) {
+	this->count = count;
+	std::size_t padded = (count + 7) & ~std::size_t(7);
+	for (std::vector<float>* array : { &minX, &minY, &minZ, &maxX, &maxY, &maxZ })
+		array->resize(padded, 0.0f);
+}
+
+Culling::Path Culling::getBestPath() {
+#ifdef CULLING_AVX2
+	static const bool avx2 = hasAVX2();
+	if (avx2)
+		return Path::AVX2;
+#endif
+#ifdef CULLING_SSE
+	return Path::SSE;
+#else
+	return Path::SCALAR;
+#endif
+}
+
+Culling::Path Culling::getPath() {
+	return path;
+}
+
+void Culling::setPath(Path path) {
+	Culling::path = std::min(path, getBestPath());
+}
+
+const char* Culling::getPathName(Path path) {
+	switch (path) {
+	case Path::AVX2:
+		return "AVX2";
+	case Path::SSE:
+		return "SSE";
+	default:
+		return "scalar";
+	}
+}
+
+void Culling::setParallel(bool parallel) {
+	Culling::parallel = parallel;
+}
+
+bool Culling::getParallel() {
+	return parallel;
+}
+
+std::size_t Culling::cull(const float* const* arrays, bool boxes, std::size_t count, const Frustum& frustum,
+	std::vector<unsigned int>& visible) {
+	Kernel kernel = getKernel(path, boxes);
+	std::size_t chunks = parallel && count >= PARALLEL_THRESHOLD && workerCount() > 1 ? (count + CHUNK_SIZE - 1) / CHUNK_SIZE : 1;
+	// each chunk writes from its own start plus the 8 slots its last wide store may spill into
+	visible.resize(count + chunks * 8);
+	std::size_t written = 0;
+	if (chunks == 1)
+		written = kernel(arrays, 0, count, frustum, visible.data());
+	else {
+		std::vector<std::size_t> counts(chunks);
+		parallelFor(chunks, [&](std::size_t chunk) {
+			std::size_t begin = chunk * CHUNK_SIZE;
+			counts[chunk] = kernel(arrays, begin, std::min(begin + CHUNK_SIZE, count), frustum, &visible[begin + chunk * 8]);
+		});
+		// every chunk's indices only move towards the front, so compacting in order never overwrites unread ones
+		for (std::size_t chunk = 0; chunk < chunks; chunk++) {
+			std::memmove(&visible[written], &visible[chunk * (CHUNK_SIZE + 8)], counts[chunk] * sizeof(unsigned int));
+			written += counts[chunk];
+		}
+	}
+	visible.resize(written);
+	tested += count;
+	culled += count - written;
+	return written;
+}
+
+unsigned long long Culling::getTested() {
+	return tested;
+}
+
+unsigned long long Culling::getCulled() {
+	return culled;
+}
+
+void Culling::resetCounters() {
+	tested = 0;
+	culled = 0;
+}
+
+void Culling::printCounters(std::ostream& out) {
+	double percent = tested ? 100.0 * static_cast<double>(culled) / static_cast<double>(tested) : 0.0;
+	out << "culling (" << getPathName(path) << "): " << tested << " tested, " << culled << " culled (" << percent << "%), " << tested - culled
+		<< " drawn" << std::endl;
+}
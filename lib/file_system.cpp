@@ -0,0 +1,124 @@
+/**
+ * @file file_system.cpp
+ * @brief Read-only file mapping and directory helpers
+ * @date October 2026
+ */
+
+#include <learnopengl/file_system.h>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <direct.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <climits>
+#include <unistd.h>
+#endif
+#include <cstdlib>
+
+#ifdef _WIN32
+MappedFile::MappedFile() : mapping(nullptr), length(0), fileHandle(INVALID_HANDLE_VALUE), mappingHandle(nullptr) {}
+#else
+MappedFile::MappedFile() : mapping(nullptr), length(0) {}
+#endif
+
+MappedFile::~MappedFile() { close(); }
+
+bool MappedFile::open(const std::string& path) {
+	close();
+#ifdef _WIN32
+	fileHandle = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+		return false;
+	LARGE_INTEGER fileSize;
+	if (!GetFileSizeEx(fileHandle, &fileSize) || !fileSize.QuadPart) {
+		close();
+		return false;
+	}
+	mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (!mappingHandle) {
+		close();
+		return false;
+	}
+	mapping = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+	length = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+	int descriptor = ::open(path.c_str(), O_RDONLY);
+	if (descriptor < 0)
+		return false;
+	struct stat info;
+	if (fstat(descriptor, &info) || info.st_size <= 0) {
+		::close(descriptor);
+		return false;
+	}
+	void* view = mmap(nullptr, static_cast<std::size_t>(info.st_size), PROT_READ, MAP_PRIVATE, descriptor, 0);
+	// the mapping keeps its own reference to the file
+	::close(descriptor);
+	if (view == MAP_FAILED)
+		return false;
+	mapping = static_cast<const char*>(view);
+	length = static_cast<std::size_t>(info.st_size);
+#endif
+	if (!mapping) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+void MappedFile::close() {
+#ifdef _WIN32
+	if (mapping)
+		UnmapViewOfFile(mapping);
+	if (mappingHandle)
+		CloseHandle(mappingHandle);
+	if (fileHandle != INVALID_HANDLE_VALUE)
+		CloseHandle(fileHandle);
+	mappingHandle = nullptr;
+	fileHandle = INVALID_HANDLE_VALUE;
+#else
+	if (mapping)
+		munmap(const_cast<char*>(mapping), length);
+#endif
+	mapping = nullptr;
+	length = 0;
+}
+
+bool MappedFile::isOpen() const { return mapping != nullptr; }
+
+const char* MappedFile::data() const { return mapping; }
+
+std::size_t MappedFile::size() const { return length; }
+
+void makeDirectories(const std::string& path) {
+	for (std::size_t i = 0; i != std::string::npos; ) {
+		i = path.find('/', i + 1);
+		std::string partial = path.substr(0, i);
+#ifdef _WIN32
+		_mkdir(partial.c_str());
+#else
+		mkdir(partial.c_str(), 0755);
+#endif
+	}
+}
+
+std::string canonicalPath(const std::string& path) {
+#ifdef _WIN32
+	char resolved[MAX_PATH];
+	if (!_fullpath(resolved, path.c_str(), MAX_PATH))
+		return path;
+	std::string canonical(resolved);
+	for (char& c : canonical)
+		if (c == '\\')
+			c = '/';
+	return canonical;
+#else
+	char resolved[PATH_MAX];
+	if (!realpath(path.c_str(), resolved))
+		return path;
+	return resolved;
+#endif
+}
@@ -0,0 +1,67 @@
+/**
+ * @file fixed_timestep.cpp
+ * @brief Fixed simulation ticks decoupled from the render rate
+ * @date October 2026
+ */
+
+#include <learnopengl/fixed_timestep.h>
+#include <algorithm>
+#include <chrono>
+
+const double FixedTimestepLoop::DEFAULT_TICK = 1.0 / 120.0;
+const double FixedTimestepLoop::MAX_FRAME_SECONDS = 0.25;
+
+FixedTimestepLoop::FixedTimestepLoop(double tick)
+	: tick(tick > 0.0 ? tick : DEFAULT_TICK), timeScale(1.0), lastFrame(now()), accumulator(0.0), lastCount(0), ticks(0) {}
+
+double FixedTimestepLoop::getTick() const {
+	return tick;
+}
+
+void FixedTimestepLoop::setTimeScale(double scale) {
+	timeScale = std::max(scale, 0.0);
+}
+
+double FixedTimestepLoop::getTimeScale() const {
+	return timeScale;
+}
+
+unsigned int FixedTimestepLoop::advance() {
+	double frame = now();
+	double elapsed = std::min(frame - lastFrame, MAX_FRAME_SECONDS);
+	lastFrame = frame;
+	accumulator += elapsed * timeScale;
+	unsigned int count = 0;
+	while (accumulator >= tick) {
+		accumulator -= tick;
+		count++;
+	}
+	ticks += count;
+	lastCount = count;
+	return count;
+}
+
+double FixedTimestepLoop::getTickTime(unsigned int i) const {
+	if (timeScale <= 0.0 || lastCount == 0)
+		return lastFrame;
+	// the last tick ends where the accumulator's remainder begins, each earlier one a tick of real time before
+	return lastFrame - (accumulator + static_cast<double>(lastCount - 1 - std::min(i, lastCount - 1)) * tick) / timeScale;
+}
+
+float FixedTimestepLoop::getAlpha() const {
+	return static_cast<float>(accumulator / tick);
+}
+
+double FixedTimestepLoop::getTime() const {
+	return static_cast<double>(ticks) * tick;
+}
+
+unsigned long long FixedTimestepLoop::getTickCount() const {
+	return ticks;
+}
+
+double FixedTimestepLoop::now() {
+	typedef std::chrono::steady_clock Clock;
+	static const Clock::time_point start = Clock::now();
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
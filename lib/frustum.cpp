@@ -0,0 +1,49 @@
+/**
+ * @file frustum.cpp
+ * @brief View frustum planes and single bounds tests
+ * @date October 2026
+ */
+
+#include <learnopengl/frustum.h>
+
+Frustum Frustum::fromMatrix(const glm::mat4& clip) {
+	Frustum frustum;
+	glm::vec4 rows[4];
+	for (int row = 0; row < 4; row++)
+		rows[row] = glm::vec4(clip[0][row], clip[1][row], clip[2][row], clip[3][row]);
+	for (int axis = 0; axis < 3; axis++) {
+		frustum.planes[axis * 2] = rows[3] + rows[axis];
+		frustum.planes[axis * 2 + 1] = rows[3] - rows[axis];
+	}
+	for (glm::vec4& plane : frustum.planes)
+		plane /= glm::length(glm::vec3(plane));
+	return frustum;
+}
+
+Frustum Frustum::transformed(const glm::mat4& model) const {
+	// a plane row vector times the matrix gives the plane over the untransformed points
+	Frustum frustum;
+	for (int i = 0; i < NUM_PLANES; i++) {
+		glm::vec4 plane = planes[i] * model;
+		frustum.planes[i] = plane / glm::length(glm::vec3(plane));
+	}
+	return frustum;
+}
+
+bool Frustum::intersectsSphere(const glm::vec3& center, float radius) const {
+	for (const glm::vec4& plane : planes)
+		if (glm::dot(glm::vec3(plane), center) + plane.w < -radius)
+			return false;
+	return true;
+}
+
+bool Frustum::intersectsBox(const glm::vec3& boundsMin, const glm::vec3& boundsMax) const {
+	for (const glm::vec4& plane : planes) {
+		// the corner farthest along the normal
+		glm::vec3 corner(plane.x >= 0.0f ? boundsMax.x : boundsMin.x, plane.y >= 0.0f ? boundsMax.y : boundsMin.y,
+			plane.z >= 0.0f ? boundsMax.z : boundsMin.z);
+		if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.0f)
+			return false;
+	}
+	return true;
+}
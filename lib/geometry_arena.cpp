@@ -0,0 +1,299 @@
+/**
+ * @file geometry_arena.cpp
+ * @brief Shared vertex and index buffers sub-allocated between meshes
+ * @date October 2026
+ */
+
+#include <learnopengl/geometry_arena.h>
+#include <learnopengl/gl_state.h>
+#include <algorithm>
+#include <utility>
+
+std::unordered_map<unsigned int, std::unique_ptr<GeometryArena>> GeometryArena::arenas;
+
+FreeListAllocator::FreeListAllocator(std::size_t capacity) : capacity(0), freeSpace(0) {
+	grow(capacity);
+}
+
+std::size_t FreeListAllocator::allocate(std::size_t size) {
+	if (!size)
+		return 0;
+	// smallest free range that fits, so large ranges stay whole for large requests
+	std::multimap<std::size_t, std::size_t>::iterator fit = rangesBySize.lower_bound(size);
+	if (fit == rangesBySize.end())
+		return INVALID;
+	std::size_t offset = fit->second;
+	std::size_t rangeSize = fit->first;
+	eraseRange(rangesByOffset.find(offset));
+	if (rangeSize > size)
+		insertRange(offset + size, rangeSize - size);
+	freeSpace -= size;
+	return offset;
+}
+
+void FreeListAllocator::free(std::size_t offset, std::size_t size) {
+	if (!size)
+		return;
+	freeSpace += size;
+	// merge with the free neighbors on either side
+	std::map<std::size_t, std::size_t>::iterator next = rangesByOffset.lower_bound(offset);
+	if (next != rangesByOffset.end() && offset + size == next->first) {
+		size += next->second;
+		eraseRange(next);
+		next = rangesByOffset.lower_bound(offset);
+	}
+	if (next != rangesByOffset.begin()) {
+		std::map<std::size_t, std::size_t>::iterator previous = std::prev(next);
+		if (previous->first + previous->second == offset) {
+			offset = previous->first;
+			size += previous->second;
+			eraseRange(previous);
+		}
+	}
+	insertRange(offset, size);
+}
+
+void FreeListAllocator::grow(std::size_t capacity) {
+	if (capacity <= this->capacity)
+		return;
+	std::size_t added = capacity - this->capacity;
+	std::size_t offset = this->capacity;
+	this->capacity = capacity;
+	free(offset, added);
+}
+
+void FreeListAllocator::reset(std::size_t capacity, std::size_t used) {
+	rangesByOffset.clear();
+	rangesBySize.clear();
+	this->capacity = capacity;
+	freeSpace = 0;
+	free(used, capacity - used);
+}
+
+std::size_t FreeListAllocator::getCapacity() const {
+	return capacity;
+}
+
+std::size_t FreeListAllocator::getFree() const {
+	return freeSpace;
+}
+
+std::size_t FreeListAllocator::getLargestFree() const {
+	return rangesBySize.empty() ? 0 : rangesBySize.rbegin()->first;
+}
+
+float FreeListAllocator::getFragmentation() const {
+	if (!freeSpace)
+		return 0.0f;
+	return 1.0f - static_cast<float>(getLargestFree()) / static_cast<float>(freeSpace);
+}
+
+void FreeListAllocator::insertRange(std::size_t offset, std::size_t size) {
+	rangesByOffset[offset] = size;
+	rangesBySize.insert(std::make_pair(size, offset));
+}
+
+void FreeListAllocator::eraseRange(std::map<std::size_t, std::size_t>::iterator range) {
+	std::pair<std::multimap<std::size_t, std::size_t>::iterator, std::multimap<std::size_t, std::size_t>::iterator> sized =
+		rangesBySize.equal_range(range->second);
+	for (std::multimap<std::size_t, std::size_t>::iterator it = sized.first; it != sized.second; ++it) {
+		if (it->second == range->first) {
+			rangesBySize.erase(it);
+			break;
+		}
+	}
+	rangesByOffset.erase(range);
+}
+
+GeometryHandle::GeometryHandle() : arena(nullptr), allocation(0) {}
+
+GeometryHandle::GeometryHandle(GeometryArena* arena, unsigned int allocation) : arena(arena), allocation(allocation) {}
+
+GeometryHandle::GeometryHandle(GeometryHandle&& other) noexcept : arena(other.arena), allocation(other.allocation) {
+	other.arena = nullptr;
+}
+
+GeometryHandle& GeometryHandle::operator=(GeometryHandle&& other) noexcept {
+	std::swap(arena, other.arena);
+	std::swap(allocation, other.allocation);
+	return *this;
+}
+
+GeometryHandle::~GeometryHandle() {
+	if (arena)
+		arena->free(allocation);
+}
+
+GeometryArena* GeometryHandle::getArena() const {
+	return arena;
+}
+
+unsigned int GeometryHandle::getAllocation() const {
+	return allocation;
+}
+
+GeometryArena& GeometryArena::get(const VertexFormat& format) {
+	std::unique_ptr<GeometryArena>& arena = arenas[format.getKey()];
+	if (!arena)
+		arena.reset(new GeometryArena(format));
+	return *arena;
+}
+
+GeometryArena::GeometryArena(const VertexFormat& format)
+	: format(format),
+	stride(format.getStride()),
+	vertexSpace(INITIAL_VERTICES),
+	indexSpace(INITIAL_INDEX_UNITS),
+	numCompactions(0) {
+	glGenVertexArrays(1, &vao);
+	glGenBuffers(1, &vertexBuffer);
+	glGenBuffers(1, &indexBuffer);
+	GLState::bindBuffer(GL_COPY_WRITE_BUFFER, vertexBuffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, INITIAL_VERTICES * stride, nullptr, GL_STATIC_DRAW);
+	GLState::bindBuffer(GL_COPY_WRITE_BUFFER, indexBuffer);
+	glBufferData(GL_COPY_WRITE_BUFFER, INITIAL_INDEX_UNITS * INDEX_UNIT, nullptr, GL_STATIC_DRAW);
+	setupVertexArray();
+}
+
+GeometryHandle GeometryArena::allocate(const void* vertices, std::size_t numVertices, const void* indices,
+	std::size_t indexBytes) {
+	unsigned int id;
+	if (unusedAllocations.empty()) {
+		id = static_cast<unsigned int>(allocations.size());
+		allocations.push_back(Allocation());
+	} else {
+		id = unusedAllocations.back();
+		unusedAllocations.pop_back();
+	}
+	// recorded live before allocating, so a compaction for the index range carries the vertex range along
+	Allocation empty = { 0, 0, 0, 0, true };
+	allocations[id] = empty;
+	std::size_t vertexOffset = allocateRange(true, numVertices);
+	allocations[id].vertexOffset = vertexOffset;
+	allocations[id].numVertices = numVertices;
+	std::size_t indexUnits = (indexBytes + INDEX_UNIT - 1) / INDEX_UNIT;
+	std::size_t indexOffset = allocateRange(false, indexUnits);
+	allocations[id].indexOffset = indexOffset;
+	allocations[id].indexUnits = indexUnits;
+
+	const Allocation& allocation = allocations[id];
+	if (numVertices) {
+		GLState::bindBuffer(GL_COPY_WRITE_BUFFER, vertexBuffer);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, allocation.vertexOffset * stride, numVertices * stride, vertices);
+	}
+	if (indexBytes) {
+		GLState::bindBuffer(GL_COPY_WRITE_BUFFER, indexBuffer);
+		glBufferSubData(GL_COPY_WRITE_BUFFER, allocation.indexOffset * INDEX_UNIT, indexBytes, indices);
+	}
+	return GeometryHandle(this, id);
+}
+
+GLint GeometryArena::getBaseVertex(unsigned int allocation) const {
+	return static_cast<GLint>(allocations[allocation].vertexOffset);
+}
+
+std::size_t GeometryArena::getIndexOffset(unsigned int allocation) const {
+	return allocations[allocation].indexOffset * INDEX_UNIT;
+}
+
+GLuint GeometryArena::getVAO() const {
+	return vao;
+}
+
+void GeometryArena::compact() {
+	relocate(true, vertexSpace.getCapacity());
+	relocate(false, indexSpace.getCapacity());
+	numCompactions++;
+}
+
+void GeometryArena::printStats(std::ostream& out) {
+	for (const std::pair<const unsigned int, std::unique_ptr<GeometryArena>>& entry : arenas) {
+		const GeometryArena& arena = *entry.second;
+		std::size_t live = arena.allocations.size() - arena.unusedAllocations.size();
+		std::size_t vertexCapacity = arena.vertexSpace.getCapacity();
+		std::size_t indexCapacity = arena.indexSpace.getCapacity();
+		out << "geometry arena " << entry.first << ": " << live << " meshes, "
+			<< (vertexCapacity - arena.vertexSpace.getFree()) * arena.stride / 1024 << "/" << vertexCapacity * arena.stride / 1024
+			<< " KiB vertices, " << (indexCapacity - arena.indexSpace.getFree()) * INDEX_UNIT / 1024 << "/"
+			<< indexCapacity * INDEX_UNIT / 1024 << " KiB indices, fragmentation " << arena.vertexSpace.getFragmentation()
+			<< "/" << arena.indexSpace.getFragmentation() << ", " << arena.numCompactions << " compactions" << std::endl;
+	}
+}
+
+void GeometryArena::free(unsigned int allocation) {
+	Allocation& freed = allocations[allocation];
+	vertexSpace.free(freed.vertexOffset, freed.numVertices);
+	indexSpace.free(freed.indexOffset, freed.indexUnits);
+	freed.live = false;
+	unusedAllocations.push_back(allocation);
+}
+
+std::size_t GeometryArena::allocateRange(bool vertices, std::size_t size) {
+	FreeListAllocator& space = vertices ? vertexSpace : indexSpace;
+	if (isFragmented(space)) {
+		relocate(vertices, space.getCapacity());
+		numCompactions++;
+	}
+	std::size_t offset = space.allocate(size);
+	if (offset != FreeListAllocator::INVALID)
+		return offset;
+	// enough space in pieces is compacted into one range, otherwise the buffer doubles
+	std::size_t capacity = space.getCapacity();
+	if (space.getFree() < size) {
+		std::size_t needed = capacity - space.getFree() + size;
+		while (capacity < needed)
+			capacity *= 2;
+	} else
+		numCompactions++;
+	relocate(vertices, capacity);
+	return space.allocate(size);
+}
+
+void GeometryArena::relocate(bool vertices, std::size_t capacity) {
+	FreeListAllocator& space = vertices ? vertexSpace : indexSpace;
+	GLuint& buffer = vertices ? vertexBuffer : indexBuffer;
+	std::size_t unitSize = vertices ? stride : INDEX_UNIT;
+	// live ranges in buffer order, so every copy moves data towards the front
+	std::vector<unsigned int> order;
+	for (unsigned int i = 0; i < allocations.size(); i++)
+		if (allocations[i].live)
+			order.push_back(i);
+	std::sort(order.begin(), order.end(), [this, vertices](unsigned int a, unsigned int b) {
+		return vertices ? allocations[a].vertexOffset < allocations[b].vertexOffset
+			: allocations[a].indexOffset < allocations[b].indexOffset;
+	});
+
+	// copying within one buffer is undefined where source and destination overlap, so copy into a fresh one
+	GLuint relocated;
+	glGenBuffers(1, &relocated);
+	GLState::bindBuffer(GL_COPY_WRITE_BUFFER, relocated);
+	glBufferData(GL_COPY_WRITE_BUFFER, capacity * unitSize, nullptr, GL_STATIC_DRAW);
+	GLState::bindBuffer(GL_COPY_READ_BUFFER, buffer);
+	std::size_t used = 0;
+	for (unsigned int i : order) {
+		Allocation& allocation = allocations[i];
+		std::size_t& offset = vertices ? allocation.vertexOffset : allocation.indexOffset;
+		std::size_t size = vertices ? allocation.numVertices : allocation.indexUnits;
+		if (size)
+			glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, offset * unitSize, used * unitSize, size * unitSize);
+		offset = used;
+		used += size;
+	}
+	GLState::forgetBuffer(buffer);
+	glDeleteBuffers(1, &buffer);
+	buffer = relocated;
+	space.reset(capacity, used);
+	setupVertexArray();
+}
+
+void GeometryArena::setupVertexArray() {
+	GLState::bindVertexArray(vao);
+	GLState::bindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+	format.setupAttributes();
+	GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+	GLState::bindVertexArray(0);
+}
+
+bool GeometryArena::isFragmented(const FreeListAllocator& space) const {
+	return space.getFragmentation() > COMPACT_FRAGMENTATION && space.getFree() >= space.getCapacity() / 4;
+}
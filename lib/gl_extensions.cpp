@@ -0,0 +1,69 @@
+/**
+ * @file gl_extensions.cpp
+ * @brief Optional OpenGL entry point loading
+ * @date October 2026
+ */
+
+#include <learnopengl/gl_extensions.h>
+#include <GLFW/glfw3.h>
+#include <cstring>
+
+bool GLExtensions::loaded = false;
+int GLExtensions::version = 0;
+bool GLExtensions::programBinary = false;
+bool GLExtensions::parallelShaderCompile = false;
+bool GLExtensions::bufferStorage = false;
+bool GLExtensions::textureCompressionS3TC = false;
+bool GLExtensions::textureCompressionBPTC = false;
+PFNGLGETPROGRAMBINARYPROC_EXT GLExtensions::getProgramBinary = nullptr;
+PFNGLPROGRAMBINARYPROC_EXT GLExtensions::programBinaryLoad = nullptr;
+PFNGLPROGRAMPARAMETERIPROC_EXT GLExtensions::programParameteri = nullptr;
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC_EXT GLExtensions::maxShaderCompilerThreads = nullptr;
+PFNGLBUFFERSTORAGEPROC_EXT GLExtensions::bufferStorageAllocate = nullptr;
+
+void GLExtensions::load() {
+	if (loaded)
+		return;
+	loaded = true;
+	GLint major = 0, minor = 0;
+	glGetIntegerv(GL_MAJOR_VERSION, &major);
+	glGetIntegerv(GL_MINOR_VERSION, &minor);
+	version = major * 10 + minor;
+
+	// program binaries
+	if (version >= 41 || isSupported("GL_ARB_get_program_binary")) {
+		getProgramBinary = (PFNGLGETPROGRAMBINARYPROC_EXT)glfwGetProcAddress("glGetProgramBinary");
+		programBinaryLoad = (PFNGLPROGRAMBINARYPROC_EXT)glfwGetProcAddress("glProgramBinary");
+		programParameteri = (PFNGLPROGRAMPARAMETERIPROC_EXT)glfwGetProcAddress("glProgramParameteri");
+		GLint numFormats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+		programBinary = getProgramBinary && programBinaryLoad && programParameteri && numFormats > 0;
+	}
+
+	// background shader compilation
+	if (isSupported("GL_KHR_parallel_shader_compile"))
+		maxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC_EXT)glfwGetProcAddress("glMaxShaderCompilerThreadsKHR");
+	else if (isSupported("GL_ARB_parallel_shader_compile"))
+		maxShaderCompilerThreads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC_EXT)glfwGetProcAddress("glMaxShaderCompilerThreadsARB");
+	parallelShaderCompile = maxShaderCompilerThreads != nullptr;
+
+	// immutable buffers that can stay mapped while in use
+	if (version >= 44 || isSupported("GL_ARB_buffer_storage"))
+		bufferStorageAllocate = (PFNGLBUFFERSTORAGEPROC_EXT)glfwGetProcAddress("glBufferStorage");
+	bufferStorage = bufferStorageAllocate != nullptr;
+
+	// block-compressed texture formats
+	textureCompressionS3TC = isSupported("GL_EXT_texture_compression_s3tc");
+	textureCompressionBPTC = version >= 42 || isSupported("GL_ARB_texture_compression_bptc");
+}
+
+bool GLExtensions::isSupported(const char* extension) {
+	GLint numExtensions = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &numExtensions);
+	for (GLint i = 0; i < numExtensions; i++) {
+		const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+		if (name && !std::strcmp(name, extension))
+			return true;
+	}
+	return false;
+}
@@ -0,0 +1,231 @@
+/**
+ * @file gl_state.cpp
+ * @brief Shadowed OpenGL state that skips redundant binds
+ * @date October 2026
+ */
+
+#include <learnopengl/gl_state.h>
+#include <iomanip>
+
+GLuint GLState::program = GLState::UNKNOWN;
+GLuint GLState::activeUnit = GLState::UNKNOWN;
+GLuint GLState::textures[GLState::MAX_TEXTURE_UNITS][GLState::NUM_TEXTURE_TARGETS];
+GLuint GLState::vertexArray = GLState::UNKNOWN;
+GLuint GLState::arrayBuffer = GLState::UNKNOWN;
+GLuint GLState::elementBuffer = GLState::UNKNOWN;
+GLuint GLState::drawFramebuffer = GLState::UNKNOWN;
+GLuint GLState::readFramebuffer = GLState::UNKNOWN;
+GLuint GLState::capabilities[GLState::NUM_CAPABILITIES] = { GLState::UNKNOWN, GLState::UNKNOWN, GLState::UNKNOWN };
+GLenum GLState::blendSource = GLState::UNKNOWN;
+GLenum GLState::blendDestination = GLState::UNKNOWN;
+GLenum GLState::depthFunction = GLState::UNKNOWN;
+GLenum GLState::cullMode = GLState::UNKNOWN;
+unsigned long long GLState::issued[GLState::NUM_CATEGORIES] = {};
+unsigned long long GLState::elided[GLState::NUM_CATEGORIES] = {};
+
+static const char* CATEGORY_NAMES[GLState::NUM_CATEGORIES] = { "program", "texture", "vertex array", "buffer", "framebuffer", "render state" };
+
+// texture shadows start unknown; done here since the array is too large for an initializer list
+static const bool TEXTURES_INITIALIZED = (GLState::invalidate(), true);
+
+void GLState::useProgram(GLuint id) {
+	if (update(PROGRAM, program, id))
+		glUseProgram(id);
+}
+
+void GLState::activeTexture(GLenum unit) {
+	if (update(TEXTURE, activeUnit, unit - GL_TEXTURE0))
+		glActiveTexture(unit);
+}
+
+void GLState::bindTexture(GLenum target, GLuint texture) {
+	int index = textureTargetIndex(target);
+	if (activeUnit >= MAX_TEXTURE_UNITS || index < 0) {
+		issued[TEXTURE]++;
+		glBindTexture(target, texture);
+		return;
+	}
+	if (update(TEXTURE, textures[activeUnit][index], texture))
+		glBindTexture(target, texture);
+}
+
+void GLState::bindTexture(unsigned int unit, GLenum target, GLuint texture) {
+	int index = textureTargetIndex(target);
+	if (unit < MAX_TEXTURE_UNITS && index >= 0 && textures[unit][index] == texture) {
+		elided[TEXTURE]++;
+		return;
+	}
+	activeTexture(GL_TEXTURE0 + unit);
+	bindTexture(target, texture);
+}
+
+void GLState::bindVertexArray(GLuint id) {
+	if (update(VERTEX_ARRAY, vertexArray, id)) {
+		glBindVertexArray(id);
+		// the element buffer binding is part of the vertex array
+		elementBuffer = UNKNOWN;
+	}
+}
+
+void GLState::bindBuffer(GLenum target, GLuint buffer) {
+	GLuint* shadow = target == GL_ARRAY_BUFFER ? &arrayBuffer : target == GL_ELEMENT_ARRAY_BUFFER ? &elementBuffer : nullptr;
+	if (!shadow) {
+		issued[BUFFER]++;
+		glBindBuffer(target, buffer);
+	} else if (update(BUFFER, *shadow, buffer))
+		glBindBuffer(target, buffer);
+}
+
+void GLState::bindFramebuffer(GLenum target, GLuint framebuffer) {
+	bool changed;
+	if (target == GL_READ_FRAMEBUFFER)
+		changed = update(FRAMEBUFFER, readFramebuffer, framebuffer);
+	else if (target == GL_DRAW_FRAMEBUFFER)
+		changed = update(FRAMEBUFFER, drawFramebuffer, framebuffer);
+	else {
+		changed = update(FRAMEBUFFER, drawFramebuffer, framebuffer) | (readFramebuffer != framebuffer);
+		readFramebuffer = framebuffer;
+	}
+	if (changed)
+		glBindFramebuffer(target, framebuffer);
+}
+
+void GLState::enable(GLenum capability) { setCapability(capability, true); }
+
+void GLState::disable(GLenum capability) { setCapability(capability, false); }
+
+void GLState::blendFunc(GLenum source, GLenum destination) {
+	if (blendSource == source && blendDestination == destination) {
+		elided[RENDER_STATE]++;
+		return;
+	}
+	issued[RENDER_STATE]++;
+	blendSource = source;
+	blendDestination = destination;
+	glBlendFunc(source, destination);
+}
+
+void GLState::depthFunc(GLenum function) {
+	if (update(RENDER_STATE, depthFunction, function))
+		glDepthFunc(function);
+}
+
+void GLState::cullFace(GLenum mode) {
+	if (update(RENDER_STATE, cullMode, mode))
+		glCullFace(mode);
+}
+
+void GLState::forgetProgram(GLuint id) {
+	// a deleted program stays in use until another one is made current
+	if (program == id)
+		program = UNKNOWN;
+}
+
+void GLState::forgetTexture(GLuint texture) {
+	for (GLuint (&unit)[NUM_TEXTURE_TARGETS] : textures)
+		for (GLuint& bound : unit)
+			if (bound == texture)
+				bound = UNKNOWN;
+}
+
+void GLState::forgetVertexArray(GLuint id) {
+	if (vertexArray == id)
+		vertexArray = elementBuffer = UNKNOWN;
+}
+
+void GLState::forgetBuffer(GLuint buffer) {
+	if (arrayBuffer == buffer)
+		arrayBuffer = UNKNOWN;
+	if (elementBuffer == buffer)
+		elementBuffer = UNKNOWN;
+}
+
+void GLState::forgetFramebuffer(GLuint framebuffer) {
+	if (drawFramebuffer == framebuffer)
+		drawFramebuffer = UNKNOWN;
+	if (readFramebuffer == framebuffer)
+		readFramebuffer = UNKNOWN;
+}
+
+void GLState::invalidate() {
+	program = activeUnit = vertexArray = arrayBuffer = elementBuffer = drawFramebuffer = readFramebuffer = UNKNOWN;
+	for (GLuint (&unit)[NUM_TEXTURE_TARGETS] : textures)
+		for (GLuint& bound : unit)
+			bound = UNKNOWN;
+	for (GLuint& capability : capabilities)
+		capability = UNKNOWN;
+	blendSource = blendDestination = depthFunction = cullMode = UNKNOWN;
+}
+
+unsigned long long GLState::getIssued(Category category) { return issued[category]; }
+
+unsigned long long GLState::getElided(Category category) { return elided[category]; }
+
+void GLState::resetCounters() {
+	for (unsigned int i = 0; i < NUM_CATEGORIES; i++)
+		issued[i] = elided[i] = 0;
+}
+
+void GLState::printCounters(std::ostream& out) {
+	unsigned long long totalIssued = 0, totalElided = 0;
+	out << "gl state: calls issued / elided" << std::endl;
+	for (unsigned int i = 0; i < NUM_CATEGORIES; i++) {
+		out << "  " << std::left << std::setw(14) << CATEGORY_NAMES[i] << std::right
+			<< std::setw(12) << issued[i] << std::setw(12) << elided[i] << std::endl;
+		totalIssued += issued[i];
+		totalElided += elided[i];
+	}
+	unsigned long long total = totalIssued + totalElided;
+	out << "  " << std::left << std::setw(14) << "total" << std::right << std::setw(12) << totalIssued << std::setw(12) << totalElided
+		<< "  (" << std::fixed << std::setprecision(1) << (total ? 100.0 * totalElided / total : 0.0) << "% elided)" << std::endl;
+}
+
+bool GLState::update(Category category, GLuint& shadow, GLuint value) {
+	if (shadow == value) {
+		elided[category]++;
+		return false;
+	}
+	issued[category]++;
+	shadow = value;
+	return true;
+}
+
+int GLState::textureTargetIndex(GLenum target) {
+	switch (target) {
+		case GL_TEXTURE_2D:
+			return 0;
+		case GL_TEXTURE_CUBE_MAP:
+			return 1;
+		case GL_TEXTURE_2D_MULTISAMPLE:
+			return 2;
+		case GL_TEXTURE_3D:
+			return 3;
+		default:
+			return -1;
+	}
+}
+
+int GLState::capabilityIndex(GLenum capability) {
+	switch (capability) {
+		case GL_BLEND:
+			return 0;
+		case GL_DEPTH_TEST:
+			return 1;
+		case GL_CULL_FACE:
+			return 2;
+		default:
+			return -1;
+	}
+}
+
+void GLState::setCapability(GLenum capability, bool enabled) {
+	int index = capabilityIndex(capability);
+	if (index >= 0 && !update(RENDER_STATE, capabilities[index], enabled ? GL_TRUE : GL_FALSE))
+		return;
+	if (index < 0)
+		issued[RENDER_STATE]++;
+	if (enabled)
+		glEnable(capability);
+	else
+		glDisable(capability);
+}
@@ -6,63 +6,289 @@
  */
 
 #include <learnopengl/mesh.h>
+#include <learnopengl/gl_state.h>
+#include <glm/packing.hpp>
+#include <glm/gtc/packing.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <utility>
+
+static const UniformId<glm::vec3> POSITION_OFFSET = "positionOffset"_u;
+static const UniformId<glm::vec3> POSITION_SCALE = "positionScale"_u;
+// largest vertex count 16-bit indices can address
+static const unsigned int MAX_SHORT_INDEXED_VERTICES = 65536;
+// below this many triangles culling clusters costs more than drawing them
+static const unsigned int MIN_CLUSTERED_TRIANGLES = 4 * Meshlets::MAX_TRIANGLES;
+
+// project onto the octahedron |x| + |y| + |z| = 1 and fold the lower half over the diagonals
+static glm::vec2 encodeOctahedral(const glm::vec3& normal) {
+	float length = std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z);
+	if (length == 0.0f)
+		return glm::vec2(0.0f);
+	glm::vec3 n = normal / length;
+	glm::vec2 encoded(n.x, n.y);
+	if (n.z < 0.0f) {
+		glm::vec2 sign(n.x >= 0.0f ? 1.0f : -1.0f, n.y >= 0.0f ? 1.0f : -1.0f);
+		encoded = (1.0f - glm::abs(glm::vec2(n.y, n.x))) * sign;
+	}
+	return encoded;
+}
 
 Mesh::Mesh(
 	std::vector<Vertex> vertices,
 	std::vector<unsigned int> indices,
-	std::vector<Texture> textures
-) : vertices(vertices),
-	indices(indices),
-	textures(textures) {
-	setupMesh();
-}
-
-void Mesh::draw(Shader& shader) {
-	unsigned int diffuseNr = 1;
-	unsigned int specularNr = 1;
-	for (unsigned int i = 0; i < textures.size(); i++) {
-		glActiveTexture(GL_TEXTURE0 + i);
-		std::string number;
-		std::string name = textures[i].type;
-		if (name == "texture_diffuse")
-			number = std::to_string(diffuseNr++);
-		else if (name == "texture_specular")
-			number = std::to_string(specularNr++);
-		shader.setInt(("material." + (name + number)).c_str(), i);
-		glBindTexture(GL_TEXTURE_2D, textures[i].id);
+	std::vector<Texture> textures,
+	const VertexFormat& format,
+	std::vector<MeshLod> lods
+) : vertices(std::move(vertices)),
+	indices(std::move(indices)),
+	textures(std::move(textures)),
+	numIndices(static_cast<unsigned int>(this->indices.size())),
+	lods(std::move(lods)),
+	format(format),
+	boundsMin(0.0f),
+	boundsMax(0.0f) {
+	if (!this->vertices.empty()) {
+		boundsMin = boundsMax = this->vertices[0].position;
+		for (const Vertex& vertex : this->vertices) {
+			boundsMin = glm::min(boundsMin, vertex.position);
+			boundsMax = glm::max(boundsMax, vertex.position);
+		}
 	}
-	glBindVertexArray(vao);
-	glDrawElements(GL_TRIANGLES, static_cast<unsigned int>(indices.size()), GL_UNSIGNED_INT, 0);
-	glBindVertexArray(0);
-	// always good practice to set everything back to defaults once configured.
-	glActiveTexture(GL_TEXTURE0);
+	setupMesh(this->vertices.data(), static_cast<unsigned int>(this->vertices.size()), this->indices.data());
+	setupBindings();
+}
+
+Mesh::Mesh(
+	const Vertex* vertices,
+	unsigned int numVertices,
+	const unsigned int* indices,
+	unsigned int numIndices,
+	std::vector<Texture> textures,
+	const glm::vec3& boundsMin,
+	const glm::vec3& boundsMax,
+	const VertexFormat& format,
+	std::vector<MeshLod> lods
+) : textures(std::move(textures)),
+	numIndices(numIndices),
+	lods(std::move(lods)),
+	format(format),
+	boundsMin(boundsMin),
+	boundsMax(boundsMax) {
+	setupMesh(vertices, numVertices, indices);
+	setupBindings();
+}
+
+void Mesh::draw(Shader& shader, unsigned int lod) {
+	bind(shader);
+	if (lod >= lods.size())
+		lod = static_cast<unsigned int>(lods.size()) - 1;
+	glDrawElementsBaseVertex(GL_TRIANGLES, lods[lod].numIndices, indexType, getIndexOffset(lod), getBaseVertex());
+}
+
+void Mesh::drawInstanced(Shader& shader, GLsizei instances, unsigned int lod) {
+	bind(shader);
+	if (lod >= lods.size())
+		lod = static_cast<unsigned int>(lods.size()) - 1;
+	glDrawElementsInstancedBaseVertex(GL_TRIANGLES, lods[lod].numIndices, indexType, getIndexOffset(lod), instances, getBaseVertex());
+}
+
+void Mesh::drawClusters(Shader& shader, const glm::mat4& modelViewProjection, const glm::vec3& cameraPosition,
+	bool cullBackfaces) {
+	if (!meshlets.getNumMeshlets()) {
+		draw(shader);
+		return;
+	}
+	meshlets.cull(modelViewProjection, cameraPosition, cullBackfaces, rangeStarts, rangeCounts);
+	if (rangeStarts.empty())
+		return;
+	std::size_t indexSize = indexType == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(unsigned int);
+	std::size_t arenaOffset = geometry.getArena()->getIndexOffset(geometry.getAllocation());
+	rangeOffsets.resize(rangeStarts.size());
+	for (std::size_t i = 0; i < rangeStarts.size(); i++)
+		rangeOffsets[i] = reinterpret_cast<const void*>(arenaOffset + rangeStarts[i] * indexSize);
+	rangeBaseVertices.assign(rangeStarts.size(), getBaseVertex());
+	bind(shader);
+	glMultiDrawElementsBaseVertex(GL_TRIANGLES, rangeCounts.data(), indexType, rangeOffsets.data(),
+		static_cast<GLsizei>(rangeCounts.size()), rangeBaseVertices.data());
+}
+
+void Mesh::releaseCpuData() {
+	// clear() alone keeps the capacity
+	std::vector<Vertex>().swap(vertices);
+	std::vector<unsigned int>().swap(indices);
 }
 
 unsigned int Mesh::getVAO() {
-	return vao;
-}
-
-unsigned int Mesh::getNumIndices() {
-	return indices.size();
-}
-
-void Mesh::setupMesh() {
-	glGenVertexArrays(1, &vao);
-	glGenBuffers(1, &vbo);
-	glGenBuffers(1, &ebo);
-	glBindVertexArray(vao);
-	glBindBuffer(GL_ARRAY_BUFFER, vbo);
-	glBufferData(GL_ARRAY_BUFFER, vertices.size() * sizeof(Vertex), &vertices[0], GL_STATIC_DRAW);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(unsigned int), &indices[0], GL_STATIC_DRAW);
-	// vertex positions
-	glEnableVertexAttribArray(0);
-	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
-	// vertex normals
-	glEnableVertexAttribArray(1);
-	glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, normal));
-	// vertex texture coordinates
-	glEnableVertexAttribArray(2);
-	glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)offsetof(Vertex, texCoords));
-	glBindVertexArray(0);
+	return geometry.getArena()->getVAO();
+}
+
+unsigned int Mesh::getNumIndices(unsigned int lod) {
+	return lods[lod].numIndices;
+}
+
+const void* Mesh::getIndexOffset(unsigned int lod) const {
+	std::size_t indexSize = indexType == GL_UNSIGNED_SHORT ? sizeof(unsigned short) : sizeof(unsigned int);
+	std::size_t arenaOffset = geometry.getArena()->getIndexOffset(geometry.getAllocation());
+	return reinterpret_cast<const void*>(arenaOffset + lods[lod].firstIndex * indexSize);
+}
+
+GLint Mesh::getBaseVertex() const {
+	return geometry.getArena()->getBaseVertex(geometry.getAllocation());
+}
+
+unsigned int Mesh::getNumLods() const {
+	return static_cast<unsigned int>(lods.size());
+}
+
+const MeshLod& Mesh::getLod(unsigned int lod) const {
+	return lods[lod];
+}
+
+const Meshlets& Mesh::getMeshlets() const {
+	return meshlets;
+}
+
+GLenum Mesh::getIndexType() const {
+	return indexType;
+}
+
+const VertexFormat& Mesh::getFormat() const {
+	return format;
+}
+
+const glm::vec3& Mesh::getBoundsMin() const {
+	return boundsMin;
+}
+
+const glm::vec3& Mesh::getBoundsMax() const {
+	return boundsMax;
+}
+
+const glm::vec3& Mesh::getSphereCenter() const {
+	return sphereCenter;
+}
+
+float Mesh::getSphereRadius() const {
+	return sphereRadius;
+}
+
+void Mesh::setupMesh(const Vertex* vertexData, unsigned int numVertices, const unsigned int* indexData) {
+	if (lods.empty()) {
+		MeshLod full = { 0, numIndices, 0.0f };
+		lods.push_back(full);
+	}
+	// tighter than the box's half diagonal, which only bounds the corners
+	sphereCenter = 0.5f * (boundsMin + boundsMax);
+	float radiusSquared = 0.0f;
+	for (unsigned int i = 0; i < numVertices; i++) {
+		glm::vec3 offset = vertexData[i].position - sphereCenter;
+		radiusSquared = std::max(radiusSquared, glm::dot(offset, offset));
+	}
+	sphereRadius = std::sqrt(radiusSquared);
+	if (lods[0].numIndices >= MIN_CLUSTERED_TRIANGLES * 3)
+		meshlets.build(vertexData, numVertices, indexData, lods[0].firstIndex, lods[0].numIndices);
+	std::vector<unsigned char> packed;
+	const void* vertexBytes = vertexData;
+	if (format.isCompact()) {
+		packed = packVertices(vertexData, numVertices);
+		vertexBytes = packed.data();
+	}
+	GeometryArena& arena = GeometryArena::get(format);
+	if (numVertices <= MAX_SHORT_INDEXED_VERTICES) {
+		indexType = GL_UNSIGNED_SHORT;
+		std::vector<unsigned short> shortIndices(indexData, indexData + numIndices);
+		geometry = arena.allocate(vertexBytes, numVertices, shortIndices.data(), numIndices * sizeof(unsigned short));
+	} else {
+		indexType = GL_UNSIGNED_INT;
+		geometry = arena.allocate(vertexBytes, numVertices, indexData, numIndices * sizeof(unsigned int));
+	}
+}
+
+std::vector<unsigned char> Mesh::packVertices(const Vertex* vertexData, unsigned int numVertices) const {
+	unsigned int stride = format.getStride();
+	std::vector<unsigned char> packed(static_cast<std::size_t>(numVertices) * stride);
+	glm::vec3 extent = boundsMax - boundsMin;
+	// flat meshes have a zero extent along some axis
+	glm::vec3 inverseExtent(extent.x > 0.0f ? 1.0f / extent.x : 0.0f, extent.y > 0.0f ? 1.0f / extent.y : 0.0f,
+		extent.z > 0.0f ? 1.0f / extent.z : 0.0f);
+	for (unsigned int i = 0; i < numVertices; i++) {
+		const Vertex& vertex = vertexData[i];
+		unsigned char* out = &packed[static_cast<std::size_t>(i) * stride];
+		if (format.quantizedPositions) {
+			std::uint64_t position = glm::packUnorm4x16(glm::vec4((vertex.position - boundsMin) * inverseExtent, 0.0f));
+			std::memcpy(out, &position, sizeof(position));
+			out += sizeof(position);
+		} else {
+			std::memcpy(out, &vertex.position, sizeof(glm::vec3));
+			out += sizeof(glm::vec3);
+		}
+		if (format.normals == VertexFormat::FLOAT_NORMALS) {
+			std::memcpy(out, &vertex.normal, sizeof(glm::vec3));
+			out += sizeof(glm::vec3);
+		} else {
+			std::uint32_t normal = format.normals == VertexFormat::PACKED_NORMALS
+				? glm::packSnorm3x10_1x2(glm::vec4(vertex.normal, 0.0f))
+				: glm::packSnorm2x16(encodeOctahedral(vertex.normal));
+			std::memcpy(out, &normal, sizeof(normal));
+			out += sizeof(normal);
+		}
+		if (format.halfTexCoords) {
+			std::uint32_t texCoords = glm::packHalf2x16(vertex.texCoords);
+			std::memcpy(out, &texCoords, sizeof(texCoords));
+		} else
+			std::memcpy(out, &vertex.texCoords, sizeof(glm::vec2));
+	}
+	return packed;
+}
+
+const char* getTextureKindName(TextureKind kind) {
+	switch (kind) {
+	case TextureKind::DIFFUSE:
+		return "texture_diffuse";
+	case TextureKind::SPECULAR:
+		return "texture_specular";
+	case TextureKind::NORMAL:
+		return "texture_normal";
+	case TextureKind::HEIGHT:
+		return "texture_height";
+	}
+	return "";
+}
+
+void Mesh::bind(Shader& shader) {
+	unsigned long long program = shader.getProgramSerial();
+	if (std::find(boundPrograms.begin(), boundPrograms.end(), program) == boundPrograms.end()) {
+		for (const TextureBinding& binding : bindings)
+			shader.setInt(UniformName(binding.sampler), static_cast<int>(binding.unit));
+		boundPrograms.push_back(program);
+	}
+	// bindings are left in place, consecutive draws of the same mesh skip them
+	for (const TextureBinding& binding : bindings)
+		GLState::bindTexture(binding.unit, GL_TEXTURE_2D, binding.texture);
+	if (format.quantizedPositions) {
+		shader.set(POSITION_OFFSET, boundsMin);
+		shader.set(POSITION_SCALE, boundsMax - boundsMin);
+	}
+	GLState::bindVertexArray(geometry.getArena()->getVAO());
+}
+
+void Mesh::setupBindings() {
+	unsigned int numbers[NUM_TEXTURE_KINDS] = {};
+	bindings.clear();
+	boundPrograms.clear();
+	for (const Texture& texture : textures) {
+		unsigned int kind = static_cast<unsigned int>(texture.kind);
+		unsigned int number = numbers[kind]++;
+		if (number >= MAX_TEXTURES_PER_KIND) {
+			std::cout << "ERROR::MESH::TOO_MANY_TEXTURES " << getTextureKindName(texture.kind) << " " << texture.path << std::endl;
+			continue;
+		}
+		std::string uniform = std::string("material.") + getTextureKindName(texture.kind) + std::to_string(number + 1);
+		TextureBinding binding = { texture.id, kind * MAX_TEXTURES_PER_KIND + number, uniform };
+		bindings.push_back(std::move(binding));
+	}
 }
\ No newline at end of file
@@ -0,0 +1,206 @@
+/**
+ * @file mesh_cache.cpp
+ * @brief Binary .lmesh cache of imported models
+ * @date October 2026
+ */
+
+#include <learnopengl/mesh_cache.h>
+#include <learnopengl/hash.h>
+#include <fstream>
+#include <iostream>
+
+std::string MeshCache::directory = "cache/meshes";
+
+static std::size_t alignUp(std::size_t offset, std::size_t alignment) {
+	return (offset + alignment - 1) / alignment * alignment;
+}
+
+MeshCache::MeshCache() : header(nullptr), meshes(nullptr), lods(nullptr), textures(nullptr), strings(nullptr) {}
+
+bool MeshCache::open(const std::string& sourcePath, std::uint64_t sourceHash) {
+	close();
+	if (!file.open(getPath(sourcePath)))
+		return false;
+	header = reinterpret_cast<const Header*>(file.data());
+	if (file.size() < sizeof(Header) || header->magic != MAGIC || header->version != VERSION
+		|| header->sourceHash != sourceHash || header->vertexSize != sizeof(Vertex) || !validate()) {
+		close();
+		return false;
+	}
+	meshes = reinterpret_cast<const MeshRecord*>(file.data() + sizeof(Header));
+	lods = reinterpret_cast<const LodRecord*>(meshes + header->numMeshes);
+	textures = reinterpret_cast<const TextureRecord*>(lods + header->numLods);
+	strings = reinterpret_cast<const char*>(textures + header->numTextureRefs);
+	return true;
+}
+
+void MeshCache::close() {
+	file.close();
+	header = nullptr;
+	meshes = nullptr;
+	lods = nullptr;
+	textures = nullptr;
+	strings = nullptr;
+}
+
+unsigned int MeshCache::getNumMeshes() const { return header ? header->numMeshes : 0; }
+
+const Vertex* MeshCache::getVertices(unsigned int mesh) const {
+	return reinterpret_cast<const Vertex*>(file.data() + meshes[mesh].vertexOffset);
+}
+
+unsigned int MeshCache::getNumVertices(unsigned int mesh) const { return meshes[mesh].numVertices; }
+
+const unsigned int* MeshCache::getIndices(unsigned int mesh) const {
+	return reinterpret_cast<const unsigned int*>(file.data() + meshes[mesh].indexOffset);
+}
+
+unsigned int MeshCache::getNumIndices(unsigned int mesh) const { return meshes[mesh].numIndices; }
+
+glm::vec3 MeshCache::getBoundsMin(unsigned int mesh) const {
+	return glm::vec3(meshes[mesh].boundsMin[0], meshes[mesh].boundsMin[1], meshes[mesh].boundsMin[2]);
+}
+
+glm::vec3 MeshCache::getBoundsMax(unsigned int mesh) const {
+	return glm::vec3(meshes[mesh].boundsMax[0], meshes[mesh].boundsMax[1], meshes[mesh].boundsMax[2]);
+}
+
+std::vector<MeshLod> MeshCache::getLods(unsigned int mesh) const {
+	std::vector<MeshLod> result;
+	result.reserve(meshes[mesh].numLods);
+	for (std::uint32_t i = 0; i < meshes[mesh].numLods; i++) {
+		const LodRecord& record = lods[meshes[mesh].firstLod + i];
+		MeshLod lod = { record.firstIndex, record.numIndices, record.error };
+		result.push_back(lod);
+	}
+	return result;
+}
+
+std::vector<MeshCache::TextureRef> MeshCache::getTextures(unsigned int mesh) const {
+	std::vector<TextureRef> refs;
+	for (std::uint32_t i = 0; i < meshes[mesh].numTextureRefs; i++) {
+		const TextureRecord& record = textures[meshes[mesh].firstTextureRef + i];
+		TextureRef ref;
+		ref.kind = static_cast<TextureKind>(record.kind);
+		ref.path.assign(strings + record.pathOffset, record.pathLength);
+		refs.push_back(ref);
+	}
+	return refs;
+}
+
+void MeshCache::store(const std::string& sourcePath, std::uint64_t sourceHash, const std::vector<Mesh>& meshes) {
+	Header header = {};
+	header.magic = MAGIC;
+	header.version = VERSION;
+	header.sourceHash = sourceHash;
+	header.vertexSize = sizeof(Vertex);
+	header.numMeshes = static_cast<std::uint32_t>(meshes.size());
+	// tables first, so the blob offsets are known when the records are filled in
+	std::vector<MeshRecord> meshRecords(meshes.size());
+	std::vector<LodRecord> lodRecords;
+	std::vector<TextureRecord> textureRecords;
+	std::string stringTable;
+	for (std::size_t i = 0; i < meshes.size(); i++) {
+		meshRecords[i].firstLod = static_cast<std::uint32_t>(lodRecords.size());
+		meshRecords[i].numLods = meshes[i].getNumLods();
+		for (unsigned int j = 0; j < meshes[i].getNumLods(); j++) {
+			const MeshLod& lod = meshes[i].getLod(j);
+			LodRecord record = { lod.firstIndex, lod.numIndices, lod.error };
+			lodRecords.push_back(record);
+		}
+		meshRecords[i].firstTextureRef = static_cast<std::uint32_t>(textureRecords.size());
+		meshRecords[i].numTextureRefs = static_cast<std::uint32_t>(meshes[i].textures.size());
+		for (const Texture& texture : meshes[i].textures) {
+			TextureRecord record;
+			record.kind = static_cast<std::uint32_t>(texture.kind);
+			record.pathOffset = static_cast<std::uint32_t>(stringTable.size());
+			record.pathLength = static_cast<std::uint32_t>(texture.path.size());
+			stringTable += texture.path;
+			textureRecords.push_back(record);
+		}
+	}
+	header.numLods = static_cast<std::uint32_t>(lodRecords.size());
+	header.numTextureRefs = static_cast<std::uint32_t>(textureRecords.size());
+	header.stringTableSize = static_cast<std::uint32_t>(stringTable.size());
+	std::size_t offset = sizeof(Header) + meshRecords.size() * sizeof(MeshRecord) + lodRecords.size() * sizeof(LodRecord)
+		+ textureRecords.size() * sizeof(TextureRecord) + stringTable.size();
+	for (std::size_t i = 0; i < meshes.size(); i++) {
+		const Mesh& mesh = meshes[i];
+		if (mesh.vertices.empty() || mesh.indices.empty()) {
+			std::cout << "ERROR::MESH_CACHE::MESH_DATA_RELEASED " << sourcePath << std::endl;
+			return;
+		}
+		MeshRecord& record = meshRecords[i];
+		record.numVertices = static_cast<std::uint32_t>(mesh.vertices.size());
+		record.numIndices = static_cast<std::uint32_t>(mesh.indices.size());
+		for (int axis = 0; axis < 3; axis++) {
+			record.boundsMin[axis] = mesh.getBoundsMin()[axis];
+			record.boundsMax[axis] = mesh.getBoundsMax()[axis];
+		}
+		record.vertexOffset = offset = alignUp(offset, BLOB_ALIGNMENT);
+		offset += mesh.vertices.size() * sizeof(Vertex);
+		record.indexOffset = offset = alignUp(offset, sizeof(unsigned int));
+		offset += mesh.indices.size() * sizeof(unsigned int);
+	}
+
+	makeDirectories(directory);
+	std::ofstream out(getPath(sourcePath), std::ios::binary | std::ios::trunc);
+	if (!out) {
+		std::cout << "ERROR::MESH_CACHE::FILE_NOT_WRITABLE " << getPath(sourcePath) << std::endl;
+		return;
+	}
+	out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	out.write(reinterpret_cast<const char*>(meshRecords.data()), meshRecords.size() * sizeof(MeshRecord));
+	out.write(reinterpret_cast<const char*>(lodRecords.data()), lodRecords.size() * sizeof(LodRecord));
+	out.write(reinterpret_cast<const char*>(textureRecords.data()), textureRecords.size() * sizeof(TextureRecord));
+	out.write(stringTable.data(), stringTable.size());
+	static const char PADDING[BLOB_ALIGNMENT] = {};
+	std::size_t written = static_cast<std::size_t>(out.tellp());
+	for (std::size_t i = 0; i < meshes.size(); i++) {
+		out.write(PADDING, meshRecords[i].vertexOffset - written);
+		out.write(reinterpret_cast<const char*>(meshes[i].vertices.data()), meshes[i].vertices.size() * sizeof(Vertex));
+		written = meshRecords[i].vertexOffset + meshes[i].vertices.size() * sizeof(Vertex);
+		out.write(PADDING, meshRecords[i].indexOffset - written);
+		out.write(reinterpret_cast<const char*>(meshes[i].indices.data()), meshes[i].indices.size() * sizeof(unsigned int));
+		written = meshRecords[i].indexOffset + meshes[i].indices.size() * sizeof(unsigned int);
+	}
+}
+
+std::string MeshCache::getPath(const std::string& sourcePath) {
+	return directory + '/' + toHexString(fnv1a(sourcePath.data(), sourcePath.size())) + ".lmesh";
+}
+
+void MeshCache::setDirectory(const std::string& directory) {
+	MeshCache::directory = directory;
+}
+
+bool MeshCache::validate() const {
+	// every table and blob has to lie inside the file before anything is dereferenced
+	std::uint64_t size = file.size();
+	std::uint64_t tables = sizeof(Header) + std::uint64_t(header->numMeshes) * sizeof(MeshRecord)
+		+ std::uint64_t(header->numLods) * sizeof(LodRecord)
+		+ std::uint64_t(header->numTextureRefs) * sizeof(TextureRecord) + header->stringTableSize;
+	if (tables > size)
+		return false;
+	const MeshRecord* records = reinterpret_cast<const MeshRecord*>(file.data() + sizeof(Header));
+	const LodRecord* lodTable = reinterpret_cast<const LodRecord*>(records + header->numMeshes);
+	const TextureRecord* refs = reinterpret_cast<const TextureRecord*>(lodTable + header->numLods);
+	for (std::uint32_t i = 0; i < header->numMeshes; i++) {
+		const MeshRecord& record = records[i];
+		if (record.vertexOffset % BLOB_ALIGNMENT || record.indexOffset % sizeof(unsigned int)
+			|| record.vertexOffset + std::uint64_t(record.numVertices) * sizeof(Vertex) > size
+			|| record.indexOffset + std::uint64_t(record.numIndices) * sizeof(unsigned int) > size
+			|| std::uint64_t(record.firstTextureRef) + record.numTextureRefs > header->numTextureRefs
+			|| std::uint64_t(record.firstLod) + record.numLods > header->numLods)
+			return false;
+		for (std::uint32_t j = 0; j < record.numLods; j++) {
+			const LodRecord& lod = lodTable[record.firstLod + j];
+			if (std::uint64_t(lod.firstIndex) + lod.numIndices > record.numIndices)
+				return false;
+		}
+	}
+	for (std::uint32_t i = 0; i < header->numTextureRefs; i++)
+		if (refs[i].kind >= NUM_TEXTURE_KINDS || std::uint64_t(refs[i].pathOffset) + refs[i].pathLength > header->stringTableSize)
+			return false;
+	return true;
+}
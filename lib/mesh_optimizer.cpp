@@ -0,0 +1,257 @@
+/**
+ * @file mesh_optimizer.cpp
+ * @brief Import-time reordering of mesh geometry for the post-transform vertex cache
+ * @date October 2026
+ */
+
+#include <learnopengl/mesh_optimizer.h>
+#include <learnopengl/hash.h>
+#include <algorithm>
+#include <cstring>
+
+static const unsigned int NONE = ~0u;
+
+// cache misses of each triangle under a FIFO cache, the way analyze() counts them
+static std::vector<unsigned char> simulateCache(const std::vector<unsigned int>& indices, unsigned int numVertices,
+	unsigned int cacheSize) {
+	std::vector<unsigned char> misses(indices.size() / 3, 0);
+	// a vertex is cached while fewer than cacheSize others entered after it
+	std::vector<unsigned int> cacheTime(numVertices, 0);
+	unsigned int time = cacheSize + 1;
+	for (std::size_t i = 0; i < indices.size(); i++) {
+		unsigned int vertex = indices[i];
+		if (time - cacheTime[vertex] > cacheSize) {
+			cacheTime[vertex] = time++;
+			misses[i / 3]++;
+		}
+	}
+	return misses;
+}
+
+void MeshOptimizer::optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+	if (indices.empty())
+		return;
+	weldVertices(vertices, indices);
+	optimizeVertexCache(indices, vertices.size());
+	optimizeOverdraw(indices, vertices);
+	optimizeVertexFetch(vertices, indices);
+}
+
+MeshOptimizer::Stats MeshOptimizer::analyze(const std::vector<unsigned int>& indices, unsigned int numVertices,
+	unsigned int cacheSize) {
+	Stats stats = { 0.0f, 0.0f };
+	if (indices.empty() || !numVertices)
+		return stats;
+	std::vector<unsigned char> misses = simulateCache(indices, numVertices, cacheSize);
+	unsigned int transformed = 0;
+	for (unsigned char count : misses)
+		transformed += count;
+	stats.acmr = static_cast<float>(transformed) / misses.size();
+	stats.atvr = static_cast<float>(transformed) / numVertices;
+	return stats;
+}
+
+void MeshOptimizer::weldVertices(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+	// open addressing over vertex hashes, slots hold an index into welded plus one
+	std::size_t tableSize = 1;
+	while (tableSize < vertices.size() * 2)
+		tableSize <<= 1;
+	std::vector<unsigned int> table(tableSize, 0);
+	std::vector<unsigned int> remap(vertices.size(), NONE);
+	std::vector<Vertex> welded;
+	welded.reserve(vertices.size());
+	for (unsigned int& index : indices) {
+		if (remap[index] != NONE) {
+			index = remap[index];
+			continue;
+		}
+		const Vertex& vertex = vertices[index];
+		std::size_t slot = fnv1a(reinterpret_cast<const char*>(&vertex), sizeof(Vertex)) & (tableSize - 1);
+		while (table[slot] && std::memcmp(&welded[table[slot] - 1], &vertex, sizeof(Vertex)))
+			slot = (slot + 1) & (tableSize - 1);
+		if (!table[slot]) {
+			welded.push_back(vertex);
+			table[slot] = static_cast<unsigned int>(welded.size());
+		}
+		remap[index] = table[slot] - 1;
+		index = remap[index];
+	}
+	vertices.swap(welded);
+}
+
+void MeshOptimizer::optimizeVertexCache(std::vector<unsigned int>& indices, unsigned int numVertices, unsigned int cacheSize) {
+	std::size_t numTriangles = indices.size() / 3;
+	// triangles around each vertex, adjacency[offsets[v], offsets[v + 1])
+	std::vector<unsigned int> offsets(numVertices + 1, 0);
+	for (unsigned int index : indices)
+		offsets[index + 1]++;
+	for (unsigned int v = 0; v < numVertices; v++)
+		offsets[v + 1] += offsets[v];
+	std::vector<unsigned int> adjacency(numTriangles * 3);
+	std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+	for (std::size_t i = 0; i < numTriangles * 3; i++)
+		adjacency[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+	// triangles not emitted yet around each vertex
+	std::vector<unsigned int> live(numVertices);
+	for (unsigned int v = 0; v < numVertices; v++)
+		live[v] = offsets[v + 1] - offsets[v];
+
+	std::vector<unsigned int> cacheTime(numVertices, 0);
+	std::vector<bool> emitted(numTriangles, false);
+	std::vector<unsigned int> deadEnds;
+	std::vector<unsigned int> candidates;
+	std::vector<unsigned int> result;
+	result.reserve(numTriangles * 3);
+	unsigned int time = cacheSize + 1;
+	unsigned int cursor = 0;
+	unsigned int fanning = numVertices ? 0 : NONE;
+	while (fanning != NONE) {
+		// emit every remaining triangle around the fanning vertex
+		candidates.clear();
+		for (unsigned int k = offsets[fanning]; k < offsets[fanning + 1]; k++) {
+			unsigned int triangle = adjacency[k];
+			if (emitted[triangle])
+				continue;
+			for (unsigned int j = 0; j < 3; j++) {
+				unsigned int vertex = indices[triangle * 3 + j];
+				result.push_back(vertex);
+				deadEnds.push_back(vertex);
+				candidates.push_back(vertex);
+				live[vertex]--;
+				if (time - cacheTime[vertex] > cacheSize)
+					cacheTime[vertex] = time++;
+			}
+			emitted[triangle] = true;
+		}
+		// prefer the oldest candidate that stays cached while its own fan is emitted
+		fanning = NONE;
+		unsigned int bestPriority = 0;
+		for (unsigned int vertex : candidates) {
+			if (!live[vertex])
+				continue;
+			unsigned int priority = 0;
+			if (time - cacheTime[vertex] + 2 * live[vertex] <= cacheSize)
+				priority = time - cacheTime[vertex];
+			if (fanning == NONE || priority > bestPriority) {
+				fanning = vertex;
+				bestPriority = priority;
+			}
+		}
+		if (fanning != NONE)
+			continue;
+		// dead end, go back to the most recent vertex with triangles left
+		while (!deadEnds.empty() && fanning == NONE) {
+			if (live[deadEnds.back()])
+				fanning = deadEnds.back();
+			deadEnds.pop_back();
+		}
+		// otherwise move on to the next disconnected part
+		while (fanning == NONE && cursor < numVertices) {
+			if (live[cursor])
+				fanning = cursor;
+			cursor++;
+		}
+	}
+	indices.swap(result);
+}
+
+void MeshOptimizer::optimizeOverdraw(std::vector<unsigned int>& indices, const std::vector<Vertex>& vertices,
+	float threshold, unsigned int cacheSize) {
+	std::size_t numTriangles = indices.size() / 3;
+	if (!numTriangles)
+		return;
+	std::vector<unsigned char> misses = simulateCache(indices, vertices.size(), cacheSize);
+	// a triangle missing on every vertex starts over in a cold cache, so it can start a cluster for free
+	std::vector<std::size_t> hardStarts;
+	for (std::size_t t = 0; t < numTriangles; t++) {
+		if (!t || misses[t] == 3)
+			hardStarts.push_back(t);
+	}
+	hardStarts.push_back(numTriangles);
+	// split further wherever the cluster so far, starting from a cold cache, is within threshold of the
+	// whole cluster's ACMR; every cluster then stays efficient in any order
+	std::vector<std::size_t> starts;
+	std::vector<unsigned int> cacheTime(vertices.size(), 0);
+	unsigned int time = cacheSize + 1;
+	for (std::size_t c = 0; c + 1 < hardStarts.size(); c++) {
+		unsigned int clusterMisses = 0;
+		for (std::size_t t = hardStarts[c]; t < hardStarts[c + 1]; t++)
+			clusterMisses += misses[t];
+		float limit = threshold * clusterMisses / (hardStarts[c + 1] - hardStarts[c]);
+		starts.push_back(hardStarts[c]);
+		unsigned int runMisses = 0;
+		std::size_t runStart = hardStarts[c];
+		// each run starts with a cold cache
+		time += cacheSize + 1;
+		for (std::size_t t = hardStarts[c]; t + 1 < hardStarts[c + 1]; t++) {
+			for (unsigned int j = 0; j < 3; j++) {
+				unsigned int vertex = indices[t * 3 + j];
+				if (time - cacheTime[vertex] > cacheSize) {
+					cacheTime[vertex] = time++;
+					runMisses++;
+				}
+			}
+			if (runMisses <= limit * (t + 1 - runStart)) {
+				starts.push_back(t + 1);
+				runMisses = 0;
+				runStart = t + 1;
+				time += cacheSize + 1;
+			}
+		}
+	}
+	starts.push_back(numTriangles);
+
+	// area-weighted centroid and normal of each cluster
+	std::size_t numClusters = starts.size() - 1;
+	std::vector<glm::vec3> centroids(numClusters, glm::vec3(0.0f));
+	std::vector<glm::vec3> normals(numClusters, glm::vec3(0.0f));
+	glm::vec3 meshCentroid(0.0f);
+	float meshArea = 0.0f;
+	for (std::size_t c = 0; c < numClusters; c++) {
+		float area = 0.0f;
+		for (std::size_t t = starts[c]; t < starts[c + 1]; t++) {
+			const glm::vec3& p0 = vertices[indices[t * 3]].position;
+			const glm::vec3& p1 = vertices[indices[t * 3 + 1]].position;
+			const glm::vec3& p2 = vertices[indices[t * 3 + 2]].position;
+			glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+			float triangleArea = glm::length(normal);
+			centroids[c] += (p0 + p1 + p2) * (triangleArea / 3.0f);
+			normals[c] += normal;
+			area += triangleArea;
+		}
+		meshCentroid += centroids[c];
+		meshArea += area;
+		if (area > 0.0f)
+			centroids[c] /= area;
+	}
+	if (meshArea > 0.0f)
+		meshCentroid /= meshArea;
+	// clusters facing away from the center occlude the rest, draw them first
+	std::vector<float> keys(numClusters);
+	std::vector<unsigned int> order(numClusters);
+	for (std::size_t c = 0; c < numClusters; c++) {
+		float length = glm::length(normals[c]);
+		keys[c] = length > 0.0f ? glm::dot(centroids[c] - meshCentroid, normals[c] / length) : 0.0f;
+		order[c] = static_cast<unsigned int>(c);
+	}
+	std::stable_sort(order.begin(), order.end(), [&keys](unsigned int a, unsigned int b) { return keys[a] > keys[b]; });
+	std::vector<unsigned int> result;
+	result.reserve(indices.size());
+	for (unsigned int c : order)
+		result.insert(result.end(), indices.begin() + starts[c] * 3, indices.begin() + starts[c + 1] * 3);
+	indices.swap(result);
+}
+
+void MeshOptimizer::optimizeVertexFetch(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+	std::vector<unsigned int> remap(vertices.size(), NONE);
+	std::vector<Vertex> ordered;
+	ordered.reserve(vertices.size());
+	for (unsigned int& index : indices) {
+		if (remap[index] == NONE) {
+			remap[index] = static_cast<unsigned int>(ordered.size());
+			ordered.push_back(vertices[index]);
+		}
+		index = remap[index];
+	}
+	vertices.swap(ordered);
+}
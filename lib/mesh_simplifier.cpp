@@ -0,0 +1,278 @@
+/**
+ * @file mesh_simplifier.cpp
+ * @brief Quadric error edge-collapse simplification for mesh LODs
+ * @date October 2026
+ */
+
+#include <learnopengl/mesh_simplifier.h>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_set>
+
+namespace {
+
+enum VertexKind {
+	// interior vertex, may collapse onto any neighbor
+	MANIFOLD,
+	// on an open border, may only collapse along it
+	BORDER,
+	// on a seam or a border corner, never moves
+	LOCKED
+};
+
+// sum of squared distances to a set of planes, weighted by area; doubles since the terms cancel heavily
+struct Quadric {
+	double a00, a11, a22, a10, a20, a21;
+	double b0, b1, b2;
+	double c;
+	double weight;
+};
+
+struct Collapse {
+	unsigned int from, to;
+	double cost;
+};
+
+Quadric planeQuadric(const glm::vec3& normal, const glm::vec3& point, double weight) {
+	glm::dvec3 n(normal);
+	double d = -glm::dot(n, glm::dvec3(point));
+	Quadric q;
+	q.a00 = weight * n.x * n.x;
+	q.a11 = weight * n.y * n.y;
+	q.a22 = weight * n.z * n.z;
+	q.a10 = weight * n.y * n.x;
+	q.a20 = weight * n.z * n.x;
+	q.a21 = weight * n.z * n.y;
+	q.b0 = weight * n.x * d;
+	q.b1 = weight * n.y * d;
+	q.b2 = weight * n.z * d;
+	q.c = weight * d * d;
+	q.weight = weight;
+	return q;
+}
+
+void add(Quadric& q, const Quadric& other) {
+	q.a00 += other.a00;
+	q.a11 += other.a11;
+	q.a22 += other.a22;
+	q.a10 += other.a10;
+	q.a20 += other.a20;
+	q.a21 += other.a21;
+	q.b0 += other.b0;
+	q.b1 += other.b1;
+	q.b2 += other.b2;
+	q.c += other.c;
+	q.weight += other.weight;
+}
+
+// squared distance, averaged over the planes by weight
+double evaluate(const Quadric& q, const glm::vec3& point) {
+	glm::dvec3 p(point);
+	double rx = q.a00 * p.x + q.a10 * p.y + q.a20 * p.z;
+	double ry = q.a10 * p.x + q.a11 * p.y + q.a21 * p.z;
+	double rz = q.a20 * p.x + q.a21 * p.y + q.a22 * p.z;
+	double error = p.x * rx + p.y * ry + p.z * rz + 2.0 * (q.b0 * p.x + q.b1 * p.y + q.b2 * p.z) + q.c;
+	return q.weight > 0.0 ? std::abs(error) / q.weight : 0.0;
+}
+
+std::uint64_t edgeKey(unsigned int a, unsigned int b) {
+	return static_cast<std::uint64_t>(a) << 32 | b;
+}
+
+// vertex id shared by every vertex at the same position
+std::vector<unsigned int> findPositionIds(const std::vector<Vertex>& vertices) {
+	std::vector<unsigned int> order(vertices.size());
+	for (unsigned int i = 0; i < order.size(); i++)
+		order[i] = i;
+	std::sort(order.begin(), order.end(), [&vertices](unsigned int a, unsigned int b) {
+		const glm::vec3& p = vertices[a].position;
+		const glm::vec3& q = vertices[b].position;
+		return p.x != q.x ? p.x < q.x : p.y != q.y ? p.y < q.y : p.z < q.z;
+	});
+	std::vector<unsigned int> ids(vertices.size());
+	for (std::size_t i = 0; i < order.size(); i++) {
+		bool same = i && vertices[order[i]].position == vertices[order[i - 1]].position;
+		ids[order[i]] = same ? ids[order[i - 1]] : order[i];
+	}
+	return ids;
+}
+
+}
+
+std::vector<unsigned int> MeshSimplifier::simplify(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices,
+	std::size_t targetIndexCount, float* error) {
+	std::vector<unsigned int> result(indices);
+	if (error)
+		*error = 0.0f;
+	if (result.size() <= targetIndexCount)
+		return result;
+	std::size_t numVertices = vertices.size();
+
+	// a position with several vertices is an attribute seam
+	std::vector<unsigned int> positionIds = findPositionIds(vertices);
+	std::vector<unsigned int> positionUses(numVertices, 0);
+	for (unsigned int id : positionIds)
+		positionUses[id]++;
+	// an edge without a twin in the opposite direction lies on an open border
+	std::unordered_set<std::uint64_t> edges;
+	for (std::size_t i = 0; i < result.size(); i += 3)
+		for (unsigned int j = 0; j < 3; j++)
+			edges.insert(edgeKey(positionIds[result[i + j]], positionIds[result[i + (j + 1) % 3]]));
+	std::unordered_set<std::uint64_t> borderEdges;
+	std::vector<unsigned int> borderCount(numVertices, 0);
+	for (std::size_t i = 0; i < result.size(); i += 3) {
+		for (unsigned int j = 0; j < 3; j++) {
+			unsigned int a = result[i + j];
+			unsigned int b = result[i + (j + 1) % 3];
+			if (edges.count(edgeKey(positionIds[b], positionIds[a])))
+				continue;
+			borderEdges.insert(edgeKey(a, b));
+			borderCount[a]++;
+			borderCount[b]++;
+		}
+	}
+	std::vector<VertexKind> kinds(numVertices, MANIFOLD);
+	for (std::size_t v = 0; v < numVertices; v++) {
+		if (positionUses[positionIds[v]] > 1 || (borderCount[v] && borderCount[v] != 2))
+			kinds[v] = LOCKED;
+		else if (borderCount[v])
+			kinds[v] = BORDER;
+	}
+
+	// planes of the surrounding triangles, plus planes standing on border edges to keep the outline
+	Quadric zero = {};
+	std::vector<Quadric> quadrics(numVertices, zero);
+	for (std::size_t i = 0; i < result.size(); i += 3) {
+		const glm::vec3& p0 = vertices[result[i]].position;
+		glm::vec3 normal = glm::cross(vertices[result[i + 1]].position - p0, vertices[result[i + 2]].position - p0);
+		float length = glm::length(normal);
+		if (length == 0.0f)
+			continue;
+		normal /= length;
+		Quadric q = planeQuadric(normal, p0, 0.5 * length);
+		for (unsigned int j = 0; j < 3; j++) {
+			add(quadrics[result[i + j]], q);
+			unsigned int a = result[i + j];
+			unsigned int b = result[i + (j + 1) % 3];
+			if (!borderEdges.count(edgeKey(a, b)))
+				continue;
+			glm::vec3 edge = vertices[b].position - vertices[a].position;
+			glm::vec3 side = glm::cross(edge, normal);
+			float sideLength = glm::length(side);
+			if (sideLength == 0.0f)
+				continue;
+			Quadric border = planeQuadric(side / sideLength, vertices[a].position, glm::dot(edge, edge));
+			add(quadrics[a], border);
+			add(quadrics[b], border);
+		}
+	}
+
+	double maxCost = 0.0;
+	std::vector<Collapse> collapses;
+	std::vector<unsigned int> offsets(numVertices + 1);
+	std::vector<unsigned int> adjacency;
+	std::vector<unsigned int> remap(numVertices);
+	std::vector<bool> touched(numVertices);
+	// every pass collapses a set of independent edges, cheapest first
+	while (result.size() > targetIndexCount) {
+		std::fill(offsets.begin(), offsets.end(), 0);
+		for (unsigned int index : result)
+			offsets[index + 1]++;
+		for (std::size_t v = 0; v < numVertices; v++)
+			offsets[v + 1] += offsets[v];
+		adjacency.resize(result.size());
+		std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+		for (std::size_t i = 0; i < result.size(); i++)
+			adjacency[fill[result[i]]++] = static_cast<unsigned int>(i / 3);
+
+		collapses.clear();
+		for (std::size_t i = 0; i < result.size(); i += 3) {
+			for (unsigned int j = 0; j < 3; j++) {
+				unsigned int a = result[i + j];
+				unsigned int b = result[i + (j + 1) % 3];
+				bool alongBorder = borderEdges.count(edgeKey(a, b)) || borderEdges.count(edgeKey(b, a));
+				Quadric q = quadrics[a];
+				add(q, quadrics[b]);
+				Collapse best = { 0, 0, -1.0 };
+				if (kinds[a] == MANIFOLD || (kinds[a] == BORDER && alongBorder)) {
+					Collapse collapse = { a, b, evaluate(q, vertices[b].position) };
+					best = collapse;
+				}
+				if (kinds[b] == MANIFOLD || (kinds[b] == BORDER && alongBorder)) {
+					Collapse collapse = { b, a, evaluate(q, vertices[a].position) };
+					if (best.cost < 0.0 || collapse.cost < best.cost)
+						best = collapse;
+				}
+				if (best.cost >= 0.0)
+					collapses.push_back(best);
+			}
+		}
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& a, const Collapse& b) { return a.cost < b.cost; });
+
+		for (std::size_t v = 0; v < numVertices; v++)
+			remap[v] = static_cast<unsigned int>(v);
+		std::fill(touched.begin(), touched.end(), false);
+		std::size_t trianglesToRemove = (result.size() - targetIndexCount + 2) / 3;
+		std::size_t removed = 0;
+		for (const Collapse& collapse : collapses) {
+			if (removed >= trianglesToRemove)
+				break;
+			if (touched[collapse.from] || touched[collapse.to])
+				continue;
+			// moving from onto to must not turn any of its other triangles over
+			const glm::vec3& target = vertices[collapse.to].position;
+			bool flips = false;
+			for (unsigned int k = offsets[collapse.from]; k < offsets[collapse.from + 1] && !flips; k++) {
+				const unsigned int* triangle = &result[adjacency[k] * 3];
+				if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+					continue;
+				glm::vec3 p[3], moved[3];
+				for (unsigned int j = 0; j < 3; j++) {
+					p[j] = vertices[triangle[j]].position;
+					moved[j] = triangle[j] == collapse.from ? target : p[j];
+				}
+				glm::vec3 before = glm::cross(p[1] - p[0], p[2] - p[0]);
+				glm::vec3 after = glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+				flips = glm::dot(before, after) <= 0.0f;
+			}
+			if (flips)
+				continue;
+			remap[collapse.from] = collapse.to;
+			add(quadrics[collapse.to], quadrics[collapse.from]);
+			maxCost = std::max(maxCost, collapse.cost);
+			// the triangles around from change shape, so its neighbors wait for the next pass
+			for (unsigned int k = offsets[collapse.from]; k < offsets[collapse.from + 1]; k++)
+				for (unsigned int j = 0; j < 3; j++)
+					touched[result[adjacency[k] * 3 + j]] = true;
+			removed += kinds[collapse.from] == BORDER ? 1 : 2;
+		}
+		if (!removed)
+			break;
+		// border collapses shorten the border, its edges now end at the surviving vertices
+		std::unordered_set<std::uint64_t> remappedEdges;
+		for (std::uint64_t key : borderEdges) {
+			unsigned int a = remap[static_cast<unsigned int>(key >> 32)];
+			unsigned int b = remap[static_cast<unsigned int>(key)];
+			if (a != b)
+				remappedEdges.insert(edgeKey(a, b));
+		}
+		borderEdges.swap(remappedEdges);
+
+		std::size_t count = 0;
+		for (std::size_t i = 0; i < result.size(); i += 3) {
+			unsigned int a = remap[result[i]];
+			unsigned int b = remap[result[i + 1]];
+			unsigned int c = remap[result[i + 2]];
+			if (a == b || b == c || c == a)
+				continue;
+			result[count++] = a;
+			result[count++] = b;
+			result[count++] = c;
+		}
+		result.resize(count);
+	}
+	if (error)
+		*error = static_cast<float>(std::sqrt(maxCost));
+	return result;
+}
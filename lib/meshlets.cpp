@@ -0,0 +1,176 @@
+/**
+ * @file meshlets.cpp
+ * @brief Small triangle clusters of a mesh with per-cluster culling
+ * @date October 2026
+ */
+
+#include <learnopengl/meshlets.h>
+#include <learnopengl/mesh.h>
+#include <learnopengl/frustum.h>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MESHLETS_SSE
+#include <emmintrin.h>
+#endif
+
+// cones this wide have some triangle facing every direction that matters, never cull them
+static const float MIN_CONE_DOT = 0.1f;
+
+void Meshlets::build(const Vertex* vertices, unsigned int numVertices, const unsigned int* indices, unsigned int firstIndex,
+	unsigned int numIndices) {
+	firstIndices.clear();
+	this->numIndices.clear();
+	for (std::vector<float>* array : { &centerX, &centerY, &centerZ, &radius, &axisX, &axisY, &axisZ, &cutoff })
+		array->clear();
+	// meshlet each vertex was last added to, so unique vertices are counted without clearing a set
+	std::vector<unsigned int> owner(numVertices, ~0u);
+	unsigned int meshlet = 0;
+	unsigned int meshletFirst = firstIndex;
+	unsigned int meshletVertices = 0;
+	// vertices of the triangle at i not in the current meshlet yet
+	auto countNew = [&](unsigned int i) {
+		unsigned int added = 0;
+		for (unsigned int j = 0; j < 3; j++) {
+			unsigned int vertex = indices[i + j];
+			bool seen = owner[vertex] == meshlet;
+			for (unsigned int k = 0; k < j; k++)
+				seen = seen || indices[i + k] == vertex;
+			added += !seen;
+		}
+		return added;
+	};
+	for (unsigned int i = firstIndex; i < firstIndex + numIndices; i += 3) {
+		unsigned int added = countNew(i);
+		if (meshletVertices + added > MAX_VERTICES || i - meshletFirst == MAX_TRIANGLES * 3) {
+			addMeshlet(vertices, indices, meshletFirst, i - meshletFirst);
+			meshlet++;
+			meshletFirst = i;
+			meshletVertices = 0;
+			added = countNew(i);
+		}
+		for (unsigned int j = 0; j < 3; j++)
+			owner[indices[i + j]] = meshlet;
+		meshletVertices += added;
+	}
+	if (meshletFirst < firstIndex + numIndices)
+		addMeshlet(vertices, indices, meshletFirst, firstIndex + numIndices - meshletFirst);
+	std::size_t padded = (firstIndices.size() + 3) & ~std::size_t(3);
+	for (std::vector<float>* array : { &centerX, &centerY, &centerZ, &radius, &axisX, &axisY, &axisZ, &cutoff })
+		array->resize(padded, 0.0f);
+}
+
+unsigned int Meshlets::getNumMeshlets() const {
+	return static_cast<unsigned int>(firstIndices.size());
+}
+
+void Meshlets::cull(const glm::mat4& modelViewProjection, const glm::vec3& cameraPosition, bool cullBackfaces,
+	std::vector<unsigned int>& rangeStarts, std::vector<GLsizei>& rangeCounts) const {
+	rangeStarts.clear();
+	rangeCounts.clear();
+	// object-space planes, since the clip matrix includes the model matrix
+	Frustum frustum = Frustum::fromMatrix(modelViewProjection);
+
+	unsigned int numMeshlets = getNumMeshlets();
+	for (unsigned int block = 0; block < numMeshlets; block += 4) {
+		unsigned int mask;
+#ifdef MESHLETS_SSE
+		__m128 x = _mm_loadu_ps(&centerX[block]);
+		__m128 y = _mm_loadu_ps(&centerY[block]);
+		__m128 z = _mm_loadu_ps(&centerZ[block]);
+		__m128 r = _mm_loadu_ps(&radius[block]);
+		__m128 negativeR = _mm_sub_ps(_mm_setzero_ps(), r);
+		__m128 visible = _mm_castsi128_ps(_mm_set1_epi32(-1));
+		for (const glm::vec4& plane : frustum.planes) {
+			__m128 distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, _mm_set1_ps(plane.x)), _mm_mul_ps(y, _mm_set1_ps(plane.y))),
+				_mm_add_ps(_mm_mul_ps(z, _mm_set1_ps(plane.z)), _mm_set1_ps(plane.w)));
+			visible = _mm_and_ps(visible, _mm_cmpge_ps(distance, negativeR));
+		}
+		if (cullBackfaces) {
+			// every triangle faces away when the view direction lies far enough inside the cone
+			__m128 vx = _mm_sub_ps(x, _mm_set1_ps(cameraPosition.x));
+			__m128 vy = _mm_sub_ps(y, _mm_set1_ps(cameraPosition.y));
+			__m128 vz = _mm_sub_ps(z, _mm_set1_ps(cameraPosition.z));
+			__m128 along = _mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, _mm_loadu_ps(&axisX[block])), _mm_mul_ps(vy, _mm_loadu_ps(&axisY[block]))),
+				_mm_mul_ps(vz, _mm_loadu_ps(&axisZ[block])));
+			__m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(vx, vx), _mm_mul_ps(vy, vy)), _mm_mul_ps(vz, vz)));
+			__m128 limit = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&cutoff[block]), distance), r);
+			visible = _mm_andnot_ps(_mm_cmpge_ps(along, limit), visible);
+		}
+		mask = static_cast<unsigned int>(_mm_movemask_ps(visible));
+#else
+		mask = 0;
+		for (unsigned int lane = 0; lane < 4; lane++) {
+			unsigned int i = block + lane;
+			glm::vec3 center(centerX[i], centerY[i], centerZ[i]);
+			bool visible = true;
+			for (const glm::vec4& plane : frustum.planes)
+				visible = visible && glm::dot(glm::vec3(plane), center) + plane.w >= -radius[i];
+			if (visible && cullBackfaces) {
+				glm::vec3 view = center - cameraPosition;
+				visible = glm::dot(view, glm::vec3(axisX[i], axisY[i], axisZ[i])) < cutoff[i] * glm::length(view) + radius[i];
+			}
+			mask |= static_cast<unsigned int>(visible) << lane;
+		}
+#endif
+		// padding lanes past the last meshlet
+		if (numMeshlets - block < 4)
+			mask &= (1u << (numMeshlets - block)) - 1;
+		for (; mask; mask &= mask - 1) {
+			unsigned int i = block;
+			for (unsigned int bit = mask; !(bit & 1); bit >>= 1)
+				i++;
+			// meshlets are consecutive in the index buffer, so visible neighbors extend one range
+			if (!rangeCounts.empty() && rangeStarts.back() + rangeCounts.back() == firstIndices[i])
+				rangeCounts.back() += numIndices[i];
+			else {
+				rangeStarts.push_back(firstIndices[i]);
+				rangeCounts.push_back(numIndices[i]);
+			}
+		}
+	}
+}
+
+void Meshlets::addMeshlet(const Vertex* vertices, const unsigned int* indices, unsigned int first, unsigned int count) {
+	firstIndices.push_back(first);
+	numIndices.push_back(count);
+	glm::vec3 boundsMin = vertices[indices[first]].position;
+	glm::vec3 boundsMax = boundsMin;
+	glm::vec3 normalSum(0.0f);
+	for (unsigned int i = first; i < first + count; i += 3) {
+		const glm::vec3& p0 = vertices[indices[i]].position;
+		const glm::vec3& p1 = vertices[indices[i + 1]].position;
+		const glm::vec3& p2 = vertices[indices[i + 2]].position;
+		boundsMin = glm::min(boundsMin, glm::min(p0, glm::min(p1, p2)));
+		boundsMax = glm::max(boundsMax, glm::max(p0, glm::max(p1, p2)));
+		glm::vec3 normal = glm::cross(p1 - p0, p2 - p0);
+		float length = glm::length(normal);
+		if (length > 0.0f)
+			normalSum += normal / length;
+	}
+	glm::vec3 center = 0.5f * (boundsMin + boundsMax);
+	float sphereRadius = 0.0f;
+	for (unsigned int i = first; i < first + count; i++)
+		sphereRadius = std::max(sphereRadius, glm::length(vertices[indices[i]].position - center));
+	// the cone has to hold the normal farthest from the average
+	float sumLength = glm::length(normalSum);
+	glm::vec3 axis = sumLength > 0.0f ? normalSum / sumLength : glm::vec3(0.0f);
+	float minDot = sumLength > 0.0f ? 1.0f : -1.0f;
+	for (unsigned int i = first; i < first + count; i += 3) {
+		const glm::vec3& p0 = vertices[indices[i]].position;
+		glm::vec3 normal = glm::cross(vertices[indices[i + 1]].position - p0, vertices[indices[i + 2]].position - p0);
+		float length = glm::length(normal);
+		if (length > 0.0f)
+			minDot = std::min(minDot, glm::dot(normal / length, axis));
+	}
+	centerX.push_back(center.x);
+	centerY.push_back(center.y);
+	centerZ.push_back(center.z);
+	radius.push_back(sphereRadius);
+	axisX.push_back(axis.x);
+	axisY.push_back(axis.y);
+	axisZ.push_back(axis.z);
+	// sine of the cone's half angle; a cutoff of 1 never culls, the view vector cannot beat its own length plus the radius
+	cutoff.push_back(minDot > MIN_CONE_DOT ? std::sqrt(1.0f - minDot * minDot) : 1.0f);
+}
@@ -0,0 +1,221 @@
+/**
+ * @file mip_generator.cpp
+ * @brief Mip chains built on the CPU with SIMD filters
+ * @date October 2026
+ */
+
+#include <learnopengl/mip_generator.h>
+#include <learnopengl/parallel.h>
+#include <algorithm>
+#include <cmath>
+
+#if defined(__AVX__)
+#define MIP_AVX
+#include <immintrin.h>
+#endif
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MIP_SSE
+#include <emmintrin.h>
+#endif
+
+namespace {
+
+const int MAX_TAPS = 6;
+// decoded source rows kept per band, more than the taps of one output row
+const int RING_ROWS = 8;
+
+// source taps of destination texel x start at 2x + first
+struct Kernel {
+	int first, count;
+	float weights[MAX_TAPS];
+};
+
+double besselI0(double x) {
+	double sum = 1.0, term = 1.0;
+	for (int k = 1; k < 32; k++) {
+		term *= (x / (2.0 * k)) * (x / (2.0 * k));
+		sum += term;
+	}
+	return sum;
+}
+
+Kernel getKernel(MipFilter filter) {
+	Kernel kernel;
+	if (filter == MipFilter::BOX) {
+		kernel.first = 0;
+		kernel.count = 2;
+		kernel.weights[0] = kernel.weights[1] = 0.5f;
+		return kernel;
+	}
+	// sinc windowed over 3 destination texels, distances measured in destination texels between centers
+	const double ALPHA = 4.0;
+	const double RADIUS = 1.5;
+	const double PI = 3.14159265358979323846;
+	kernel.first = -2;
+	kernel.count = 6;
+	double weights[MAX_TAPS];
+	double sum = 0.0;
+	for (int i = 0; i < kernel.count; i++) {
+		double distance = (kernel.first + i - 0.5) / 2.0;
+		double ratio = distance / RADIUS;
+		double window = besselI0(ALPHA * std::sqrt(std::max(1.0 - ratio * ratio, 0.0))) / besselI0(ALPHA);
+		weights[i] = std::sin(PI * distance) / (PI * distance) * window;
+		sum += weights[i];
+	}
+	for (int i = 0; i < kernel.count; i++)
+		kernel.weights[i] = static_cast<float>(weights[i] / sum);
+	return kernel;
+}
+
+struct Tables {
+	// [srgb][value]
+	float decode[2][256];
+	// linear intensity in 1/65535 steps to sRGB
+	unsigned char encode[65536];
+	Tables() {
+		for (int i = 0; i < 256; i++) {
+			float value = i / 255.0f;
+			decode[0][i] = value;
+			decode[1][i] = value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+		}
+		for (int i = 0; i < 65536; i++) {
+			float value = i / 65535.0f;
+			value = value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+			encode[i] = static_cast<unsigned char>(value * 255.0f + 0.5f);
+		}
+	}
+};
+
+const Tables& getTables() {
+	static const Tables tables;
+	return tables;
+}
+
+// the channel holding alpha, which is never sRGB encoded
+int getAlphaChannel(int components) {
+	return components == 4 ? 3 : components == 2 ? 1 : -1;
+}
+
+// expand to float RGBA, unused channels 0
+void decodeRow(const unsigned char* row, int width, int components, bool srgb, float* out) {
+	const Tables& tables = getTables();
+	int alpha = getAlphaChannel(components);
+	for (int x = 0; x < width; x++) {
+		for (int c = 0; c < 4; c++)
+			out[x * 4 + c] = c < components ? tables.decode[srgb && c != alpha][row[x * components + c]] : 0.0f;
+	}
+}
+
+void encodeRow(const float* row, int width, int components, bool srgb, unsigned char* out) {
+	const Tables& tables = getTables();
+	int alpha = getAlphaChannel(components);
+	for (int x = 0; x < width; x++) {
+		for (int c = 0; c < components; c++) {
+			// the Kaiser filter's negative lobes overshoot
+			float value = std::min(std::max(row[x * 4 + c], 0.0f), 1.0f);
+			out[x * components + c] = srgb && c != alpha ? tables.encode[static_cast<int>(value * 65535.0f + 0.5f)]
+				: static_cast<unsigned char>(value * 255.0f + 0.5f);
+		}
+	}
+}
+
+// weighted sum of whole rows, size floats each
+void filterVertical(const float* const* rows, const Kernel& kernel, int size, float* out) {
+	int i = 0;
+#ifdef MIP_AVX
+	for (; i + 8 <= size; i += 8) {
+		__m256 sum = _mm256_setzero_ps();
+		for (int t = 0; t < kernel.count; t++)
+			sum = _mm256_add_ps(sum, _mm256_mul_ps(_mm256_loadu_ps(rows[t] + i), _mm256_set1_ps(kernel.weights[t])));
+		_mm256_storeu_ps(out + i, sum);
+	}
+#endif
+#ifdef MIP_SSE
+	for (; i + 4 <= size; i += 4) {
+		__m128 sum = _mm_setzero_ps();
+		for (int t = 0; t < kernel.count; t++)
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(rows[t] + i), _mm_set1_ps(kernel.weights[t])));
+		_mm_storeu_ps(out + i, sum);
+	}
+#endif
+	for (; i < size; i++) {
+		float sum = 0.0f;
+		for (int t = 0; t < kernel.count; t++)
+			sum += rows[t][i] * kernel.weights[t];
+		out[i] = sum;
+	}
+}
+
+// one RGBA pixel is one SSE register
+void filterHorizontal(const float* row, int width, const Kernel& kernel, int outWidth, float* out) {
+	for (int x = 0; x < outWidth; x++) {
+		int first = 2 * x + kernel.first;
+#ifdef MIP_SSE
+		__m128 sum = _mm_setzero_ps();
+		for (int t = 0; t < kernel.count; t++) {
+			int source = std::min(std::max(first + t, 0), width - 1);
+			sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(row + source * 4), _mm_set1_ps(kernel.weights[t])));
+		}
+		_mm_storeu_ps(out + x * 4, sum);
+#else
+		for (int c = 0; c < 4; c++) {
+			float sum = 0.0f;
+			for (int t = 0; t < kernel.count; t++) {
+				int source = std::min(std::max(first + t, 0), width - 1);
+				sum += row[source * 4 + c] * kernel.weights[t];
+			}
+			out[x * 4 + c] = sum;
+		}
+#endif
+	}
+}
+
+}
+
+std::vector<unsigned char> MipGenerator::downsample(const unsigned char* pixels, int width, int height, int components, bool srgb,
+	MipFilter filter) {
+	int outWidth = std::max(width / 2, 1);
+	int outHeight = std::max(height / 2, 1);
+	std::vector<unsigned char> out(static_cast<std::size_t>(outWidth) * outHeight * components);
+	Kernel kernel = getKernel(filter);
+	std::size_t rowSize = static_cast<std::size_t>(width) * 4;
+	std::size_t bands = (outHeight + BAND_ROWS - 1) / BAND_ROWS;
+	parallelFor(bands, [&](std::size_t band) {
+		// neighboring output rows share most taps, so decoded rows are kept in a ring indexed by row
+		std::vector<float> decoded(RING_ROWS * rowSize);
+		int ringRows[RING_ROWS];
+		std::fill(ringRows, ringRows + RING_ROWS, -1);
+		std::vector<float> vertical(rowSize);
+		std::vector<float> horizontal(static_cast<std::size_t>(outWidth) * 4);
+		const float* rows[MAX_TAPS];
+		int last = std::min(static_cast<int>(band + 1) * BAND_ROWS, outHeight);
+		for (int y = static_cast<int>(band) * BAND_ROWS; y < last; y++) {
+			for (int t = 0; t < kernel.count; t++) {
+				// taps past the edges repeat the border row, which also keeps a single row unfiltered
+				int source = std::min(std::max(2 * y + kernel.first + t, 0), height - 1);
+				int slot = source % RING_ROWS;
+				if (ringRows[slot] != source) {
+					decodeRow(pixels + static_cast<std::size_t>(source) * width * components, width, components, srgb,
+						&decoded[slot * rowSize]);
+					ringRows[slot] = source;
+				}
+				rows[t] = &decoded[slot * rowSize];
+			}
+			filterVertical(rows, kernel, static_cast<int>(rowSize), vertical.data());
+			filterHorizontal(vertical.data(), width, kernel, outWidth, horizontal.data());
+			encodeRow(horizontal.data(), outWidth, components, srgb, &out[static_cast<std::size_t>(y) * outWidth * components]);
+		}
+	});
+	return out;
+}
+
+std::vector<std::vector<unsigned char>> MipGenerator::generate(const unsigned char* pixels, int width, int height, int components,
+	bool srgb, MipFilter filter) {
+	std::vector<std::vector<unsigned char>> levels;
+	while (width > 1 || height > 1) {
+		levels.push_back(downsample(levels.empty() ? pixels : levels.back().data(), width, height, components, srgb, filter));
+		width = std::max(width / 2, 1);
+		height = std::max(height / 2, 1);
+	}
+	return levels;
+}
@@ -6,56 +6,252 @@
  */
 
 #include <learnopengl/model.h>
+#include <learnopengl/file_system.h>
+#include <learnopengl/gl_state.h>
+#include <learnopengl/hash.h>
+#include <learnopengl/mesh_cache.h>
+#include <learnopengl/parallel.h>
+#include <learnopengl/texture_cache.h>
+#include <algorithm>
+#include <limits>
 
-Model::Model(const char* path) {
+Model::Model(const char* path, bool flipTextures, const VertexFormat& vertexFormat)
+	: flipTextures(flipTextures), vertexFormat(vertexFormat), boundsCenter(0.0f), boundsRadius(0.0f), instances(GL_ARRAY_BUFFER) {
 	loadModel(path);
+	computeLodErrors();
 }
 
-void Model::draw(Shader& shader) {
+void Model::draw(Shader& shader, unsigned int lod) {
 	for (unsigned int i = 0; i < meshes.size(); i++)
-		meshes[i].draw(shader);
+		meshes[i].draw(shader, lod);
+}
+
+void Model::draw(Shader& shader, const glm::mat4& model, const Frustum& frustum, unsigned int lod) {
+	// testing object-space bounds against a transformed frustum leaves the bounds untouched
+	Frustum objectFrustum = frustum.transformed(model);
+	meshBoxes.cull(objectFrustum, visibleMeshes);
+	for (unsigned int i : visibleMeshes)
+		meshes[i].draw(shader, lod);
+}
+
+void Model::drawInstanced(Shader& shader, const glm::mat4* matrices, std::size_t count, unsigned int lod) {
+	if (!count)
+		return;
+	std::size_t offset = instances.write(matrices, count * sizeof(glm::mat4));
+	GLuint vao = 0;
+	for (Mesh& mesh : meshes) {
+		if (mesh.getVAO() != vao) {
+			vao = mesh.getVAO();
+			GLState::bindVertexArray(vao);
+			if (std::find(instancedVAOs.begin(), instancedVAOs.end(), vao) == instancedVAOs.end()) {
+				for (GLuint column = 0; column < 4; column++) {
+					glEnableVertexAttribArray(INSTANCE_MATRIX_LOCATION + column);
+					glVertexAttribDivisor(INSTANCE_MATRIX_LOCATION + column, 1);
+				}
+				instancedVAOs.push_back(vao);
+			}
+			// the offset moves every call, and other models may have pointed the shared arrays at their own buffers;
+			// a mat4 takes four vec4 attributes
+			GLState::bindBuffer(GL_ARRAY_BUFFER, instances.getBuffer());
+			for (GLuint column = 0; column < 4; column++)
+				glVertexAttribPointer(INSTANCE_MATRIX_LOCATION + column, 4, GL_FLOAT, GL_FALSE, sizeof(glm::mat4),
+					reinterpret_cast<const void*>(offset + column * sizeof(glm::vec4)));
+		}
+		mesh.drawInstanced(shader, static_cast<GLsizei>(count), lod);
+	}
+}
+
+void Model::drawClusters(Shader& shader, const glm::mat4& model, const glm::mat4& viewProjection, const glm::vec3& cameraPosition,
+	bool cullBackfaces) {
+	// cull in object space, so the meshlet bounds never need transforming
+	glm::mat4 modelViewProjection = viewProjection * model;
+	glm::vec3 objectCamera = glm::vec3(glm::inverse(model) * glm::vec4(cameraPosition, 1.0f));
+	for (unsigned int i = 0; i < meshes.size(); i++)
+		meshes[i].drawClusters(shader, modelViewProjection, objectCamera, cullBackfaces);
 }
 
 unsigned int Model::getNumMeshes() {
 	return meshes.size();
 }
 
+const glm::vec3& Model::getBoundsCenter() const {
+	return boundsCenter;
+}
+
+float Model::getBoundsRadius() const {
+	return boundsRadius;
+}
+
 unsigned int Model::getMeshVAO(unsigned int meshIndex) {
 	return meshes[meshIndex].getVAO();
 }
 
-unsigned int Model::getMeshNumIndices(unsigned int meshIndex) {
-	return meshes[meshIndex].getNumIndices();
+unsigned int Model::getMeshNumIndices(unsigned int meshIndex, unsigned int lod) {
+	return meshes[meshIndex].getNumIndices(lod);
+}
+
+const void* Model::getMeshIndexOffset(unsigned int meshIndex, unsigned int lod) {
+	return meshes[meshIndex].getIndexOffset(lod);
+}
+
+GLint Model::getMeshBaseVertex(unsigned int meshIndex) {
+	return meshes[meshIndex].getBaseVertex();
+}
+
+unsigned int Model::getMeshNumLods(unsigned int meshIndex) {
+	return meshes[meshIndex].getNumLods();
+}
+
+unsigned int Model::getNumLods() const {
+	return static_cast<unsigned int>(lodErrors.size());
+}
+
+float Model::getScreenSize(const glm::mat4& modelView, const glm::mat4& projection, float viewportHeight) const {
+	glm::vec3 center = glm::vec3(modelView * glm::vec4(boundsCenter, 1.0f));
+	float scale = std::max(glm::length(glm::vec3(modelView[0])),
+		std::max(glm::length(glm::vec3(modelView[1])), glm::length(glm::vec3(modelView[2]))));
+	float radius = boundsRadius * scale;
+	float distance = glm::length(center);
+	if (distance <= radius)
+		return std::numeric_limits<float>::max();
+	// projection[1][1] maps a unit at distance 1 to half the viewport height
+	return radius / distance * projection[1][1] * viewportHeight;
+}
+
+unsigned int Model::selectLod(float screenSize, unsigned int previousLod) const {
+	if (lodErrors.empty())
+		return 0;
+	// errors are relative to the radius, half the screen size
+	float pixelsPerError = 0.5f * screenSize;
+	unsigned int lod = std::min(previousLod, static_cast<unsigned int>(lodErrors.size()) - 1);
+	while (lod > 0 && lodErrors[lod] * pixelsPerError > LOD_PIXEL_ERROR * (1.0f + LOD_HYSTERESIS))
+		lod--;
+	while (lod + 1 < lodErrors.size() && lodErrors[lod + 1] * pixelsPerError <= LOD_PIXEL_ERROR * (1.0f - LOD_HYSTERESIS))
+		lod++;
+	return lod;
+}
+
+GLenum Model::getMeshIndexType(unsigned int meshIndex) {
+	return meshes[meshIndex].getIndexType();
 }
 
 unsigned int Model::getTextureID(unsigned int textureIndex) {
 	return texturesLoaded[textureIndex].id;
 }
 
+void Model::releaseMeshData() {
+	for (Mesh& mesh : meshes)
+		mesh.releaseCpuData();
+}
+
 void Model::loadModel(std::string path) {
+	directory = path.substr(0, path.find_last_of('/'));
+	// hashing the raw asset is far cheaper than importing it
+	std::uint64_t sourceHash = 0;
+	MappedFile source;
+	if (source.open(path))
+		sourceHash = hashMaterialLibraries(source.data(), source.size(), fnv1a(source.data(), source.size()));
+	source.close();
+	if (sourceHash && loadCached(path, sourceHash))
+		return;
+
 	Assimp::Importer importer;
 	const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs);
 	if (!scene || scene->mFlags & AI_SCENE_FLAGS_INCOMPLETE || !scene->mRootNode) {
 		std::cout << "ERROR::ASSIMP::" << importer.GetErrorString() << std::endl;
 		return;
 	}
-	directory = path.substr(0, path.find_last_of('/'));
-	processNode(scene->mRootNode, scene);
+	std::vector<aiMesh*> sceneMeshes;
+	processNode(scene->mRootNode, scene, sceneMeshes);
+	// the scene is only read from here on, so every mesh converts independently
+	std::vector<MeshData> data(sceneMeshes.size());
+	parallelFor(sceneMeshes.size(), [&](std::size_t i) {
+		data[i] = processMesh(sceneMeshes[i], scene);
+	});
+	for (std::size_t i = 0; i < data.size(); i++) {
+		std::cout << "mesh " << i << " (" << sceneMeshes[i]->mNumVertices << " -> " << data[i].vertices.size()
+			<< " vertices): ACMR " << data[i].original.acmr << " -> " << data[i].optimized.acmr
+			<< ", ATVR " << data[i].original.atvr << " -> " << data[i].optimized.atvr << std::endl;
+	}
+	std::size_t numRefs = 0;
+	for (const MeshData& mesh : data)
+		numRefs += mesh.textures.size();
+	std::vector<Texture> refs;
+	refs.reserve(numRefs);
+	for (const MeshData& mesh : data)
+		refs.insert(refs.end(), mesh.textures.begin(), mesh.textures.end());
+	loadTextures(refs);
+	meshes.reserve(data.size());
+	for (MeshData& mesh : data)
+		meshes.emplace_back(std::move(mesh.vertices), std::move(mesh.indices), resolveTextures(mesh.textures), vertexFormat,
+			std::move(mesh.lods));
+	if (sourceHash)
+		MeshCache::store(path, sourceHash, meshes);
 }
 
-void Model::processNode(aiNode* node, const aiScene* scene) {
-	for (unsigned int i = 0; i < node->mNumMeshes; i++) {
-		aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-		meshes.push_back(processMesh(mesh, scene));
+std::uint64_t Model::hashMaterialLibraries(const char* source, std::size_t size, std::uint64_t hash) const {
+	const char* end = source + size;
+	for (const char* line = source; line < end;) {
+		const char* lineEnd = std::find(line, end, '\n');
+		const char* start = line;
+		while (start < lineEnd && (*start == ' ' || *start == '\t'))
+			start++;
+		// like Assimp, the rest of the line is a single file name
+		if (lineEnd - start > 7 && std::equal(start, start + 6, "mtllib") && (start[6] == ' ' || start[6] == '\t')) {
+			const char* name = start + 7;
+			const char* nameEnd = lineEnd;
+			while (name < nameEnd && (*name == ' ' || *name == '\t'))
+				name++;
+			while (nameEnd > name && (nameEnd[-1] == ' ' || nameEnd[-1] == '\t' || nameEnd[-1] == '\r'))
+				nameEnd--;
+			// the name goes in too, so a library that goes missing changes the hash
+			std::string library(name, nameEnd);
+			hash = fnv1aString(library.c_str(), hash);
+			MappedFile file;
+			if (file.open(directory + '/' + library))
+				hash = fnv1a(file.data(), file.size(), hash);
+		}
+		line = lineEnd + 1;
+	}
+	return hash;
+}
+
+bool Model::loadCached(const std::string& path, std::uint64_t sourceHash) {
+	MeshCache cache;
+	if (!cache.open(path, sourceHash))
+		return false;
+	std::vector<std::vector<Texture>> meshTextures(cache.getNumMeshes());
+	std::vector<Texture> refs;
+	for (unsigned int i = 0; i < cache.getNumMeshes(); i++) {
+		for (const MeshCache::TextureRef& ref : cache.getTextures(i)) {
+			Texture texture;
+			texture.id = 0;
+			texture.kind = ref.kind;
+			texture.path = ref.path;
+			meshTextures[i].push_back(texture);
+		}
+		refs.insert(refs.end(), meshTextures[i].begin(), meshTextures[i].end());
+	}
+	loadTextures(refs);
+	meshes.reserve(cache.getNumMeshes());
+	for (unsigned int i = 0; i < cache.getNumMeshes(); i++) {
+		// vertex and index data go to the driver straight from the mapping
+		meshes.emplace_back(cache.getVertices(i), cache.getNumVertices(i), cache.getIndices(i), cache.getNumIndices(i),
+			resolveTextures(meshTextures[i]), cache.getBoundsMin(i), cache.getBoundsMax(i), vertexFormat, cache.getLods(i));
 	}
+	return true;
+}
+
+void Model::processNode(aiNode* node, const aiScene* scene, std::vector<aiMesh*>& sceneMeshes) {
+	for (unsigned int i = 0; i < node->mNumMeshes; i++)
+		sceneMeshes.push_back(scene->mMeshes[node->mMeshes[i]]);
 	for (unsigned int i = 0; i < node->mNumChildren; i++)
-		processNode(node->mChildren[i], scene);
+		processNode(node->mChildren[i], scene, sceneMeshes);
 }
 
-Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene) {
-	std::vector<Vertex> vertices;
-	std::vector<unsigned int> indices;
-	std::vector<Texture> textures;
+Model::MeshData Model::processMesh(aiMesh* mesh, const aiScene* scene) const {
+	MeshData data;
+	data.vertices.reserve(mesh->mNumVertices);
 	for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
 		// process vertex position, normals, and texture coordinates (if exists)
 		Vertex vertex;
@@ -77,73 +273,117 @@ Mesh Model::processMesh(aiMesh* mesh, const aiScene* scene) {
 			vertex.texCoords = vector2;
 		} else
 			vertex.texCoords = glm::vec2(0.0f, 0.0f);
-		vertices.push_back(vertex);
+		data.vertices.push_back(vertex);
 	}
 	// process indices
+	data.indices.reserve(mesh->mNumFaces * 3);
 	for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
-		aiFace face = mesh->mFaces[i];
+		// a copy of aiFace would allocate its own index array
+		const aiFace& face = mesh->mFaces[i];
 		for (unsigned int j = 0; j < face.mNumIndices; j++)
-			indices.push_back(face.mIndices[j]);
+			data.indices.push_back(face.mIndices[j]);
 	}
+	// reordering once here also bakes the optimized order into the .lmesh cache
+	data.original = MeshOptimizer::analyze(data.indices, data.vertices.size());
+	MeshOptimizer::optimize(data.vertices, data.indices);
+	data.optimized = MeshOptimizer::analyze(data.indices, data.vertices.size());
+	buildLods(data);
 	// process material
 	if (mesh->mMaterialIndex >= 0) {
 		aiMaterial* material = scene->mMaterials[mesh->mMaterialIndex];
-		std::vector<Texture> diffuseMaps = loadMaterialTextures(material, aiTextureType_DIFFUSE, "texture_diffuse");
-		textures.insert(textures.end(), diffuseMaps.begin(), diffuseMaps.end());
-		std::vector<Texture> specularMaps = loadMaterialTextures(material, aiTextureType_SPECULAR, "texture_specular");
-		textures.insert(textures.end(), specularMaps.begin(), specularMaps.end());
+		data.textures.reserve(material->GetTextureCount(aiTextureType_DIFFUSE) + material->GetTextureCount(aiTextureType_SPECULAR));
+		loadMaterialTextures(material, aiTextureType_DIFFUSE, TextureKind::DIFFUSE, data.textures);
+		loadMaterialTextures(material, aiTextureType_SPECULAR, TextureKind::SPECULAR, data.textures);
 	}
-	return Mesh(vertices, indices, textures);
+	return data;
 }
 
-std::vector<Texture> Model::loadMaterialTextures(aiMaterial* mat, aiTextureType type, std::string typeName) {
-	std::vector<Texture> textures;
+void Model::buildLods(MeshData& data) const {
+	std::vector<unsigned int> full(data.indices);
+	MeshLod lod = { 0, static_cast<unsigned int>(full.size()), 0.0f };
+	data.lods.push_back(lod);
+	// every level simplifies the full mesh, so errors do not compound
+	for (unsigned int level = 1; level < MAX_LODS; level++) {
+		std::size_t targetTriangles = full.size() / 3 >> level;
+		if (targetTriangles < MIN_LOD_TRIANGLES)
+			break;
+		float error;
+		std::vector<unsigned int> indices = MeshSimplifier::simplify(data.vertices, full, targetTriangles * 3, &error);
+		// locked seams and borders stopped the simplifier, coarser targets would not get further
+		if (indices.size() * 8 > data.lods.back().numIndices * 7)
+			break;
+		MeshOptimizer::optimizeVertexCache(indices, data.vertices.size());
+		lod.firstIndex = static_cast<unsigned int>(data.indices.size());
+		lod.numIndices = static_cast<unsigned int>(indices.size());
+		lod.error = error;
+		data.lods.push_back(lod);
+		data.indices.insert(data.indices.end(), indices.begin(), indices.end());
+	}
+}
+
+void Model::computeLodErrors() {
+	if (meshes.empty())
+		return;
+	glm::vec3 boundsMin = meshes[0].getBoundsMin();
+	glm::vec3 boundsMax = meshes[0].getBoundsMax();
+	unsigned int numLods = 0;
+	for (const Mesh& mesh : meshes) {
+		boundsMin = glm::min(boundsMin, mesh.getBoundsMin());
+		boundsMax = glm::max(boundsMax, mesh.getBoundsMax());
+		numLods = std::max(numLods, mesh.getNumLods());
+	}
+	boundsCenter = 0.5f * (boundsMin + boundsMax);
+	// whichever is tighter, the box's half diagonal or a sphere around the mesh spheres
+	float sphereRadius = 0.0f;
+	meshBoxes.clear();
+	for (const Mesh& mesh : meshes) {
+		sphereRadius = std::max(sphereRadius, glm::length(mesh.getSphereCenter() - boundsCenter) + mesh.getSphereRadius());
+		meshBoxes.add(mesh.getBoundsMin(), mesh.getBoundsMax());
+	}
+	boundsRadius = std::min(0.5f * glm::length(boundsMax - boundsMin), sphereRadius);
+	// meshes with fewer levels keep drawing their coarsest one
+	lodErrors.assign(numLods, 0.0f);
+	for (const Mesh& mesh : meshes) {
+		for (unsigned int i = 0; i < numLods; i++) {
+			float error = mesh.getLod(std::min(i, mesh.getNumLods() - 1)).error;
+			lodErrors[i] = std::max(lodErrors[i], boundsRadius > 0.0f ? error / boundsRadius : 0.0f);
+		}
+	}
+}
+
+void Model::loadMaterialTextures(aiMaterial* mat, aiTextureType type, TextureKind kind, std::vector<Texture>& textures) const {
 	for (unsigned int i = 0; i < mat->GetTextureCount(type); i++) {
 		aiString str;
 		mat->GetTexture(type, i, &str);
-		bool skip = false;
-		for (unsigned int j = 0; j < texturesLoaded.size(); j++) {
-			if (!std::strcmp(texturesLoaded[j].path.data(), str.C_Str())) {
-				textures.push_back(texturesLoaded[j]);
-				skip = true;
-				break;
-			}
-		}
-		if (!skip) {
-			Texture texture;
-			texture.id = textureFromFile(str.C_Str(), directory);
-			texture.type = typeName;
-			texture.path = str.C_Str();
-			textures.push_back(texture);
-			texturesLoaded.push_back(texture);
-		}
+		textures.emplace_back();
+		Texture& texture = textures.back();
+		texture.id = 0;
+		texture.kind = kind;
+		texture.path = str.C_Str();
+	}
+}
+
+void Model::loadTextures(const std::vector<Texture>& refs) {
+	TextureOptions options;
+	options.flipVertically = flipTextures;
+	// every path once, in first-use order so texture indices stay stable
+	for (const Texture& ref : refs) {
+		if (textureIndices.count(ref.path))
+			continue;
+		// shared with every other model using the same image
+		TextureHandle handle = TextureCache::load(directory + '/' + ref.path, options);
+		Texture texture = ref;
+		texture.id = handle.getID();
+		textureIndices[ref.path] = static_cast<unsigned int>(texturesLoaded.size());
+		texturesLoaded.push_back(texture);
+		textureHandles.push_back(std::move(handle));
 	}
-	return textures;
 }
 
-unsigned int Model::textureFromFile(const char* path, const std::string directory, bool gamma) {
-	std::string filename = directory + '/' + std::string(path);
-	unsigned int textureID;
-	glGenTextures(1, &textureID);
-	int width, height, nrComponents;
-	unsigned char* data = stbi_load(filename.c_str(), &width, &height, &nrComponents, 0);
-	if (data) {
-		GLenum format;
-		if (nrComponents == 1)
-			format = GL_RED;
-		else if (nrComponents == 3)
-			format = GL_RGB;
-		else if (nrComponents == 4)
-			format = GL_RGBA;
-		glBindTexture(GL_TEXTURE_2D, textureID);
-		glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-		glGenerateMipmap(GL_TEXTURE_2D);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	} else
-		std::cout << "Texture failed to load at path: " << path << std::endl;
-	stbi_image_free(data);
-	return textureID;
-}
\ No newline at end of file
+std::vector<Texture> Model::resolveTextures(const std::vector<Texture>& refs) const {
+	std::vector<Texture> textures;
+	textures.reserve(refs.size());
+	for (const Texture& ref : refs)
+		textures.push_back(texturesLoaded[textureIndices.at(ref.path)]);
+	return textures;
+}
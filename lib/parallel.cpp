@@ -0,0 +1,103 @@
+/**
+ * @file parallel.cpp
+ * @brief Minimal data-parallel loop over worker threads
+ * @date October 2026
+ */
+
+#include <learnopengl/parallel.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// set on the pool's own threads and on a thread while it runs a loop on the pool, whose nested loops run inline
+thread_local bool inLoop = false;
+
+/**
+ * Threads started on the first parallel loop and kept until exit, so a loop
+ * costs a wake-up instead of creating and joining threads. One loop runs on
+ * the pool at a time. The pool is never torn down; its threads are detached
+ * and end with the process.
+ */
+class WorkerPool {
+public:
+	explicit WorkerPool(unsigned int threads) : threads(threads), body(nullptr), count(0), next(0), generation(0), active(0) {
+		for (unsigned int i = 0; i < threads; i++)
+			std::thread(&WorkerPool::run, this).detach();
+	}
+	// false when another thread's loop holds the pool
+	bool execute(std::size_t count, const std::function<void(std::size_t)>& body) {
+		std::unique_lock<std::mutex> submitLock(submit, std::try_to_lock);
+		if (!submitLock)
+			return false;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			this->body = &body;
+			this->count = count;
+			next = 0;
+			active = threads;
+			generation++;
+		}
+		wake.notify_all();
+		work();
+		std::unique_lock<std::mutex> lock(mutex);
+		done.wait(lock, [this]() { return active == 0; });
+		return true;
+	}
+private:
+	unsigned int threads;
+	std::mutex submit;
+	std::mutex mutex;
+	std::condition_variable wake;
+	std::condition_variable done;
+	const std::function<void(std::size_t)>* body;
+	std::size_t count;
+	std::atomic<std::size_t> next;
+	unsigned long long generation;
+	unsigned int active;
+
+	void work() {
+		for (std::size_t i = next++; i < count; i = next++)
+			(*body)(i);
+	}
+
+	void run() {
+		inLoop = true;
+		unsigned long long seen = 0;
+		std::unique_lock<std::mutex> lock(mutex);
+		while (true) {
+			wake.wait(lock, [&]() { return generation != seen; });
+			seen = generation;
+			lock.unlock();
+			work();
+			lock.lock();
+			if (--active == 0)
+				done.notify_one();
+		}
+	}
+};
+
+}
+
+unsigned int workerCount() {
+	// hardware_concurrency may report 0 when unknown
+	return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void parallelFor(std::size_t count, const std::function<void(std::size_t)>& body) {
+	if (count > 1 && workerCount() > 1 && !inLoop) {
+		// never destroyed, static threads such as TextureStreamer's decoders may still run loops during exit
+		static WorkerPool& pool = *new WorkerPool(workerCount() - 1);
+		inLoop = true;
+		bool ran = pool.execute(count, body);
+		inLoop = false;
+		if (ran)
+			return;
+	}
+	// a single iteration, a single core, a nested loop or a pool busy with another thread's loop
+	for (std::size_t i = 0; i < count; i++)
+		body(i);
+}
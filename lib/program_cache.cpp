@@ -0,0 +1,100 @@
+/**
+ * @file program_cache.cpp
+ * @brief Persistent on-disk cache of linked program binaries
+ * @date October 2026
+ */
+
+#include <learnopengl/program_cache.h>
+#include <learnopengl/gl_extensions.h>
+#include <learnopengl/file_system.h>
+#include <learnopengl/hash.h>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+std::string ProgramCache::directory = "cache/shaders";
+
+std::uint64_t ProgramCache::computeKey(const char* const* sources, unsigned int count) {
+	std::uint64_t key = FNV_OFFSET_BASIS;
+	for (unsigned int i = 0; i < count; i++) {
+		if (sources[i])
+			key = fnv1aString(sources[i], key);
+		key = fnv1a("\0", 1, key);
+	}
+	// binaries are only valid for the driver that produced them
+	const GLenum driverStrings[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+	for (GLenum name : driverStrings) {
+		const char* value = reinterpret_cast<const char*>(glGetString(name));
+		if (value)
+			key = fnv1aString(value, key);
+	}
+	return key;
+}
+
+bool ProgramCache::load(std::uint64_t key, unsigned int program) {
+	GLExtensions::load();
+	if (!GLExtensions::programBinary)
+		return false;
+	std::ifstream file(getPath(key), std::ios::binary);
+	if (!file)
+		return false;
+	std::uint32_t magic = 0, version = 0, format = 0, length = 0;
+	std::uint64_t storedKey = 0;
+	file.read(reinterpret_cast<char*>(&magic), sizeof(magic));
+	file.read(reinterpret_cast<char*>(&version), sizeof(version));
+	file.read(reinterpret_cast<char*>(&storedKey), sizeof(storedKey));
+	file.read(reinterpret_cast<char*>(&format), sizeof(format));
+	file.read(reinterpret_cast<char*>(&length), sizeof(length));
+	if (!file || magic != MAGIC || version != VERSION || storedKey != key || !length)
+		return false;
+	std::vector<char> binary(length);
+	if (!file.read(binary.data(), length))
+		return false;
+	GLExtensions::programBinaryLoad(program, format, binary.data(), static_cast<GLsizei>(length));
+	GLint success = GL_FALSE;
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
+	return success == GL_TRUE;
+}
+
+void ProgramCache::prepare(unsigned int program) {
+	GLExtensions::load();
+	if (GLExtensions::programBinary)
+		GLExtensions::programParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
+void ProgramCache::store(std::uint64_t key, unsigned int program) {
+	GLExtensions::load();
+	if (!GLExtensions::programBinary)
+		return;
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return;
+	std::vector<char> binary(length);
+	GLenum format = 0;
+	GLsizei written = 0;
+	GLExtensions::getProgramBinary(program, length, &written, &format, binary.data());
+	if (written <= 0)
+		return;
+	makeDirectories(directory);
+	std::ofstream file(getPath(key), std::ios::binary | std::ios::trunc);
+	if (!file) {
+		std::cout << "ERROR::PROGRAM_CACHE::FILE_NOT_WRITABLE " << getPath(key) << std::endl;
+		return;
+	}
+	std::uint32_t magic = MAGIC, version = VERSION, storedFormat = format, storedLength = written;
+	file.write(reinterpret_cast<const char*>(&magic), sizeof(magic));
+	file.write(reinterpret_cast<const char*>(&version), sizeof(version));
+	file.write(reinterpret_cast<const char*>(&key), sizeof(key));
+	file.write(reinterpret_cast<const char*>(&storedFormat), sizeof(storedFormat));
+	file.write(reinterpret_cast<const char*>(&storedLength), sizeof(storedLength));
+	file.write(binary.data(), written);
+}
+
+void ProgramCache::setDirectory(const std::string& directory) {
+	ProgramCache::directory = directory;
+}
+
+std::string ProgramCache::getPath(std::uint64_t key) {
+	return directory + '/' + toHexString(key) + ".bin";
+}
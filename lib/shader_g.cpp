@@ -5,113 +5,187 @@
  */
 
 #include <learnopengl/shader_g.h>
+#include <learnopengl/program_cache.h>
+#include <learnopengl/gl_state.h>
+#include <algorithm>
+
+unsigned long long Shader::nextProgramSerial = 0;
 
  // compile shader program on the fly
-Shader::Shader(const char* vertexPath, const char* fragmentPath, const char* geometryPath) {
-	// retrieve shader code
-	std::string vertexCode, fragmentCode, geometryCode;
-	std::ifstream vShaderFile, fShaderFile, gShaderFile;
-	vShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-	fShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-	gShaderFile.exceptions(std::ifstream::failbit | std::ifstream::badbit);
-	try {
-		std::stringstream vShaderStream, fShaderStream, gShaderStream;
-		vShaderFile.open(vertexPath);
-		vShaderStream << vShaderFile.rdbuf();
-		vShaderFile.close();
-		vertexCode = vShaderStream.str();
-		fShaderFile.open(fragmentPath);
-		fShaderStream << fShaderFile.rdbuf();
-		fShaderFile.close();
-		fragmentCode = fShaderStream.str();
-		if (geometryPath) {
-			gShaderFile.open(geometryPath);
-			gShaderStream << gShaderFile.rdbuf();
-			gShaderFile.close();
-			geometryCode = gShaderStream.str();
-		}
-	}
-	catch (std::ifstream::failure& e) {
-		std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ\n" << e.what() << std::endl;
-	}
-	const char* vShaderCode = vertexCode.c_str();
-	const char* fShaderCode = fragmentCode.c_str();
-	const char* gShaderCode = geometryCode.c_str();
+Shader::Shader(const char* vertexPath, const char* fragmentPath, const char* geometryPath)
+	: Shader(vertexPath, fragmentPath, ShaderDefines(), geometryPath) {}
 
-	// compile shaders
-	unsigned int vertex = compileShader(GL_VERTEX_SHADER, vShaderCode);
-	unsigned int fragment = compileShader(GL_FRAGMENT_SHADER, fShaderCode);
-	unsigned int geometry;
+Shader::Shader(const char* vertexPath, const char* fragmentPath, const ShaderDefines& defines, const char* geometryPath)
+	: programSerial(++nextProgramSerial), defines(defines) {
+	// retrieve shader code
+	sourcePaths[0] = vertexPath;
+	sourcePaths[1] = fragmentPath;
 	if (geometryPath)
-		geometry = compileShader(GL_GEOMETRY_SHADER, gShaderCode);
+		sourcePaths[2] = geometryPath;
+	std::string code[3];
+	loadSources(sourcePaths, defines, code);
 
 	// create shader program
 	id = glCreateProgram();
-	glAttachShader(id, vertex);
-	glAttachShader(id, fragment);
-	if (geometryPath)
-		glAttachShader(id, geometry);
-	glLinkProgram(id);
-	checkCompileErrors(id);
+	link(id, code[0].c_str(), code[1].c_str(), geometryPath ? code[2].c_str() : nullptr);
+	uniforms.reflect(id);
+}
 
-	// delete shader resources
-	glDeleteShader(vertex);
-	glDeleteShader(fragment);
+Shader::Shader(unsigned int program, const char* vertexPath, const char* fragmentPath, const char* geometryPath,
+	const ShaderDefines& defines) : id(program), programSerial(++nextProgramSerial), defines(defines) {
+	sourcePaths[0] = vertexPath;
+	sourcePaths[1] = fragmentPath;
 	if (geometryPath)
-		glDeleteShader(geometry);
+		sourcePaths[2] = geometryPath;
+	uniforms.reflect(id);
+}
+
+Shader::~Shader() {
+	GLState::forgetProgram(id);
+	glDeleteProgram(id);
 }
 
-Shader::~Shader() { glDeleteProgram(id); }
+bool Shader::reload(const std::string& vertexCode, const std::string& fragmentCode, const std::string& geometryCode) {
+	unsigned int program = glCreateProgram();
+	if (!link(program, vertexCode.c_str(), fragmentCode.c_str(), geometryCode.empty() ? nullptr : geometryCode.c_str())) {
+		// keep running with the previous program
+		glDeleteProgram(program);
+		return false;
+	}
+	// carry over values set once at startup, such as sampler units
+	UniformCache::copyValues(id, program);
+	GLState::forgetProgram(id);
+	glDeleteProgram(id);
+	id = program;
+	programSerial = ++nextProgramSerial;
+	uniforms.reflect(id);
+	return true;
+}
 
-void Shader::use() const { glUseProgram(id); }
+bool Shader::loadSources(const std::string paths[3], const ShaderDefines& defines, std::string code[3],
+	std::vector<std::string>* dependencies) {
+	bool success = true;
+	if (dependencies)
+		dependencies->clear();
+	for (unsigned int i = 0; i < 3; i++) {
+		code[i].clear();
+		if (paths[i].empty())
+			continue;
+		std::vector<std::string> included;
+		success &= ShaderPreprocessor::process(paths[i], defines, code[i], &included);
+		if (!dependencies)
+			continue;
+		// stages commonly share includes, list each file once
+		for (const std::string& path : included)
+			if (std::find(dependencies->begin(), dependencies->end(), path) == dependencies->end())
+				dependencies->push_back(path);
+	}
+	return success;
+}
+
+const std::string& Shader::getSourcePath(GLenum shaderType) const {
+	switch (shaderType) {
+		case GL_FRAGMENT_SHADER:
+			return sourcePaths[1];
+		case GL_GEOMETRY_SHADER:
+			return sourcePaths[2];
+		default:
+			return sourcePaths[0];
+	}
+}
+
+const ShaderDefines& Shader::getDefines() const { return defines; }
+
+void Shader::use() const { GLState::useProgram(id); }
 
 unsigned int Shader::getID() const  { return id; }
 
-void Shader::setBool(const std::string& name, bool value) const {
-	glUniform1i(glGetUniformLocation(id, name.c_str()), (int)value);
+unsigned long long Shader::getProgramSerial() const { return programSerial; }
+
+int Shader::getUniformLocation(UniformName name) const { return uniforms.getLocation(name); }
+
+void Shader::setBool(UniformName name, bool value) const {
+	glUniform1i(uniforms.getLocation(name), (int)value);
 }
 
-void Shader::setInt(const std::string& name, int value) const {
-	glUniform1i(glGetUniformLocation(id, name.c_str()), value);
+void Shader::setInt(UniformName name, int value) const {
+	glUniform1i(uniforms.getLocation(name), value);
 }
 
-void Shader::setFloat(const std::string& name, float value) const {
-	glUniform1f(glGetUniformLocation(id, name.c_str()), value);
+void Shader::setFloat(UniformName name, float value) const {
+	glUniform1f(uniforms.getLocation(name), value);
 }
 
-void Shader::setVec2(const std::string& name, const glm::vec2& value) const {
-	glUniform2fv(glGetUniformLocation(id, name.c_str()), 1, &value[0]);
+void Shader::setVec2(UniformName name, const glm::vec2& value) const {
+	glUniform2fv(uniforms.getLocation(name), 1, &value[0]);
 }
 
-void Shader::setVec2(const std::string& name, float x, float y) const {
-	glUniform2f(glGetUniformLocation(id, name.c_str()), x, y);
+void Shader::setVec2(UniformName name, float x, float y) const {
+	glUniform2f(uniforms.getLocation(name), x, y);
 }
-void Shader::setVec3(const std::string& name, const glm::vec3& value) const {
-	glUniform3fv(glGetUniformLocation(id, name.c_str()), 1, &value[0]);
+void Shader::setVec3(UniformName name, const glm::vec3& value) const {
+	glUniform3fv(uniforms.getLocation(name), 1, &value[0]);
 }
 
-void Shader::setVec3(const std::string& name, float x, float y, float z) const {
-	glUniform3f(glGetUniformLocation(id, name.c_str()), x, y, z);
+void Shader::setVec3(UniformName name, float x, float y, float z) const {
+	glUniform3f(uniforms.getLocation(name), x, y, z);
 }
 
-void Shader::setVec4(const std::string& name, const glm::vec4& value) const {
-	glUniform4fv(glGetUniformLocation(id, name.c_str()), 1, &value[0]);
+void Shader::setVec4(UniformName name, const glm::vec4& value) const {
+	glUniform4fv(uniforms.getLocation(name), 1, &value[0]);
 }
 
-void Shader::setVec4(const std::string& name, float x, float y, float z, float w) const {
-	glUniform4f(glGetUniformLocation(id, name.c_str()), x, y, z, w);
+void Shader::setVec4(UniformName name, float x, float y, float z, float w) const {
+	glUniform4f(uniforms.getLocation(name), x, y, z, w);
 }
 
-void Shader::setMat2(const std::string& name, const glm::mat2& mat) const {
-	glUniformMatrix2fv(glGetUniformLocation(id, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+void Shader::setMat2(UniformName name, const glm::mat2& mat) const {
+	glUniformMatrix2fv(uniforms.getLocation(name), 1, GL_FALSE, &mat[0][0]);
 }
 
-void Shader::setMat3(const std::string& name, const glm::mat3& mat) const {
-	glUniformMatrix3fv(glGetUniformLocation(id, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+void Shader::setMat3(UniformName name, const glm::mat3& mat) const {
+	glUniformMatrix3fv(uniforms.getLocation(name), 1, GL_FALSE, &mat[0][0]);
 }
 
-void Shader::setMat4(const std::string& name, const glm::mat4& mat) const {
-	glUniformMatrix4fv(glGetUniformLocation(id, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+void Shader::setMat4(UniformName name, const glm::mat4& mat) const {
+	glUniformMatrix4fv(uniforms.getLocation(name), 1, GL_FALSE, &mat[0][0]);
+}
+
+bool Shader::link(unsigned int program, const char* vShaderCode, const char* fShaderCode, const char* gShaderCode) {
+	// link from the program binary cache when an identical program was built before
+	const char* sources[] = { vShaderCode, fShaderCode, gShaderCode };
+	std::uint64_t cacheKey = ProgramCache::computeKey(sources, 3);
+	if (ProgramCache::load(cacheKey, program))
+		return true;
+
+	// compile shaders
+	unsigned int vertex = compileShader(GL_VERTEX_SHADER, vShaderCode);
+	unsigned int fragment = compileShader(GL_FRAGMENT_SHADER, fShaderCode);
+	unsigned int geometry = 0;
+	if (gShaderCode)
+		geometry = compileShader(GL_GEOMETRY_SHADER, gShaderCode);
+
+	// link shader program
+	glAttachShader(program, vertex);
+	glAttachShader(program, fragment);
+	if (geometry)
+		glAttachShader(program, geometry);
+	ProgramCache::prepare(program);
+	glLinkProgram(program);
+	bool success = checkCompileErrors(program);
+	if (success)
+		ProgramCache::store(cacheKey, program);
+
+	// delete shader resources
+	glDetachShader(program, vertex);
+	glDetachShader(program, fragment);
+	glDeleteShader(vertex);
+	glDeleteShader(fragment);
+	if (geometry) {
+		glDetachShader(program, geometry);
+		glDeleteShader(geometry);
+	}
+	return success;
 }
 
 unsigned int Shader::compileShader(GLenum shaderType, const char* shaderCode) {
@@ -122,7 +196,7 @@ unsigned int Shader::compileShader(GLenum shaderType, const char* shaderCode) {
 	return shader;
 }
 
-void Shader::checkCompileErrors(GLuint shader, GLenum shaderType) {
+bool Shader::checkCompileErrors(GLuint shader, GLenum shaderType) {
 	GLint success;
 	GLchar infoLog[INFO_LOG_SIZE];
 	if (shaderType) {
@@ -132,12 +206,13 @@ void Shader::checkCompileErrors(GLuint shader, GLenum shaderType) {
 			std::cout << "ERROR::SHADER::" << shaderTypeToString(shaderType) << "::COMPILATION_FAILED\n" << infoLog << std::endl;
 		}
 	} else {
-		glGetProgramiv(id, GL_LINK_STATUS, &success);
+		glGetProgramiv(shader, GL_LINK_STATUS, &success);
 		if (!success) {
 			glGetProgramInfoLog(shader, INFO_LOG_SIZE, nullptr, infoLog);
 			std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
 		}
 	}
+	return success == GL_TRUE;
 }
 
 std::string Shader::shaderTypeToString(GLenum shaderType) {
@@ -0,0 +1,210 @@
+/**
+ * @file shader_library.cpp
+ * @brief Batched shader program compilation
+ * @date October 2026
+ */
+
+#include <learnopengl/shader_library.h>
+#include <learnopengl/gl_extensions.h>
+#include <learnopengl/program_cache.h>
+#include <iomanip>
+#include <stdexcept>
+#include <thread>
+
+const GLenum ShaderLibrary::STAGE_TYPES[3] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER };
+
+static const char* STAGE_NAMES[3] = { "VERTEX", "FRAGMENT", "GEOMETRY" };
+static const unsigned int INFO_LOG_SIZE = 1024;
+
+static double millisecondsSince(std::chrono::steady_clock::time_point start) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+ShaderLibrary::ShaderLibrary() {}
+
+void ShaderLibrary::add(const std::string& name, const char* vertexPath, const char* fragmentPath, const char* geometryPath) {
+	add(name, vertexPath, fragmentPath, ShaderDefines(), geometryPath);
+}
+
+void ShaderLibrary::add(const std::string& name, const char* vertexPath, const char* fragmentPath, const ShaderDefines& defines,
+	const char* geometryPath) {
+	if (indices.count(name)) {
+		std::cout << "ERROR::SHADER_LIBRARY::DUPLICATE_PROGRAM " << name << std::endl;
+		return;
+	}
+	Program program;
+	program.name = name;
+	program.paths[0] = vertexPath;
+	program.paths[1] = fragmentPath;
+	if (geometryPath)
+		program.paths[2] = geometryPath;
+	program.defines = defines;
+	for (unsigned int& stage : program.stages)
+		stage = 0;
+	program.id = 0;
+	program.cacheKey = 0;
+	program.fromCache = false;
+	program.issued = false;
+	program.issueMs = 0.0;
+	program.waitMs = 0.0;
+	program.readyMs = -1.0;
+	indices[name] = programs.size();
+	programs.push_back(std::move(program));
+}
+
+void ShaderLibrary::compileAll() {
+	GLExtensions::load();
+	if (GLExtensions::parallelShaderCompile)
+		GLExtensions::maxShaderCompilerThreads(0xFFFFFFFF);
+	// first pass: every glCompileShader
+	for (Program& program : programs)
+		if (!program.issued)
+			issue(program);
+	// second pass: every glLinkProgram, still without querying any status
+	for (Program& program : programs) {
+		if (program.issued || program.fromCache) {
+			program.issued = true;
+			continue;
+		}
+		Clock::time_point start = Clock::now();
+		for (unsigned int stage : program.stages)
+			if (stage)
+				glAttachShader(program.id, stage);
+		ProgramCache::prepare(program.id);
+		glLinkProgram(program.id);
+		program.issueMs += millisecondsSince(start);
+		program.issued = true;
+	}
+}
+
+bool ShaderLibrary::isReady(const std::string& name) {
+	Program& program = find(name);
+	if (!program.issued)
+		return false;
+	if (program.shader || program.fromCache || !GLExtensions::parallelShaderCompile)
+		return true;
+	return pollCompletion(program);
+}
+
+Shader& ShaderLibrary::get(const std::string& name) {
+	Program& program = find(name);
+	if (!program.issued)
+		compileAll();
+	if (!program.shader)
+		finish(program);
+	return *program.shader;
+}
+
+void ShaderLibrary::finishAll() {
+	compileAll();
+	// poll until the driver is done with every program, so each completion time is its own rather than when it was reached
+	if (GLExtensions::parallelShaderCompile) {
+		bool pending = true;
+		while (pending) {
+			pending = false;
+			for (Program& program : programs)
+				if (!program.shader && !program.fromCache && !pollCompletion(program))
+					pending = true;
+			if (pending)
+				std::this_thread::yield();
+		}
+	}
+	for (Program& program : programs)
+		if (!program.shader)
+			finish(program);
+}
+
+void ShaderLibrary::printTimings(std::ostream& out) const {
+	out << "shader library: " << programs.size() << " programs"
+		<< (GLExtensions::parallelShaderCompile ? " (parallel compile)" : "") << std::endl;
+	for (const Program& program : programs) {
+		out << "  " << std::left << std::setw(24) << program.name << std::right << std::fixed << std::setprecision(2);
+		if (!program.shader)
+			out << " pending" << std::endl;
+		else {
+			// issuing plus blocking is what compiling and linking cost this thread
+			out << " compile/link " << std::setw(8) << program.issueMs + program.waitMs << " ms (issue " << std::setw(8)
+				<< program.issueMs << ", wait " << std::setw(8) << program.waitMs << ")";
+			if (program.readyMs >= 0.0)
+				out << "  done after " << std::setw(8) << program.readyMs << " ms";
+			out << (program.fromCache ? "  (binary cache)" : "") << std::endl;
+		}
+	}
+}
+
+ShaderLibrary::Program& ShaderLibrary::find(const std::string& name) {
+	std::unordered_map<std::string, std::size_t>::iterator it = indices.find(name);
+	if (it == indices.end()) {
+		std::cout << "ERROR::SHADER_LIBRARY::UNKNOWN_PROGRAM " << name << std::endl;
+		throw std::out_of_range(name);
+	}
+	return programs[it->second];
+}
+
+void ShaderLibrary::issue(Program& program) {
+	program.issueStart = Clock::now();
+	Shader::loadSources(program.paths, program.defines, program.sources);
+	const char* sources[3];
+	for (unsigned int i = 0; i < 3; i++)
+		sources[i] = program.paths[i].empty() ? nullptr : program.sources[i].c_str();
+	program.cacheKey = ProgramCache::computeKey(sources, 3);
+	program.id = glCreateProgram();
+	program.fromCache = ProgramCache::load(program.cacheKey, program.id);
+	if (!program.fromCache) {
+		for (unsigned int i = 0; i < 3; i++) {
+			if (!sources[i])
+				continue;
+			program.stages[i] = glCreateShader(STAGE_TYPES[i]);
+			glShaderSource(program.stages[i], 1, &sources[i], nullptr);
+			glCompileShader(program.stages[i]);
+		}
+	}
+	program.issueMs = millisecondsSince(program.issueStart);
+}
+
+bool ShaderLibrary::pollCompletion(Program& program) {
+	if (program.readyMs >= 0.0)
+		return true;
+	GLint complete = GL_FALSE;
+	glGetProgramiv(program.id, GL_COMPLETION_STATUS_KHR, &complete);
+	if (complete != GL_TRUE)
+		return false;
+	program.readyMs = millisecondsSince(program.issueStart);
+	return true;
+}
+
+void ShaderLibrary::finish(Program& program) {
+	GLchar infoLog[INFO_LOG_SIZE];
+	GLint success;
+	if (!program.fromCache) {
+		Clock::time_point waitStart = Clock::now();
+		// these queries are where a serial driver blocks
+		for (unsigned int i = 0; i < 3; i++) {
+			if (!program.stages[i])
+				continue;
+			glGetShaderiv(program.stages[i], GL_COMPILE_STATUS, &success);
+			if (!success) {
+				glGetShaderInfoLog(program.stages[i], INFO_LOG_SIZE, nullptr, infoLog);
+				std::cout << "ERROR::SHADER::" << STAGE_NAMES[i] << "::COMPILATION_FAILED (" << program.name << ")\n" << infoLog << std::endl;
+			}
+		}
+		glGetProgramiv(program.id, GL_LINK_STATUS, &success);
+		program.waitMs = millisecondsSince(waitStart);
+		if (!success) {
+			glGetProgramInfoLog(program.id, INFO_LOG_SIZE, nullptr, infoLog);
+			std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED (" << program.name << ")\n" << infoLog << std::endl;
+		} else
+			ProgramCache::store(program.cacheKey, program.id);
+		for (unsigned int& stage : program.stages) {
+			if (!stage)
+				continue;
+			glDetachShader(program.id, stage);
+			glDeleteShader(stage);
+			stage = 0;
+		}
+	}
+	for (std::string& source : program.sources)
+		std::string().swap(source);
+	program.shader.reset(new Shader(program.id, program.paths[0].c_str(), program.paths[1].c_str(),
+		program.paths[2].empty() ? nullptr : program.paths[2].c_str(), program.defines));
+}
@@ -1,11 +1,12 @@
 /**
  * @file shader_m.cpp
  * @brief Shader class
- * @date Created: July 2023 | Last modified: November 2024
+ * @date Created: July 2023 | Last modified: October 2026
  * @see https://learnopengl.com/Getting-started/Transformations
  */
 
 #include <learnopengl/shader_m.h>
+#include <learnopengl/gl_state.h>
 
 // compile shader program on the fly
 Shader::Shader(const char* vertexPath, const char* fragmentPath) {
@@ -60,57 +61,63 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
 		glGetProgramInfoLog(id, 512, nullptr, infoLog);
 		std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
 	}
+	uniforms.reflect(id);
 	glDeleteShader(vertex);
 	glDeleteShader(fragment);
 }
 
-Shader::~Shader() { glDeleteProgram(id); }
+Shader::~Shader() {
+	GLState::forgetProgram(id);
+	glDeleteProgram(id);
+}
+
+void Shader::use() { GLState::useProgram(id); }
 
-void Shader::use() { glUseProgram(id); }
+int Shader::getUniformLocation(UniformName name) const { return uniforms.getLocation(name); }
 
-void Shader::setBool(const std::string& name, bool value) const {
-	glUniform1i(glGetUniformLocation(id, name.c_str()), (int)value);
+void Shader::setBool(UniformName name, bool value) const {
+	glUniform1i(uniforms.getLocation(name), (int)value);
 }
 
-void Shader::setInt(const std::string& name, int value) const {
-	glUniform1i(glGetUniformLocation(id, name.c_str()), value);
+void Shader::setInt(UniformName name, int value) const {
+	glUniform1i(uniforms.getLocation(name), value);
 }
 
-void Shader::setFloat(const std::string& name, float value) const {
-	glUniform1f(glGetUniformLocation(id, name.c_str()), value);
+void Shader::setFloat(UniformName name, float value) const {
+	glUniform1f(uniforms.getLocation(name), value);
 }
 
-void Shader::setVec2(const std::string& name, const glm::vec2& value) const {
-	glUniform2fv(glGetUniformLocation(id, name.c_str()), 1, &value[0]);
+void Shader::setVec2(UniformName name, const glm::vec2& value) const {
+	glUniform2fv(uniforms.getLocation(name), 1, &value[0]);
 }
 
-void Shader::setVec2(const std::string& name, float x, float y) const {
-	glUniform2f(glGetUniformLocation(id, name.c_str()), x, y);
+void Shader::setVec2(UniformName name, float x, float y) const {
+	glUniform2f(uniforms.getLocation(name), x, y);
 }
-void Shader::setVec3(const std::string& name, const glm::vec3& value) const {
-	glUniform3fv(glGetUniformLocation(id, name.c_str()), 1, &value[0]);
+void Shader::setVec3(UniformName name, const glm::vec3& value) const {
+	glUniform3fv(uniforms.getLocation(name), 1, &value[0]);
 }
 
-void Shader::setVec3(const std::string& name, float x, float y, float z) const {
-	glUniform3f(glGetUniformLocation(id, name.c_str()), x, y, z);
+void Shader::setVec3(UniformName name, float x, float y, float z) const {
+	glUniform3f(uniforms.getLocation(name), x, y, z);
 }
 
-void Shader::setVec4(const std::string& name, const glm::vec4& value) const {
-	glUniform4fv(glGetUniformLocation(id, name.c_str()), 1, &value[0]);
+void Shader::setVec4(UniformName name, const glm::vec4& value) const {
+	glUniform4fv(uniforms.getLocation(name), 1, &value[0]);
 }
 
-void Shader::setVec4(const std::string& name, float x, float y, float z, float w) const {
-	glUniform4f(glGetUniformLocation(id, name.c_str()), x, y, z, w);
+void Shader::setVec4(UniformName name, float x, float y, float z, float w) const {
+	glUniform4f(uniforms.getLocation(name), x, y, z, w);
 }
 
-void Shader::setMat2(const std::string& name, const glm::mat2& mat) const {
-	glUniformMatrix2fv(glGetUniformLocation(id, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+void Shader::setMat2(UniformName name, const glm::mat2& mat) const {
+	glUniformMatrix2fv(uniforms.getLocation(name), 1, GL_FALSE, &mat[0][0]);
 }
 
-void Shader::setMat3(const std::string& name, const glm::mat3& mat) const {
-	glUniformMatrix3fv(glGetUniformLocation(id, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+void Shader::setMat3(UniformName name, const glm::mat3& mat) const {
+	glUniformMatrix3fv(uniforms.getLocation(name), 1, GL_FALSE, &mat[0][0]);
 }
 
-void Shader::setMat4(const std::string& name, const glm::mat4& mat) const {
-	glUniformMatrix4fv(glGetUniformLocation(id, name.c_str()), 1, GL_FALSE, &mat[0][0]);
+void Shader::setMat4(UniformName name, const glm::mat4& mat) const {
+	glUniformMatrix4fv(uniforms.getLocation(name), 1, GL_FALSE, &mat[0][0]);
 }
@@ -0,0 +1,108 @@
+/**
+ * @file shader_preprocessor.cpp
+ * @brief GLSL #include expansion and define injection
+ * @date October 2026
+ */
+
+#include <learnopengl/shader_preprocessor.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+std::vector<std::string> ShaderPreprocessor::includeDirectories(1, "include/");
+
+bool ShaderPreprocessor::process(const std::string& path, const ShaderDefines& defines, std::string& output, std::vector<std::string>* dependencies) {
+	std::vector<std::string> included;
+	output.clear();
+	bool success = expand(path, output, included, 0);
+	if (dependencies)
+		dependencies->swap(included);
+	if (!success || defines.empty())
+		return success;
+
+	// defines go directly after #version, which must stay the first directive
+	std::size_t version = output.find("#version");
+	std::size_t insertAt = version == std::string::npos ? 0 : output.find('\n', version);
+	insertAt = insertAt == std::string::npos ? output.size() : insertAt + 1;
+	unsigned int nextLine = static_cast<unsigned int>(std::count(output.begin(), output.begin() + insertAt, '\n')) + 1;
+	std::string block;
+	if (insertAt == output.size() && !output.empty() && output.back() != '\n')
+		block += '\n';
+	for (const std::pair<std::string, std::string>& define : defines)
+		block += "#define " + define.first + ' ' + define.second + '\n';
+	block += "#line " + std::to_string(nextLine) + " 0\n";
+	output.insert(insertAt, block);
+	return true;
+}
+
+std::string ShaderPreprocessor::variantKey(const ShaderDefines& defines) {
+	ShaderDefines sorted(defines);
+	std::sort(sorted.begin(), sorted.end());
+	std::string key;
+	for (const std::pair<std::string, std::string>& define : sorted)
+		key += define.first + '=' + define.second + ';';
+	return key;
+}
+
+void ShaderPreprocessor::addIncludeDirectory(const std::string& directory) {
+	if (directory.empty() || directory.back() == '/')
+		includeDirectories.push_back(directory);
+	else
+		includeDirectories.push_back(directory + '/');
+}
+
+bool ShaderPreprocessor::expand(const std::string& path, std::string& output, std::vector<std::string>& included, unsigned int depth) {
+	if (depth > MAX_INCLUDE_DEPTH) {
+		std::cout << "ERROR::SHADER::INCLUDE_DEPTH_EXCEEDED " << path << std::endl;
+		return false;
+	}
+	std::ifstream file(path);
+	if (!file) {
+		std::cout << "ERROR::SHADER::FILE_NOT_SUCCESSFULLY_READ\n" << path << std::endl;
+		return false;
+	}
+	const std::string fileIndex = std::to_string(included.size());
+	included.push_back(path);
+	std::size_t slash = path.find_last_of("/\\");
+	std::string directory = slash == std::string::npos ? std::string() : path.substr(0, slash + 1);
+
+	std::string line;
+	unsigned int lineNumber = 0;
+	while (std::getline(file, line)) {
+		lineNumber++;
+		std::size_t start = line.find_first_not_of(" \t");
+		if (start == std::string::npos || line.compare(start, 8, "#include")) {
+			output += line;
+			output += '\n';
+			continue;
+		}
+		std::size_t open = line.find_first_of("\"<", start + 8);
+		std::size_t close = open == std::string::npos ? open : line.find_first_of("\">", open + 1);
+		if (close == std::string::npos) {
+			std::cout << "ERROR::SHADER::MALFORMED_INCLUDE " << path << ':' << lineNumber << std::endl;
+			return false;
+		}
+		std::string includePath = resolveInclude(directory, line.substr(open + 1, close - open - 1), line[open] == '<');
+		if (includePath.empty()) {
+			std::cout << "ERROR::SHADER::INCLUDE_NOT_FOUND " << path << ':' << lineNumber << std::endl;
+			return false;
+		}
+		// every file is expanded once, which also breaks include cycles
+		if (std::find(included.begin(), included.end(), includePath) == included.end()) {
+			output += "#line 1 " + std::to_string(included.size()) + '\n';
+			if (!expand(includePath, output, included, depth + 1))
+				return false;
+		}
+		output += "#line " + std::to_string(lineNumber + 1) + ' ' + fileIndex + '\n';
+	}
+	return true;
+}
+
+std::string ShaderPreprocessor::resolveInclude(const std::string& directory, const std::string& name, bool angled) {
+	if (!angled && std::ifstream(directory + name))
+		return directory + name;
+	for (const std::string& includeDirectory : includeDirectories)
+		if (std::ifstream(includeDirectory + name))
+			return includeDirectory + name;
+	return std::string();
+}
@@ -1,11 +1,12 @@
 /**
  * @file shader_s.cpp
  * @brief Shader class
- * @date Created: July 2023 | Last modified: November 2024
+ * @date Created: July 2023 | Last modified: October 2026
  * @see https://learnopengl.com/Getting-started/Shaders
  */
 
 #include <learnopengl/shader_s.h>
+#include <learnopengl/gl_state.h>
 
 Shader::Shader(const char* vertexPath, const char* fragmentPath) {
 	// read shaders from file
@@ -59,26 +60,32 @@ Shader::Shader(const char* vertexPath, const char* fragmentPath) {
 		glGetProgramInfoLog(id, 512, nullptr, infoLog);
 		std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
 	}
+	uniforms.reflect(id);
 	glDeleteShader(vertex);
 	glDeleteShader(fragment);
 }
 
 void Shader::use() {
-	glUseProgram(id);
+	GLState::useProgram(id);
 }
 
-void Shader::setBool(const std::string& name, bool value) const {
-	glUniform1i(glGetUniformLocation(id, name.c_str()), static_cast<int>(value));
+int Shader::getUniformLocation(UniformName name) const {
+	return uniforms.getLocation(name);
 }
 
-void Shader::setInt(const std::string& name, int value) const {
-	glUniform1i(glGetUniformLocation(id, name.c_str()), value);
+void Shader::setBool(UniformName name, bool value) const {
+	glUniform1i(uniforms.getLocation(name), static_cast<int>(value));
 }
 
-void Shader::setFloat(const std::string& name, float value) const {
-	glUniform1f(glGetUniformLocation(id, name.c_str()), value);
+void Shader::setInt(UniformName name, int value) const {
+	glUniform1i(uniforms.getLocation(name), value);
+}
+
+void Shader::setFloat(UniformName name, float value) const {
+	glUniform1f(uniforms.getLocation(name), value);
 }
 
 Shader::~Shader() {
+	GLState::forgetProgram(id);
 	glDeleteProgram(id);
 }
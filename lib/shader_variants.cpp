@@ -0,0 +1,20 @@
+/**
+ * @file shader_variants.cpp
+ * @brief Cache of define-based shader program variants
+ * @date October 2026
+ */
+
+#include <learnopengl/shader_variants.h>
+
+ShaderVariants::ShaderVariants(const char* vertexPath, const char* fragmentPath, const char* geometryPath)
+	: vertexPath(vertexPath), fragmentPath(fragmentPath), geometryPath(geometryPath ? geometryPath : "") {}
+
+Shader& ShaderVariants::get(const ShaderDefines& defines) {
+	std::unique_ptr<Shader>& variant = variants[ShaderPreprocessor::variantKey(defines)];
+	if (!variant)
+		variant.reset(new Shader(vertexPath.c_str(), fragmentPath.c_str(), defines,
+			geometryPath.empty() ? nullptr : geometryPath.c_str()));
+	return *variant;
+}
+
+std::size_t ShaderVariants::size() const { return variants.size(); }
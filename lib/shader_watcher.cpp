@@ -0,0 +1,229 @@
+/**
+ * @file shader_watcher.cpp
+ * @brief Shader hot-reloading through a background file watcher
+ * @date October 2026
+ */
+
+#include <learnopengl/shader_watcher.h>
+#include <chrono>
+#include <sys/stat.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+static const GLenum STAGES[3] = { GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, GL_GEOMETRY_SHADER };
+// editors often save in several steps, wait this long before reading a changed file
+static const std::chrono::milliseconds SETTLE_TIME(50);
+static const std::chrono::milliseconds POLL_INTERVAL(250);
+
+ShaderWatcher::ShaderWatcher() : running(true), inotifyFd(-1) {
+#ifdef __linux__
+	inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotifyFd < 0)
+		std::cout << "ERROR::SHADER_WATCHER::INOTIFY_UNAVAILABLE, falling back to polling" << std::endl;
+#endif
+	worker = std::thread(&ShaderWatcher::run, this);
+}
+
+ShaderWatcher::~ShaderWatcher() {
+	running = false;
+	worker.join();
+#ifdef __linux__
+	if (inotifyFd >= 0)
+		close(inotifyFd);
+#endif
+}
+
+void ShaderWatcher::watch(Shader& shader) {
+	Entry entry;
+	entry.shader = &shader;
+	entry.dirty = false;
+	for (unsigned int i = 0; i < 3; i++)
+		entry.stagePaths[i] = shader.getSourcePath(STAGES[i]);
+	entry.defines = shader.getDefines();
+	// preprocess once to find the included files
+	std::string sources[3];
+	Shader::loadSources(entry.stagePaths, entry.defines, sources, &entry.dependencies);
+	for (const std::string& path : entry.dependencies) {
+		entry.timestamps.push_back(getTimestamp(path));
+		addDirectoryWatch(path);
+	}
+	std::lock_guard<std::mutex> lock(entriesMutex);
+	entries.push_back(entry);
+}
+
+void ShaderWatcher::unwatch(Shader& shader) {
+	{
+		std::lock_guard<std::mutex> lock(entriesMutex);
+		for (std::size_t i = 0; i < entries.size(); )
+			if (entries[i].shader == &shader)
+				entries.erase(entries.begin() + i);
+			else
+				i++;
+	}
+	std::lock_guard<std::mutex> lock(pendingMutex);
+	for (std::size_t i = 0; i < pending.size(); )
+		if (pending[i].shader == &shader)
+			pending.erase(pending.begin() + i);
+		else
+			i++;
+}
+
+void ShaderWatcher::update() {
+	std::vector<Pending> ready;
+	{
+		// never stall the frame on the watcher thread, just try again next frame
+		std::unique_lock<std::mutex> lock(pendingMutex, std::try_to_lock);
+		if (!lock.owns_lock() || pending.empty())
+			return;
+		ready.swap(pending);
+	}
+	for (Pending& program : ready) {
+		{
+			// skip shaders unwatched after their sources were read
+			std::lock_guard<std::mutex> lock(entriesMutex);
+			bool watched = false;
+			for (const Entry& entry : entries)
+				watched |= entry.shader == program.shader;
+			if (!watched)
+				continue;
+		}
+		if (program.shader->reload(program.sources[0], program.sources[1], program.sources[2]))
+			std::cout << "SHADER_WATCHER::RELOADED " << program.shader->getSourcePath(GL_FRAGMENT_SHADER) << std::endl;
+		else
+			std::cout << "SHADER_WATCHER::RELOAD_FAILED, keeping previous program" << std::endl;
+	}
+}
+
+void ShaderWatcher::run() {
+	while (running) {
+		if (!waitForChanges())
+			continue;
+		std::this_thread::sleep_for(SETTLE_TIME);
+		waitForChanges();
+		// take the changed programs, then read their sources without holding any lock
+		std::vector<Entry> changed;
+		{
+			std::lock_guard<std::mutex> lock(entriesMutex);
+			for (Entry& entry : entries) {
+				if (!entry.dirty)
+					continue;
+				entry.dirty = false;
+				changed.push_back(entry);
+			}
+		}
+		for (const Entry& entry : changed) {
+			Pending program;
+			program.shader = entry.shader;
+			std::vector<std::string> dependencies;
+			if (!Shader::loadSources(entry.stagePaths, entry.defines, program.sources, &dependencies))
+				continue;
+			// an edit may have added or removed #include directives
+			if (dependencies != entry.dependencies)
+				setDependencies(entry.shader, dependencies);
+			std::lock_guard<std::mutex> lock(pendingMutex);
+			bool replaced = false;
+			for (Pending& queued : pending) {
+				if (queued.shader == program.shader) {
+					queued = program;
+					replaced = true;
+				}
+			}
+			if (!replaced)
+				pending.push_back(program);
+		}
+	}
+}
+
+bool ShaderWatcher::waitForChanges() {
+	bool changed = false;
+#ifdef __linux__
+	if (inotifyFd >= 0) {
+		pollfd descriptor = { inotifyFd, POLLIN, 0 };
+		if (poll(&descriptor, 1, 100) <= 0)
+			return false;
+		alignas(inotify_event) char buffer[4096];
+		ssize_t length;
+		while ((length = read(inotifyFd, buffer, sizeof(buffer))) > 0) {
+			for (char* ptr = buffer; ptr < buffer + length; ) {
+				const inotify_event* event = reinterpret_cast<const inotify_event*>(ptr);
+				ptr += sizeof(inotify_event) + event->len;
+				if (!event->len)
+					continue;
+				std::string directory;
+				{
+					std::lock_guard<std::mutex> lock(entriesMutex);
+					for (const std::pair<int, std::string>& watched : watchedDirectories)
+						if (watched.first == event->wd)
+							directory = watched.second;
+				}
+				markChanged(directory.empty() ? std::string(event->name) : directory + '/' + event->name);
+				changed = true;
+			}
+		}
+		return changed;
+	}
+#endif
+	std::this_thread::sleep_for(POLL_INTERVAL);
+	std::lock_guard<std::mutex> lock(entriesMutex);
+	for (Entry& entry : entries) {
+		for (std::size_t i = 0; i < entry.dependencies.size(); i++) {
+			long long timestamp = getTimestamp(entry.dependencies[i]);
+			if (timestamp != entry.timestamps[i]) {
+				entry.timestamps[i] = timestamp;
+				entry.dirty = true;
+				changed = true;
+			}
+		}
+	}
+	return changed;
+}
+
+void ShaderWatcher::markChanged(const std::string& path) {
+	std::lock_guard<std::mutex> lock(entriesMutex);
+	for (Entry& entry : entries)
+		for (const std::string& watched : entry.dependencies)
+			if (watched == path)
+				entry.dirty = true;
+}
+
+void ShaderWatcher::addDirectoryWatch(const std::string& path) {
+#ifdef __linux__
+	if (inotifyFd < 0)
+		return;
+	// watch the directory rather than the file, editors commonly save by replacing the file
+	std::size_t slash = path.find_last_of('/');
+	std::string directory = slash == std::string::npos ? std::string() : path.substr(0, slash);
+	std::lock_guard<std::mutex> lock(entriesMutex);
+	for (const std::pair<int, std::string>& watched : watchedDirectories)
+		if (watched.second == directory)
+			return;
+	int wd = inotify_add_watch(inotifyFd, directory.empty() ? "." : directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+	if (wd >= 0)
+		watchedDirectories.push_back(std::make_pair(wd, directory));
+#endif
+}
+
+void ShaderWatcher::setDependencies(Shader* shader, const std::vector<std::string>& dependencies) {
+	std::vector<long long> timestamps;
+	for (const std::string& path : dependencies) {
+		timestamps.push_back(getTimestamp(path));
+		addDirectoryWatch(path);
+	}
+	std::lock_guard<std::mutex> lock(entriesMutex);
+	for (Entry& entry : entries) {
+		if (entry.shader == shader) {
+			entry.dependencies = dependencies;
+			entry.timestamps = timestamps;
+		}
+	}
+}
+
+long long ShaderWatcher::getTimestamp(const std::string& path) {
+	struct stat info;
+	if (stat(path.c_str(), &info))
+		return 0;
+	return static_cast<long long>(info.st_mtime);
+}
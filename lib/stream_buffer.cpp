@@ -0,0 +1,118 @@
+/**
+ * @file stream_buffer.cpp
+ * @brief Fenced ring buffer for data rewritten every frame
+ * @date October 2026
+ */
+
+#include <learnopengl/stream_buffer.h>
+#include <learnopengl/gl_extensions.h>
+#include <learnopengl/gl_state.h>
+#include <cstring>
+#include <utility>
+
+// nanoseconds per glClientWaitSync attempt
+static const GLuint64 FENCE_TIMEOUT = 1000000000;
+
+StreamBuffer::StreamBuffer(GLenum target, std::size_t regionSize)
+	: target(target), buffer(0), mapping(nullptr), regionSize(regionSize ? regionSize : ALIGNMENT), region(0), cursor(0), fences() {}
+
+StreamBuffer::StreamBuffer(StreamBuffer&& other) noexcept
+	: target(other.target), buffer(other.buffer), mapping(other.mapping), regionSize(other.regionSize), region(other.region),
+	cursor(other.cursor) {
+	for (unsigned int i = 0; i < NUM_REGIONS; i++) {
+		fences[i] = other.fences[i];
+		other.fences[i] = nullptr;
+	}
+	other.buffer = 0;
+	other.mapping = nullptr;
+}
+
+StreamBuffer& StreamBuffer::operator=(StreamBuffer&& other) noexcept {
+	std::swap(target, other.target);
+	std::swap(buffer, other.buffer);
+	std::swap(mapping, other.mapping);
+	std::swap(regionSize, other.regionSize);
+	std::swap(region, other.region);
+	std::swap(cursor, other.cursor);
+	std::swap(fences, other.fences);
+	return *this;
+}
+
+StreamBuffer::~StreamBuffer() {
+	destroy();
+}
+
+std::size_t StreamBuffer::write(const void* data, std::size_t size) {
+	std::size_t aligned = (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+	if (!buffer || aligned > regionSize) {
+		std::size_t newSize = regionSize;
+		while (newSize < aligned)
+			newSize *= 2;
+		destroy();
+		create(newSize);
+	}
+	GLState::bindBuffer(target, buffer);
+	if (cursor + aligned > (region + 1) * regionSize)
+		advance();
+	std::size_t offset = cursor;
+	cursor += aligned;
+	if (mapping)
+		std::memcpy(mapping + offset, data, size);
+	else {
+		// the fences already guarantee the GPU is done with this range
+		void* destination = glMapBufferRange(target, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT
+			| GL_MAP_UNSYNCHRONIZED_BIT);
+		if (destination) {
+			std::memcpy(destination, data, size);
+			glUnmapBuffer(target);
+		} else
+			glBufferSubData(target, offset, size, data);
+	}
+	return offset;
+}
+
+GLuint StreamBuffer::getBuffer() const {
+	return buffer;
+}
+
+void StreamBuffer::create(std::size_t regionSize) {
+	GLExtensions::load();
+	this->regionSize = regionSize;
+	region = 0;
+	cursor = 0;
+	glGenBuffers(1, &buffer);
+	GLState::bindBuffer(target, buffer);
+	if (GLExtensions::bufferStorage) {
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		// dynamic storage keeps glBufferSubData available should the persistent mapping fail
+		GLExtensions::bufferStorageAllocate(target, NUM_REGIONS * regionSize, nullptr, flags | GL_DYNAMIC_STORAGE_BIT);
+		mapping = static_cast<unsigned char*>(glMapBufferRange(target, 0, NUM_REGIONS * regionSize, flags));
+	} else
+		glBufferData(target, NUM_REGIONS * regionSize, nullptr, GL_STREAM_DRAW);
+}
+
+void StreamBuffer::destroy() {
+	for (GLsync& fence : fences) {
+		if (fence)
+			glDeleteSync(fence);
+		fence = nullptr;
+	}
+	if (!buffer)
+		return;
+	// deleting a buffer the GPU still reads is deferred by the driver, so no wait is needed
+	GLState::forgetBuffer(buffer);
+	glDeleteBuffers(1, &buffer);
+	buffer = 0;
+	mapping = nullptr;
+}
+
+void StreamBuffer::advance() {
+	fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	region = (region + 1) % NUM_REGIONS;
+	cursor = region * regionSize;
+	if (fences[region]) {
+		while (glClientWaitSync(fences[region], GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT) == GL_TIMEOUT_EXPIRED);
+		glDeleteSync(fences[region]);
+		fences[region] = nullptr;
+	}
+}
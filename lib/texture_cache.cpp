@@ -0,0 +1,115 @@
+/**
+ * @file texture_cache.cpp
+ * @brief Process-wide cache of shared, reference-counted textures
+ * @date October 2026
+ */
+
+#include <learnopengl/texture_cache.h>
+#include <learnopengl/file_system.h>
+#include <learnopengl/hash.h>
+#include <GLFW/glfw3.h>
+#include <utility>
+
+std::unordered_map<std::uint64_t, TextureCache::Entry> TextureCache::entries;
+std::unordered_map<std::string, std::uint64_t> TextureCache::contentHashes;
+unsigned long long TextureCache::hits = 0;
+unsigned long long TextureCache::misses = 0;
+
+TextureHandle::TextureHandle() : key(0), id(0) {}
+
+TextureHandle::TextureHandle(std::uint64_t key, unsigned int id) : key(key), id(id) {}
+
+TextureHandle::TextureHandle(const TextureHandle& other) : key(other.key), id(other.id) {
+	if (id)
+		TextureCache::acquire(key);
+}
+
+TextureHandle::TextureHandle(TextureHandle&& other) noexcept : key(other.key), id(other.id) {
+	other.id = 0;
+}
+
+TextureHandle& TextureHandle::operator=(TextureHandle other) {
+	std::swap(key, other.key);
+	std::swap(id, other.id);
+	return *this;
+}
+
+TextureHandle::~TextureHandle() {
+	if (id)
+		TextureCache::release(key);
+}
+
+unsigned int TextureHandle::getID() const {
+	return id;
+}
+
+TextureHandle TextureCache::load(const std::string& path, const TextureOptions& options) {
+	std::string canonical = canonicalPath(path);
+	std::uint64_t key = computeKey(canonical, options);
+	std::unordered_map<std::uint64_t, Entry>::iterator it = entries.find(key);
+	if (it != entries.end()) {
+		hits++;
+		it->second.references++;
+		return TextureHandle(key, it->second.id);
+	}
+	misses++;
+	Entry entry;
+	entry.id = TextureStreamer::load(canonical, options);
+	entry.references = 1;
+	entry.path = canonical;
+	entries[key] = entry;
+	return TextureHandle(key, entry.id);
+}
+
+unsigned long long TextureCache::getHits() {
+	return hits;
+}
+
+unsigned long long TextureCache::getMisses() {
+	return misses;
+}
+
+std::size_t TextureCache::getNumTextures() {
+	return entries.size();
+}
+
+std::size_t TextureCache::getResidentBytes() {
+	std::size_t bytes = 0;
+	for (const std::pair<const std::uint64_t, Entry>& entry : entries)
+		bytes += TextureStreamer::getSize(entry.second.id);
+	return bytes;
+}
+
+void TextureCache::printStats(std::ostream& out) {
+	out << "texture cache: " << entries.size() << " textures, " << hits << " hits, " << misses << " misses, "
+		<< getResidentBytes() / 1024 << " KiB resident" << std::endl;
+}
+
+std::uint64_t TextureCache::computeKey(const std::string& canonical, const TextureOptions& options) {
+	std::unordered_map<std::string, std::uint64_t>::iterator it = contentHashes.find(canonical);
+	if (it == contentHashes.end()) {
+		// a missing file still gets an entry, keyed by its path, so it fails to load only once
+		MappedFile file;
+		std::uint64_t hash = file.open(canonical) ? fnv1a(file.data(), file.size()) : fnv1aString(canonical.c_str());
+		it = contentHashes.insert(std::make_pair(canonical, hash)).first;
+	}
+	// the same image sampled differently is a different texture
+	const GLint fields[] = { options.wrap, options.clampAlpha, options.minFilter, options.magFilter, options.mipmaps,
+		options.flipVertically, options.srgb, options.channels, options.compress, static_cast<GLint>(options.content),
+		static_cast<GLint>(options.mipFilter) };
+	return fnv1a(reinterpret_cast<const char*>(fields), sizeof(fields), it->second);
+}
+
+void TextureCache::acquire(std::uint64_t key) {
+	entries[key].references++;
+}
+
+void TextureCache::release(std::uint64_t key) {
+	std::unordered_map<std::uint64_t, Entry>::iterator it = entries.find(key);
+	if (it == entries.end() || --it->second.references)
+		return;
+	// handles held by objects in main may outlive the context
+	if (glfwGetCurrentContext())
+		TextureStreamer::destroy(it->second.id);
+	entries.erase(it);
+}
@@ -0,0 +1,638 @@
+/**
+ * @file texture_compressor.cpp
+ * @brief CPU block compression of textures with a KTX file cache
+ * @date October 2026
+ */
+
+#include <learnopengl/texture_compressor.h>
+#include <learnopengl/texture_streamer.h>
+#include <learnopengl/gl_extensions.h>
+#include <learnopengl/file_system.h>
+#include <learnopengl/hash.h>
+#include <learnopengl/parallel.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXTURE_COMPRESSOR_SSE
+#include <emmintrin.h>
+#endif
+
+std::string TextureCompressor::cacheDirectory = "cache/textures";
+
+namespace {
+
+const unsigned char KTX_IDENTIFIER[12] = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+const std::uint32_t KTX_ENDIANNESS = 0x04030201;
+// key/value entry holding the cache key and the source's component count
+const char KTX_SOURCE_KEY[] = "LearnOpenGL.source";
+
+struct KtxHeader {
+	unsigned char identifier[12];
+	std::uint32_t endianness;
+	std::uint32_t glType;
+	std::uint32_t glTypeSize;
+	std::uint32_t glFormat;
+	std::uint32_t glInternalFormat;
+	std::uint32_t glBaseInternalFormat;
+	std::uint32_t pixelWidth;
+	std::uint32_t pixelHeight;
+	std::uint32_t pixelDepth;
+	std::uint32_t numberOfArrayElements;
+	std::uint32_t numberOfFaces;
+	std::uint32_t numberOfMipmapLevels;
+	std::uint32_t bytesOfKeyValueData;
+};
+
+// BC7 interpolation weights of the 4-bit indices, out of 64
+const int BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+// 128 bits filled from the least significant bit up, as BC7 lays out its fields
+struct BlockBits {
+	std::uint64_t low = 0, high = 0;
+	int position = 0;
+	void write(std::uint32_t value, int count) {
+		for (int i = 0; i < count; i++, position++) {
+			std::uint64_t bit = (value >> i) & 1;
+			if (position < 64)
+				low |= bit << position;
+			else
+				high |= bit << (position - 64);
+		}
+	}
+};
+
+void storeLittleEndian(std::uint64_t value, int bytes, unsigned char* out) {
+	for (int i = 0; i < bytes; i++)
+		out[i] = static_cast<unsigned char>(value >> (8 * i));
+}
+
+// the 16 RGBA pixels of the block at (x, y), replicating edge pixels past the border
+void loadBlock(const unsigned char* rgba, int width, int height, int x, int y, unsigned char block[64]) {
+	for (int row = 0; row < 4; row++) {
+		const unsigned char* source = rgba + static_cast<std::size_t>(std::min(y + row, height - 1)) * width * 4;
+		for (int column = 0; column < 4; column++)
+			std::memcpy(&block[(row * 4 + column) * 4], source + std::min(x + column, width - 1) * 4, 4);
+	}
+}
+
+void blockBounds(const unsigned char block[64], unsigned char low[4], unsigned char high[4]) {
+#ifdef TEXTURE_COMPRESSOR_SSE
+	__m128i p0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+	__m128i p1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 16));
+	__m128i p2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 32));
+	__m128i p3 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + 48));
+	__m128i lowest = _mm_min_epu8(_mm_min_epu8(p0, p1), _mm_min_epu8(p2, p3));
+	__m128i highest = _mm_max_epu8(_mm_max_epu8(p0, p1), _mm_max_epu8(p2, p3));
+	// fold the four pixels of each register onto the first
+	lowest = _mm_min_epu8(lowest, _mm_shuffle_epi32(lowest, _MM_SHUFFLE(1, 0, 3, 2)));
+	lowest = _mm_min_epu8(lowest, _mm_shuffle_epi32(lowest, _MM_SHUFFLE(2, 3, 0, 1)));
+	highest = _mm_max_epu8(highest, _mm_shuffle_epi32(highest, _MM_SHUFFLE(1, 0, 3, 2)));
+	highest = _mm_max_epu8(highest, _mm_shuffle_epi32(highest, _MM_SHUFFLE(2, 3, 0, 1)));
+	int packedLow = _mm_cvtsi128_si32(lowest);
+	int packedHigh = _mm_cvtsi128_si32(highest);
+	std::memcpy(low, &packedLow, 4);
+	std::memcpy(high, &packedHigh, 4);
+#else
+	for (int c = 0; c < 4; c++) {
+		low[c] = high[c] = block[c];
+		for (int i = 1; i < 16; i++) {
+			low[c] = std::min(low[c], block[i * 4 + c]);
+			high[c] = std::max(high[c], block[i * 4 + c]);
+		}
+	}
+#endif
+}
+
+// pull the bounds in by a sixteenth of their range, the extremes are rarely worth an endpoint
+void insetBounds(unsigned char low[4], unsigned char high[4], int channels) {
+	for (int c = 0; c < channels; c++) {
+		int inset = (high[c] - low[c]) >> 4;
+		low[c] = static_cast<unsigned char>(low[c] + inset);
+		high[c] = static_cast<unsigned char>(high[c] - inset);
+	}
+}
+
+// swap the bounds of channels falling while the widest one rises, so the line from low to high follows the pixels
+void alignDiagonal(const unsigned char block[64], unsigned char low[4], unsigned char high[4], int channels) {
+	int reference = 0;
+	for (int c = 1; c < channels; c++)
+		if (high[c] - low[c] > high[reference] - low[reference])
+			reference = c;
+	for (int c = 0; c < channels; c++) {
+		if (c == reference)
+			continue;
+		int covariance = 0;
+		for (int i = 0; i < 16; i++)
+			covariance += (2 * block[i * 4 + reference] - low[reference] - high[reference]) * (2 * block[i * 4 + c] - low[c] - high[c]);
+		if (covariance < 0)
+			std::swap(low[c], high[c]);
+	}
+}
+
+int squaredDistance(const unsigned char* pixel, const int* color, int channels) {
+	int distance = 0;
+	for (int c = 0; c < channels; c++)
+		distance += (pixel[c] - color[c]) * (pixel[c] - color[c]);
+	return distance;
+}
+
+std::uint16_t to565(const float* color) {
+	int r = static_cast<int>(std::min(std::max(color[0], 0.0f), 255.0f) * 31.0f / 255.0f + 0.5f);
+	int g = static_cast<int>(std::min(std::max(color[1], 0.0f), 255.0f) * 63.0f / 255.0f + 0.5f);
+	int b = static_cast<int>(std::min(std::max(color[2], 0.0f), 255.0f) * 31.0f / 255.0f + 0.5f);
+	return static_cast<std::uint16_t>(r << 11 | g << 5 | b);
+}
+
+void from565(std::uint16_t packed, int* color) {
+	int r = packed >> 11, g = (packed >> 5) & 63, b = packed & 31;
+	color[0] = r << 3 | r >> 2;
+	color[1] = g << 2 | g >> 4;
+	color[2] = b << 3 | b >> 2;
+}
+
+// nearest of the four-color palette for every pixel, returns the summed squared error
+int selectBC1Indices(const unsigned char block[64], std::uint16_t color0, std::uint16_t color1, unsigned char indices[16]) {
+	int palette[4][3];
+	from565(color0, palette[0]);
+	from565(color1, palette[1]);
+	for (int c = 0; c < 3; c++) {
+		palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+		palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+	}
+	int error = 0;
+	for (int i = 0; i < 16; i++) {
+		int best = 0;
+		int bestDistance = squaredDistance(&block[i * 4], palette[0], 3);
+		for (int j = 1; j < 4; j++) {
+			int distance = squaredDistance(&block[i * 4], palette[j], 3);
+			if (distance < bestDistance) {
+				best = j;
+				bestDistance = distance;
+			}
+		}
+		indices[i] = static_cast<unsigned char>(best);
+		error += bestDistance;
+	}
+	return error;
+}
+
+// least-squares endpoints for fixed indices, false when every pixel uses the same weight
+bool fitBC1Endpoints(const unsigned char block[64], const unsigned char indices[16], std::uint16_t& color0, std::uint16_t& color1) {
+	// weight of color0 in thirds for each index
+	static const int WEIGHTS[4] = { 3, 0, 2, 1 };
+	float aa = 0.0f, ab = 0.0f, bb = 0.0f;
+	float x[3] = {}, y[3] = {};
+	for (int i = 0; i < 16; i++) {
+		int w = WEIGHTS[indices[i]];
+		aa += static_cast<float>(w * w);
+		ab += static_cast<float>(w * (3 - w));
+		bb += static_cast<float>((3 - w) * (3 - w));
+		for (int c = 0; c < 3; c++) {
+			x[c] += static_cast<float>(w * block[i * 4 + c]);
+			y[c] += static_cast<float>((3 - w) * block[i * 4 + c]);
+		}
+	}
+	float determinant = aa * bb - ab * ab;
+	if (determinant == 0.0f)
+		return false;
+	float a[3], b[3];
+	for (int c = 0; c < 3; c++) {
+		a[c] = 3.0f * (bb * x[c] - ab * y[c]) / determinant;
+		b[c] = 3.0f * (aa * y[c] - ab * x[c]) / determinant;
+	}
+	color0 = to565(a);
+	color1 = to565(b);
+	return true;
+}
+
+void encodeBC1(const unsigned char block[64], const unsigned char boundsLow[4], const unsigned char boundsHigh[4], unsigned char out[8]) {
+	unsigned char low[4], high[4];
+	std::memcpy(low, boundsLow, 4);
+	std::memcpy(high, boundsHigh, 4);
+	insetBounds(low, high, 3);
+	alignDiagonal(block, low, high, 3);
+	float first[3] = { static_cast<float>(high[0]), static_cast<float>(high[1]), static_cast<float>(high[2]) };
+	float second[3] = { static_cast<float>(low[0]), static_cast<float>(low[1]), static_cast<float>(low[2]) };
+	std::uint16_t color0 = to565(first);
+	std::uint16_t color1 = to565(second);
+	unsigned char indices[16];
+	int error = selectBC1Indices(block, color0, color1, indices);
+	// one refinement pass, kept only if it helps
+	std::uint16_t fitted0, fitted1;
+	if (error && fitBC1Endpoints(block, indices, fitted0, fitted1)) {
+		unsigned char fittedIndices[16];
+		if (selectBC1Indices(block, fitted0, fitted1, fittedIndices) < error) {
+			color0 = fitted0;
+			color1 = fitted1;
+			std::memcpy(indices, fittedIndices, 16);
+		}
+	}
+	// color0 > color1 selects the four-color mode; swapping the endpoints swaps index 0 with 1 and 2 with 3
+	if (color0 < color1) {
+		std::swap(color0, color1);
+		for (unsigned char& index : indices)
+			index ^= 1;
+	} else if (color0 == color1)
+		std::memset(indices, 0, 16);
+	std::uint32_t bits = 0;
+	for (int i = 0; i < 16; i++)
+		bits |= static_cast<std::uint32_t>(indices[i]) << (2 * i);
+	storeLittleEndian(color0, 2, out);
+	storeLittleEndian(color1, 2, out + 2);
+	storeLittleEndian(bits, 4, out + 4);
+}
+
+void encodeBC4(const unsigned char block[64], int channel, int low, int high, unsigned char out[8]) {
+	// high > low selects the mode with six interpolated values
+	out[0] = static_cast<unsigned char>(high);
+	out[1] = static_cast<unsigned char>(low);
+	std::uint64_t bits = 0;
+	int range = high - low;
+	if (range > 0) {
+		for (int i = 0; i < 16; i++) {
+			// step 0 is low, 7 is high; index 0 is high, 1 is low and 2-7 run from high towards low
+			int step = ((block[i * 4 + channel] - low) * 14 + range) / (2 * range);
+			int index = step == 7 ? 0 : step == 0 ? 1 : 8 - step;
+			bits |= static_cast<std::uint64_t>(index) << (3 * i);
+		}
+	}
+	storeLittleEndian(bits, 6, out + 2);
+}
+
+// 7-bit endpoint plus the shared low bit closest to color
+void quantizeBC7Endpoint(const unsigned char color[4], int quantized[4], int& pBit) {
+	int bestError = -1;
+	for (int p = 0; p < 2; p++) {
+		int candidate[4];
+		int error = 0;
+		for (int c = 0; c < 4; c++) {
+			candidate[c] = std::min(std::max((color[c] - p + 1) >> 1, 0), 127);
+			int value = candidate[c] << 1 | p;
+			error += (value - color[c]) * (value - color[c]);
+		}
+		if (bestError < 0 || error < bestError) {
+			bestError = error;
+			pBit = p;
+			std::memcpy(quantized, candidate, sizeof(candidate));
+		}
+	}
+}
+
+// mode 6: one subset, RGBA endpoints of 7 bits plus a p-bit each, 4-bit indices
+void encodeBC7(const unsigned char block[64], const unsigned char boundsLow[4], const unsigned char boundsHigh[4], unsigned char out[16]) {
+	unsigned char low[4], high[4];
+	std::memcpy(low, boundsLow, 4);
+	std::memcpy(high, boundsHigh, 4);
+	insetBounds(low, high, 4);
+	alignDiagonal(block, low, high, 4);
+	int endpoints[2][4];
+	int pBits[2];
+	quantizeBC7Endpoint(low, endpoints[0], pBits[0]);
+	quantizeBC7Endpoint(high, endpoints[1], pBits[1]);
+	int palette[16][4];
+	for (int i = 0; i < 16; i++) {
+		for (int c = 0; c < 4; c++) {
+			int first = endpoints[0][c] << 1 | pBits[0];
+			int second = endpoints[1][c] << 1 | pBits[1];
+			palette[i][c] = ((64 - BC7_WEIGHTS[i]) * first + BC7_WEIGHTS[i] * second + 32) >> 6;
+		}
+	}
+	unsigned char indices[16];
+	for (int i = 0; i < 16; i++) {
+		int best = 0;
+		int bestDistance = squaredDistance(&block[i * 4], palette[0], 4);
+		for (int j = 1; j < 16; j++) {
+			int distance = squaredDistance(&block[i * 4], palette[j], 4);
+			if (distance < bestDistance) {
+				best = j;
+				bestDistance = distance;
+			}
+		}
+		indices[i] = static_cast<unsigned char>(best);
+	}
+	// the first index drops its top bit, so it has to be below 8
+	if (indices[0] & 8) {
+		for (int c = 0; c < 4; c++)
+			std::swap(endpoints[0][c], endpoints[1][c]);
+		std::swap(pBits[0], pBits[1]);
+		for (unsigned char& index : indices)
+			index = static_cast<unsigned char>(15 - index);
+	}
+	BlockBits bits;
+	bits.write(1 << 6, 7);
+	for (int c = 0; c < 4; c++) {
+		bits.write(endpoints[0][c], 7);
+		bits.write(endpoints[1][c], 7);
+	}
+	bits.write(pBits[0], 1);
+	bits.write(pBits[1], 1);
+	bits.write(indices[0], 3);
+	for (int i = 1; i < 16; i++)
+		bits.write(indices[i], 4);
+	storeLittleEndian(bits.low, 8, out);
+	storeLittleEndian(bits.high, 8, out + 8);
+}
+
+GLenum getBaseInternalFormat(BlockFormat format) {
+	switch (format) {
+	case BlockFormat::BC1:
+		return GL_RGB;
+	case BlockFormat::BC4:
+		return GL_RED;
+	case BlockFormat::BC5:
+		return GL_RG;
+	default:
+		return GL_RGBA;
+	}
+}
+
+}
+
+std::size_t CompressedImage::getSize() const {
+	std::size_t size = 0;
+	for (const Level& level : levels)
+		size += level.data.size();
+	return size;
+}
+
+bool TextureCompressor::isSupported(BlockFormat format) {
+	switch (format) {
+	case BlockFormat::BC1:
+	case BlockFormat::BC3:
+		return GLExtensions::textureCompressionS3TC;
+	case BlockFormat::BC4:
+	case BlockFormat::BC5:
+		return true;
+	case BlockFormat::BC7:
+		return GLExtensions::textureCompressionBPTC;
+	default:
+		return false;
+	}
+}
+
+BlockFormat TextureCompressor::chooseFormat(const unsigned char* pixels, int width, int height, int components,
+	const TextureOptions& options) {
+	if (options.content == TextureContent::NORMAL_MAP)
+		return BlockFormat::BC5;
+	if (options.content == TextureContent::HEIGHT_MAP || components == 1)
+		return BlockFormat::BC4;
+	if (components == 2)
+		return BlockFormat::BC5;
+	bool grey = true;
+	bool alpha = false;
+	std::size_t numPixels = static_cast<std::size_t>(width) * height;
+	for (std::size_t i = 0; i < numPixels; i++) {
+		const unsigned char* pixel = pixels + i * components;
+		grey = grey && pixel[0] == pixel[1] && pixel[1] == pixel[2];
+		alpha = alpha || (components == 4 && pixel[3] != 255);
+	}
+	if (alpha)
+		return isSupported(BlockFormat::BC7) ? BlockFormat::BC7 : isSupported(BlockFormat::BC3) ? BlockFormat::BC3 : BlockFormat::NONE;
+	// BC4 has no sRGB variant
+	if (grey && !options.srgb)
+		return BlockFormat::BC4;
+	return isSupported(BlockFormat::BC1) ? BlockFormat::BC1 : isSupported(BlockFormat::BC7) ? BlockFormat::BC7 : BlockFormat::NONE;
+}
+
+CompressedImage TextureCompressor::compress(const unsigned char* pixels, int width, int height, int components, BlockFormat format,
+	bool srgb, bool mipmaps, MipFilter filter) {
+	CompressedImage image;
+	image.format = format;
+	image.srgb = srgb;
+	image.components = components;
+	std::vector<unsigned char> rgba = toRGBA(pixels, width, height, components);
+	while (true) {
+		CompressedImage::Level level;
+		level.width = width;
+		level.height = height;
+		std::size_t blocks = static_cast<std::size_t>((width + 3) / 4) * ((height + 3) / 4);
+		level.data.resize(blocks * getBlockSize(format));
+		encodeLevel(rgba.data(), width, height, format, level.data.data());
+		image.levels.push_back(std::move(level));
+		if (!mipmaps || (width == 1 && height == 1))
+			break;
+		rgba = MipGenerator::downsample(rgba.data(), width, height, 4, srgb, filter);
+		width = std::max(width / 2, 1);
+		height = std::max(height / 2, 1);
+	}
+	return image;
+}
+
+std::uint64_t TextureCompressor::computeKey(const char* source, std::size_t size, const TextureOptions& options) {
+	// the chosen format depends on what the driver supports
+	const std::uint32_t fields[] = { VERSION, options.flipVertically, options.srgb, static_cast<std::uint32_t>(options.channels),
+		static_cast<std::uint32_t>(options.content), options.mipmaps, static_cast<std::uint32_t>(options.mipFilter),
+		GLExtensions::textureCompressionS3TC, GLExtensions::textureCompressionBPTC };
+	return fnv1a(reinterpret_cast<const char*>(fields), sizeof(fields), fnv1a(source, size));
+}
+
+std::string TextureCompressor::getCachePath(const std::string& path) {
+	return cacheDirectory + '/' + toHexString(fnv1a(path.data(), path.size())) + ".ktx";
+}
+
+void TextureCompressor::setCacheDirectory(const std::string& directory) {
+	cacheDirectory = directory;
+}
+
+bool TextureCompressor::readKtx(const std::string& path, std::uint64_t key, CompressedImage& image) {
+	MappedFile file;
+	if (!file.open(path) || file.size() < sizeof(KtxHeader))
+		return false;
+	KtxHeader header;
+	std::memcpy(&header, file.data(), sizeof(header));
+	if (std::memcmp(header.identifier, KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER)) || header.endianness != KTX_ENDIANNESS
+		|| header.numberOfFaces != 1 || header.numberOfArrayElements || header.pixelDepth || !header.numberOfMipmapLevels
+		|| !header.pixelWidth || !header.pixelHeight)
+		return false;
+	image.format = BlockFormat::NONE;
+	const BlockFormat formats[] = { BlockFormat::BC1, BlockFormat::BC3, BlockFormat::BC4, BlockFormat::BC5, BlockFormat::BC7 };
+	for (BlockFormat format : formats) {
+		for (int srgb = 0; srgb < 2; srgb++) {
+			if (getInternalFormat(format, srgb != 0) == header.glInternalFormat) {
+				image.format = format;
+				image.srgb = srgb != 0;
+			}
+		}
+	}
+	if (image.format == BlockFormat::NONE || !isSupported(image.format))
+		return false;
+
+	// the source entry has to name this key
+	std::size_t offset = sizeof(KtxHeader);
+	std::size_t end = offset + header.bytesOfKeyValueData;
+	if (end > file.size())
+		return false;
+	std::string expected = toHexString(key) + ' ';
+	image.components = 0;
+	while (offset + 4 <= end) {
+		std::uint32_t length;
+		std::memcpy(&length, file.data() + offset, 4);
+		offset += 4;
+		if (length > end - offset)
+			return false;
+		const char* entry = file.data() + offset;
+		std::size_t keyLength = sizeof(KTX_SOURCE_KEY);
+		if (length >= keyLength + expected.size() + 1 && !std::memcmp(entry, KTX_SOURCE_KEY, keyLength)
+			&& !std::memcmp(entry + keyLength, expected.data(), expected.size()))
+			image.components = entry[keyLength + expected.size()] - '0';
+		offset += (length + 3) & ~std::size_t(3);
+	}
+	if (image.components < 1 || image.components > 4)
+		return false;
+
+	image.levels.clear();
+	offset = end;
+	std::size_t blockSize = getBlockSize(image.format);
+	for (std::uint32_t i = 0; i < header.numberOfMipmapLevels; i++) {
+		CompressedImage::Level level;
+		level.width = std::max(static_cast<int>(header.pixelWidth >> i), 1);
+		level.height = std::max(static_cast<int>(header.pixelHeight >> i), 1);
+		std::size_t size = static_cast<std::size_t>((level.width + 3) / 4) * ((level.height + 3) / 4) * blockSize;
+		std::uint32_t imageSize;
+		if (offset + 4 > file.size())
+			return false;
+		std::memcpy(&imageSize, file.data() + offset, 4);
+		offset += 4;
+		if (imageSize != size || size > file.size() - offset)
+			return false;
+		level.data.assign(file.data() + offset, file.data() + offset + size);
+		offset += (size + 3) & ~std::size_t(3);
+		image.levels.push_back(std::move(level));
+	}
+	return true;
+}
+
+bool TextureCompressor::writeKtx(const std::string& path, std::uint64_t key, const CompressedImage& image) {
+	if (image.levels.empty())
+		return false;
+	std::string value = toHexString(key) + ' ' + static_cast<char>('0' + image.components);
+	std::string entry(KTX_SOURCE_KEY, sizeof(KTX_SOURCE_KEY));
+	entry += value;
+	entry += '\0';
+	std::uint32_t entryLength = static_cast<std::uint32_t>(entry.size());
+	entry.resize((entry.size() + 3) & ~std::size_t(3), '\0');
+
+	KtxHeader header = {};
+	std::memcpy(header.identifier, KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER));
+	header.endianness = KTX_ENDIANNESS;
+	// compressed data has no type and no client format
+	header.glTypeSize = 1;
+	header.glInternalFormat = getInternalFormat(image.format, image.srgb);
+	header.glBaseInternalFormat = getBaseInternalFormat(image.format);
+	header.pixelWidth = image.levels[0].width;
+	header.pixelHeight = image.levels[0].height;
+	header.numberOfFaces = 1;
+	header.numberOfMipmapLevels = static_cast<std::uint32_t>(image.levels.size());
+	header.bytesOfKeyValueData = static_cast<std::uint32_t>(4 + entry.size());
+
+	std::size_t separator = path.find_last_of('/');
+	if (separator != std::string::npos)
+		makeDirectories(path.substr(0, separator));
+	// write under a temporary name, so another loader never maps a half-written file
+	std::string temporary = path + '.' + toHexString(std::hash<std::thread::id>()(std::this_thread::get_id())) + ".tmp";
+	{
+		std::ofstream out(temporary, std::ios::binary);
+		if (!out) {
+			std::cout << "ERROR::TEXTURE_COMPRESSOR::FILE_NOT_WRITABLE " << path << std::endl;
+			return false;
+		}
+		out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		out.write(reinterpret_cast<const char*>(&entryLength), 4);
+		out.write(entry.data(), entry.size());
+		for (const CompressedImage::Level& level : image.levels) {
+			// block sizes are multiples of 4, no padding needed
+			std::uint32_t imageSize = static_cast<std::uint32_t>(level.data.size());
+			out.write(reinterpret_cast<const char*>(&imageSize), 4);
+			out.write(reinterpret_cast<const char*>(level.data.data()), level.data.size());
+		}
+		if (!out) {
+			std::cout << "ERROR::TEXTURE_COMPRESSOR::FILE_NOT_WRITABLE " << path << std::endl;
+			out.close();
+			std::remove(temporary.c_str());
+			return false;
+		}
+	}
+	// rename does not replace an existing file everywhere
+	std::remove(path.c_str());
+	if (std::rename(temporary.c_str(), path.c_str())) {
+		std::remove(temporary.c_str());
+		return false;
+	}
+	return true;
+}
+
+GLenum TextureCompressor::getInternalFormat(BlockFormat format, bool srgb) {
+	switch (format) {
+	case BlockFormat::BC1:
+		return srgb ? GL_COMPRESSED_SRGB_S3TC_DXT1_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+	case BlockFormat::BC3:
+		return srgb ? GL_COMPRESSED_SRGB_ALPHA_S3TC_DXT5_EXT : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+	case BlockFormat::BC4:
+		return GL_COMPRESSED_RED_RGTC1;
+	case BlockFormat::BC5:
+		return GL_COMPRESSED_RG_RGTC2;
+	case BlockFormat::BC7:
+		return srgb ? GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM : GL_COMPRESSED_RGBA_BPTC_UNORM;
+	default:
+		return GL_NONE;
+	}
+}
+
+std::size_t TextureCompressor::getBlockSize(BlockFormat format) {
+	return format == BlockFormat::BC1 || format == BlockFormat::BC4 ? 8 : 16;
+}
+
+std::vector<unsigned char> TextureCompressor::toRGBA(const unsigned char* pixels, int width, int height, int components) {
+	std::size_t numPixels = static_cast<std::size_t>(width) * height;
+	std::vector<unsigned char> rgba(numPixels * 4);
+	for (std::size_t i = 0; i < numPixels; i++) {
+		const unsigned char* pixel = pixels + i * components;
+		unsigned char* out = &rgba[i * 4];
+		out[0] = pixel[0];
+		out[1] = components == 1 ? pixel[0] : pixel[1];
+		out[2] = components == 1 ? pixel[0] : components == 2 ? 0 : pixel[2];
+		out[3] = components == 4 ? pixel[3] : 255;
+	}
+	return rgba;
+}
+
+void TextureCompressor::encodeLevel(const unsigned char* rgba, int width, int height, BlockFormat format, unsigned char* out) {
+	int blocksX = (width + 3) / 4;
+	int blocksY = (height + 3) / 4;
+	std::size_t blockSize = getBlockSize(format);
+	parallelFor(blocksY, [&](std::size_t by) {
+		unsigned char block[64];
+		unsigned char low[4], high[4];
+		for (int bx = 0; bx < blocksX; bx++) {
+			loadBlock(rgba, width, height, bx * 4, static_cast<int>(by) * 4, block);
+			blockBounds(block, low, high);
+			unsigned char* destination = out + (by * blocksX + bx) * blockSize;
+			switch (format) {
+			case BlockFormat::BC1:
+				encodeBC1(block, low, high, destination);
+				break;
+			case BlockFormat::BC3:
+				encodeBC4(block, 3, low[3], high[3], destination);
+				encodeBC1(block, low, high, destination + 8);
+				break;
+			case BlockFormat::BC4:
+				encodeBC4(block, 0, low[0], high[0], destination);
+				break;
+			case BlockFormat::BC5:
+				encodeBC4(block, 0, low[0], high[0], destination);
+				encodeBC4(block, 1, low[1], high[1], destination + 8);
+				break;
+			case BlockFormat::BC7:
+				encodeBC7(block, low, high, destination);
+				break;
+			default:
+				break;
+			}
+		}
+	});
+}
@@ -0,0 +1,454 @@
+/**
+ * @file texture_streamer.cpp
+ * @brief Asynchronous texture loading through a ring of pixel buffer objects
+ * @date October 2026
+ */
+
+#include <learnopengl/texture_streamer.h>
+#include <learnopengl/file_system.h>
+#include <learnopengl/gl_extensions.h>
+#include <learnopengl/gl_state.h>
+#include <learnopengl/parallel.h>
+#include <stb_image.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+std::size_t TextureStreamer::frameBudget = TextureStreamer::DEFAULT_FRAME_BUDGET;
+GLuint TextureStreamer::ring = 0;
+unsigned char* TextureStreamer::mapping = nullptr;
+GLsync TextureStreamer::fences[TextureStreamer::NUM_SLOTS] = {};
+unsigned int TextureStreamer::nextSlot = 0;
+std::unordered_map<GLuint, std::size_t> TextureStreamer::sizes;
+std::unordered_map<GLuint, unsigned long long> TextureStreamer::destroyed;
+std::mutex TextureStreamer::mutex;
+std::condition_variable TextureStreamer::wake;
+std::condition_variable TextureStreamer::decoded;
+std::deque<TextureStreamer::Job> TextureStreamer::queue;
+std::deque<TextureStreamer::Job> TextureStreamer::ready;
+std::size_t TextureStreamer::outstanding = 0;
+unsigned long long TextureStreamer::nextSerial = 0;
+bool TextureStreamer::stopping = false;
+// defined last so the threads are joined before anything they use is destroyed
+TextureStreamer::Workers TextureStreamer::workers;
+
+static const unsigned char PLACEHOLDER[4] = { 128, 128, 128, 255 };
+// nanoseconds per glClientWaitSync attempt
+static const GLuint64 FENCE_TIMEOUT = 1000000000;
+
+unsigned int TextureStreamer::load(const std::string& path, const TextureOptions& options) {
+	unsigned int texture;
+	glGenTextures(1, &texture);
+	load(texture, path, options);
+	return texture;
+}
+
+void TextureStreamer::load(unsigned int texture, const std::string& path, const TextureOptions& options) {
+	Job job;
+	job.texture = texture;
+	job.target = GL_TEXTURE_2D;
+	job.options = options;
+	job.paths.push_back(path);
+	createPlaceholder(texture, GL_TEXTURE_2D);
+	enqueue(job);
+}
+
+unsigned int TextureStreamer::loadCubemap(const std::vector<std::string>& faces, const TextureOptions& options) {
+	Job job;
+	glGenTextures(1, &job.texture);
+	job.target = GL_TEXTURE_CUBE_MAP;
+	job.options = options;
+	job.paths = faces;
+	createPlaceholder(job.texture, GL_TEXTURE_CUBE_MAP);
+	enqueue(job);
+	return job.texture;
+}
+
+void TextureStreamer::upload(unsigned int texture, int width, int height, int components, const unsigned char* pixels,
+	const TextureOptions& options) {
+	Job job;
+	job.texture = texture;
+	job.target = GL_TEXTURE_2D;
+	job.options = options;
+	Image image;
+	image.decoded = false;
+	image.width = width;
+	image.height = height;
+	image.components = components;
+	image.pixels = nullptr;
+	if (pixels) {
+		std::size_t size = static_cast<std::size_t>(width) * height * components;
+		image.pixels = new unsigned char[size];
+		std::memcpy(image.pixels, pixels, size);
+	}
+	job.images.push_back(image);
+	createPlaceholder(texture, GL_TEXTURE_2D);
+	// through the decode threads for the mip chain
+	enqueue(job);
+}
+
+void TextureStreamer::update() {
+	std::vector<Job> jobs;
+	{
+		// never stall the frame on a decode thread, just try again next frame
+		std::unique_lock<std::mutex> lock(mutex, std::try_to_lock);
+		if (!lock.owns_lock() || ready.empty())
+			return;
+		// whole images only, so a texture never shows a half-uploaded state
+		std::size_t bytes = 0;
+		while (!ready.empty() && (jobs.empty() || bytes + ready.front().getSize() <= frameBudget)) {
+			bytes += ready.front().getSize();
+			jobs.push_back(std::move(ready.front()));
+			ready.pop_front();
+		}
+		outstanding -= jobs.size();
+	}
+	uploadJobs(jobs);
+}
+
+void TextureStreamer::finish() {
+	while (true) {
+		std::vector<Job> jobs;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			decoded.wait(lock, [] { return !ready.empty() || !outstanding; });
+			if (ready.empty())
+				return;
+			jobs.assign(std::make_move_iterator(ready.begin()), std::make_move_iterator(ready.end()));
+			ready.clear();
+			outstanding -= jobs.size();
+		}
+		uploadJobs(jobs);
+	}
+}
+
+void TextureStreamer::setFrameBudget(std::size_t bytes) {
+	frameBudget = bytes;
+}
+
+std::size_t TextureStreamer::getSize(unsigned int texture) {
+	std::unordered_map<GLuint, std::size_t>::const_iterator it = sizes.find(texture);
+	return it == sizes.end() ? 0 : it->second;
+}
+
+void TextureStreamer::destroy(unsigned int texture) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		destroyed[texture] = nextSerial;
+	}
+	sizes.erase(texture);
+	GLState::forgetTexture(texture);
+	glDeleteTextures(1, &texture);
+}
+
+std::size_t TextureStreamer::Job::getSize() const {
+	std::size_t size = 0;
+	for (const Image& image : images) {
+		if (!image.compressed.levels.empty()) {
+			size += image.compressed.getSize();
+			continue;
+		}
+		size += static_cast<std::size_t>(image.width) * image.height * image.components;
+		for (const std::vector<unsigned char>& mip : image.mips)
+			size += mip.size();
+	}
+	return size;
+}
+
+TextureStreamer::Workers::~Workers() {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	wake.notify_all();
+	for (std::thread& thread : threads)
+		thread.join();
+	for (Job& job : queue)
+		release(job);
+	for (Job& job : ready)
+		release(job);
+}
+
+void TextureStreamer::createPlaceholder(GLuint texture, GLenum target) {
+	// no mipmaps, so the single level keeps the texture complete
+	GLState::bindTexture(target, texture);
+	if (target == GL_TEXTURE_CUBE_MAP) {
+		for (unsigned int i = 0; i < 6; i++)
+			glTexImage2D(GL_TEXTURE_CUBE_MAP_POSITIVE_X + i, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, PLACEHOLDER);
+	} else
+		glTexImage2D(target, 0, GL_RGBA, 1, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, PLACEHOLDER);
+	glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+void TextureStreamer::enqueue(Job& job) {
+	// the decode threads pick compressed formats by what the driver supports
+	GLExtensions::load();
+	std::lock_guard<std::mutex> lock(mutex);
+	if (workers.threads.empty()) {
+		// leave a core for the render thread
+		unsigned int count = workerCount() > 1 ? workerCount() - 1 : 1;
+		if (count > MAX_WORKERS)
+			count = MAX_WORKERS;
+		for (unsigned int i = 0; i < count; i++)
+			workers.threads.emplace_back(&TextureStreamer::decode);
+	}
+	job.serial = nextSerial++;
+	outstanding++;
+	queue.push_back(std::move(job));
+	wake.notify_one();
+}
+
+bool TextureStreamer::isDestroyed(const Job& job) {
+	std::unordered_map<GLuint, unsigned long long>::const_iterator it = destroyed.find(job.texture);
+	return it != destroyed.end() && job.serial < it->second;
+}
+
+void TextureStreamer::decode() {
+	std::unique_lock<std::mutex> lock(mutex);
+	while (true) {
+		wake.wait(lock, [] { return stopping || !queue.empty(); });
+		if (stopping)
+			return;
+		Job job = std::move(queue.front());
+		queue.pop_front();
+		lock.unlock();
+		// the flag is per thread, so concurrent jobs cannot affect each other
+		stbi_set_flip_vertically_on_load_thread(job.options.flipVertically);
+		for (const std::string& path : job.paths)
+			job.images.push_back(decodeImage(path, job.options, job.target));
+		if (job.options.mipmaps) {
+			for (Image& image : job.images)
+				if (image.pixels)
+					image.mips = MipGenerator::generate(image.pixels, image.width, image.height, image.components, job.options.srgb,
+						job.options.mipFilter);
+		}
+		lock.lock();
+		ready.push_back(std::move(job));
+		decoded.notify_all();
+	}
+}
+
+TextureStreamer::Image TextureStreamer::decodeImage(const std::string& path, const TextureOptions& options, GLenum target) {
+	Image image;
+	image.decoded = true;
+	image.pixels = nullptr;
+	image.width = image.height = image.components = 0;
+	MappedFile file;
+	if (!file.open(path))
+		return image;
+	bool compress = options.compress && target == GL_TEXTURE_2D;
+	std::string cachePath = TextureCompressor::getCachePath(path);
+	std::uint64_t key = 0;
+	if (compress) {
+		key = TextureCompressor::computeKey(file.data(), file.size(), options);
+		if (TextureCompressor::readKtx(cachePath, key, image.compressed)) {
+			image.width = image.compressed.levels[0].width;
+			image.height = image.compressed.levels[0].height;
+			image.components = image.compressed.components;
+			return image;
+		}
+	}
+	image.pixels = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(file.data()), static_cast<int>(file.size()), &image.width,
+		&image.height, &image.components, options.channels);
+	if (options.channels)
+		image.components = options.channels;
+	if (!image.pixels || !compress)
+		return image;
+	BlockFormat format = TextureCompressor::chooseFormat(image.pixels, image.width, image.height, image.components, options);
+	if (format == BlockFormat::NONE)
+		return image;
+	// only the color formats have sRGB variants
+	bool srgb = options.srgb && (format == BlockFormat::BC1 || format == BlockFormat::BC3 || format == BlockFormat::BC7);
+	image.compressed = TextureCompressor::compress(image.pixels, image.width, image.height, image.components, format, srgb,
+		options.mipmaps, options.mipFilter);
+	stbi_image_free(image.pixels);
+	image.pixels = nullptr;
+	TextureCompressor::writeKtx(cachePath, key, image.compressed);
+	return image;
+}
+
+void TextureStreamer::uploadJobs(std::vector<Job>& jobs) {
+	GLint alignment;
+	glGetIntegerv(GL_UNPACK_ALIGNMENT, &alignment);
+	// rows of 1 and 3 component images are not 4 byte aligned
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	for (Job& job : jobs) {
+		if (!isDestroyed(job))
+			uploadJob(job);
+		release(job);
+	}
+	GLState::bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, alignment);
+}
+
+void TextureStreamer::uploadJob(Job& job) {
+	for (std::size_t i = 0; i < job.images.size(); i++) {
+		if (!job.images[i].pixels && job.images[i].compressed.levels.empty()) {
+			if (job.images[i].decoded)
+				std::cout << "ERROR::TEXTURE::FAILED_TO_LOAD\n" << job.paths[i] << std::endl;
+			// keep the placeholder
+			return;
+		}
+	}
+	const Image& first = job.images.front();
+	const CompressedImage& compressed = first.compressed;
+	GLint swizzle[4] = { GL_RED, GL_GREEN, GL_BLUE, GL_ALPHA };
+	GLint maxLevel = 0;
+	// allocate every level first, a bound unpack buffer would turn the null pointer into an offset
+	GLState::bindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	GLState::bindTexture(job.target, job.texture);
+	GLenum faceTarget = job.target == GL_TEXTURE_CUBE_MAP ? GL_TEXTURE_CUBE_MAP_POSITIVE_X : job.target;
+	if (!compressed.levels.empty()) {
+		// only 2D textures are compressed, and they come with their whole mip chain
+		GLenum internalFormat = TextureCompressor::getInternalFormat(compressed.format, compressed.srgb);
+		for (std::size_t level = 0; level < compressed.levels.size(); level++) {
+			const CompressedImage::Level& data = compressed.levels[level];
+			glCompressedTexImage2D(job.target, static_cast<GLint>(level), internalFormat, data.width, data.height, 0,
+				static_cast<GLsizei>(data.data.size()), nullptr);
+		}
+		maxLevel = static_cast<GLint>(compressed.levels.size() - 1);
+		// grey color kept in the single BC4 channel
+		if (compressed.format == BlockFormat::BC4 && compressed.components >= 3) {
+			swizzle[1] = swizzle[2] = GL_RED;
+			swizzle[3] = GL_ONE;
+		}
+	} else {
+		GLenum format = getFormat(first.components);
+		GLenum internalFormat = format;
+		if (job.options.srgb)
+			internalFormat = first.components == 4 ? GL_SRGB_ALPHA : GL_SRGB;
+		// faces of a cubemap share their size, so every image has as many mips
+		maxLevel = static_cast<GLint>(first.mips.size());
+		for (std::size_t i = 0; i < job.images.size(); i++) {
+			for (GLint level = 0; level <= maxLevel; level++)
+				glTexImage2D(faceTarget + i, level, internalFormat, std::max(job.images[i].width >> level, 1),
+					std::max(job.images[i].height >> level, 1), 0, format, GL_UNSIGNED_BYTE, nullptr);
+		}
+	}
+	if (!ring)
+		createRing();
+	GLState::bindBuffer(GL_PIXEL_UNPACK_BUFFER, ring);
+	if (!compressed.levels.empty())
+		transferCompressed(job.target, compressed);
+	else {
+		GLenum format = getFormat(first.components);
+		for (std::size_t i = 0; i < job.images.size(); i++) {
+			const Image& image = job.images[i];
+			transfer(faceTarget + i, 0, image.pixels, image.width, image.height, image.components, format);
+			for (GLint level = 1; level <= maxLevel; level++)
+				transfer(faceTarget + i, level, image.mips[level - 1].data(), std::max(image.width >> level, 1),
+					std::max(image.height >> level, 1), image.components, format);
+		}
+	}
+
+	GLint wrap = job.options.clampAlpha && first.components == 4 ? GL_CLAMP_TO_EDGE : job.options.wrap;
+	glTexParameteri(job.target, GL_TEXTURE_WRAP_S, wrap);
+	glTexParameteri(job.target, GL_TEXTURE_WRAP_T, wrap);
+	if (job.target == GL_TEXTURE_CUBE_MAP)
+		glTexParameteri(job.target, GL_TEXTURE_WRAP_R, wrap);
+	glTexParameteri(job.target, GL_TEXTURE_MIN_FILTER, job.options.minFilter);
+	glTexParameteri(job.target, GL_TEXTURE_MAG_FILTER, job.options.magFilter);
+	// set even without mips, so a mipmapped min filter still finds the texture complete
+	glTexParameteri(job.target, GL_TEXTURE_MAX_LEVEL, maxLevel);
+	glTexParameteriv(job.target, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+	sizes[job.texture] = job.getSize();
+}
+
+void TextureStreamer::transfer(GLenum target, GLint level, const unsigned char* pixels, int width, int height, int components,
+	GLenum format) {
+	std::size_t rowSize = static_cast<std::size_t>(width) * components;
+	// even a row at the maximum texture size fits a slot many times over
+	int rowsPerSlot = static_cast<int>(SLOT_SIZE / rowSize);
+	for (int row = 0; row < height; row += rowsPerSlot) {
+		int rows = std::min(rowsPerSlot, height - row);
+		std::size_t size = rows * rowSize;
+		unsigned int slot = stage(pixels + row * rowSize, size);
+		std::size_t offset = slot * SLOT_SIZE;
+		glTexSubImage2D(target, level, 0, row, width, rows, format, GL_UNSIGNED_BYTE, reinterpret_cast<const void*>(offset));
+		fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	}
+}
+
+void TextureStreamer::transferCompressed(GLenum target, const CompressedImage& image) {
+	GLenum internalFormat = TextureCompressor::getInternalFormat(image.format, image.srgb);
+	for (std::size_t level = 0; level < image.levels.size(); level++) {
+		const CompressedImage::Level& data = image.levels[level];
+		// rows of 4x4 blocks, sub-images have to start on a block boundary
+		int blockRows = (data.height + 3) / 4;
+		std::size_t rowSize = static_cast<std::size_t>((data.width + 3) / 4) * TextureCompressor::getBlockSize(image.format);
+		int rowsPerSlot = static_cast<int>(SLOT_SIZE / rowSize);
+		for (int row = 0; row < blockRows; row += rowsPerSlot) {
+			int rows = std::min(rowsPerSlot, blockRows - row);
+			std::size_t size = rows * rowSize;
+			unsigned int slot = stage(data.data.data() + row * rowSize, size);
+			std::size_t offset = slot * SLOT_SIZE;
+			glCompressedTexSubImage2D(target, static_cast<GLint>(level), 0, row * 4, data.width, std::min(rows * 4, data.height - row * 4),
+				internalFormat, static_cast<GLsizei>(size), reinterpret_cast<const void*>(offset));
+			fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+		}
+	}
+}
+
+unsigned int TextureStreamer::stage(const unsigned char* data, std::size_t size) {
+	unsigned int slot = acquireSlot();
+	std::size_t offset = slot * SLOT_SIZE;
+	if (mapping)
+		std::memcpy(mapping + offset, data, size);
+	else {
+		// the fence already guarantees the GPU is done with this slot
+		void* destination = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, offset, size,
+			GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT);
+		if (destination) {
+			std::memcpy(destination, data, size);
+			glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+		} else
+			glBufferSubData(GL_PIXEL_UNPACK_BUFFER, offset, size, data);
+	}
+	return slot;
+}
+
+void TextureStreamer::createRing() {
+	GLExtensions::load();
+	glGenBuffers(1, &ring);
+	GLState::bindBuffer(GL_PIXEL_UNPACK_BUFFER, ring);
+	if (GLExtensions::bufferStorage) {
+		const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+		// dynamic storage keeps glBufferSubData available should the persistent mapping fail
+		GLExtensions::bufferStorageAllocate(GL_PIXEL_UNPACK_BUFFER, NUM_SLOTS * SLOT_SIZE, nullptr, flags | GL_DYNAMIC_STORAGE_BIT);
+		mapping = static_cast<unsigned char*>(glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, NUM_SLOTS * SLOT_SIZE, flags));
+	} else
+		glBufferData(GL_PIXEL_UNPACK_BUFFER, NUM_SLOTS * SLOT_SIZE, nullptr, GL_STREAM_DRAW);
+}
+
+unsigned int TextureStreamer::acquireSlot() {
+	unsigned int slot = nextSlot;
+	nextSlot = (nextSlot + 1) % NUM_SLOTS;
+	if (fences[slot]) {
+		// only blocks when a single frame streams more than the whole ring
+		while (glClientWaitSync(fences[slot], GL_SYNC_FLUSH_COMMANDS_BIT, FENCE_TIMEOUT) == GL_TIMEOUT_EXPIRED);
+		glDeleteSync(fences[slot]);
+		fences[slot] = nullptr;
+	}
+	return slot;
+}
+
+void TextureStreamer::release(Job& job) {
+	for (Image& image : job.images) {
+		if (image.decoded)
+			stbi_image_free(image.pixels);
+		else
+			delete[] image.pixels;
+		image.pixels = nullptr;
+	}
+}
+
+GLenum TextureStreamer::getFormat(int components) {
+	if (components == 1)
+		return GL_RED;
+	if (components == 2)
+		return GL_RG;
+	if (components == 3)
+		return GL_RGB;
+	return GL_RGBA;
+}
@@ -0,0 +1,204 @@
+/**
+ * @file uniform_cache.cpp
+ * @brief Uniform location cache implementation
+ * @date October 2026
+ */
+
+#include <learnopengl/uniform_cache.h>
+#include <learnopengl/gl_state.h>
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+#include <utility>
+
+#ifndef NDEBUG
+std::string UniformSpelling::str() const {
+	if (!name)
+		return std::string();
+	std::string spelled = length == std::string::npos ? std::string(name) : std::string(name, length);
+	if (index >= 0)
+		spelled += '[' + std::to_string(index) + ']' + member;
+	return spelled;
+}
+#endif
+
+UniformCache::UniformCache() : count(0) {}
+
+void UniformCache::reflect(unsigned int program) {
+	clear();
+	GLint numUniforms = 0, maxLength = 0;
+	glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &numUniforms);
+	glGetProgramiv(program, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+	if (numUniforms <= 0)
+		return;
+	std::vector<char> name(maxLength + 1);
+	std::string element;
+	for (GLint i = 0; i < numUniforms; i++) {
+		GLsizei length = 0;
+		GLint arraySize = 0;
+		GLenum type;
+		glGetActiveUniform(program, i, maxLength, &length, &arraySize, &type, name.data());
+		// uniforms inside blocks have no location
+		int location = glGetUniformLocation(program, name.data());
+		if (location < 0)
+			continue;
+		insert(name.data(), length, location);
+		// arrays are reported once as "name[0]", so also register "name" and every other element
+		if (length > 3 && !std::strncmp(name.data() + length - 3, "[0]", 3)) {
+			std::string base(name.data(), length - 3);
+			insert(base.data(), base.size(), location);
+			for (GLint j = 1; j < arraySize; j++) {
+				element = base + '[' + std::to_string(j) + ']';
+				int elementLocation = glGetUniformLocation(program, element.c_str());
+				if (elementLocation >= 0)
+					insert(element.data(), element.size(), elementLocation);
+			}
+		}
+	}
+}
+
+void UniformCache::clear() {
+	slots.clear();
+	count = 0;
+}
+
+int UniformCache::getLocation(UniformName name) const {
+	if (slots.empty())
+		return -1;
+	std::size_t mask = slots.size() - 1;
+	for (std::size_t i = name.hash & mask; ; i = (i + 1) & mask) {
+		const Slot& slot = slots[i];
+		if (slot.location == EMPTY)
+			return -1;
+		if (slot.hash == name.hash) {
+#ifndef NDEBUG
+			if (name.spelling.name && name.spelling.str() != slot.name) {
+				std::cout << "ERROR::SHADER::UNIFORM_HASH_COLLISION " << name.spelling.str() << " hashes to " << slot.name << std::endl;
+				return -1;
+			}
+#endif
+			return slot.location;
+		}
+	}
+}
+
+unsigned int UniformCache::size() const { return count; }
+
+void UniformCache::insert(const char* name, std::size_t length, int location) {
+	Slot slot;
+	slot.hash = fnv1a(name, length);
+	slot.location = location;
+#ifndef NDEBUG
+	slot.name.assign(name, length);
+#endif
+	// keep the load factor at or below one half so probe sequences stay short
+	if ((count + 1) * 2 > slots.size())
+		grow();
+	place(std::move(slot));
+}
+
+void UniformCache::place(Slot slot) {
+	std::size_t mask = slots.size() - 1;
+	for (std::size_t i = slot.hash & mask; ; i = (i + 1) & mask) {
+		Slot& existing = slots[i];
+		if (existing.location == EMPTY) {
+			existing = std::move(slot);
+			count++;
+			return;
+		}
+		if (existing.hash == slot.hash) {
+#ifndef NDEBUG
+			if (existing.name != slot.name)
+				std::cout << "ERROR::SHADER::UNIFORM_HASH_COLLISION " << slot.name << " hashes to " << existing.name << std::endl;
+#else
+			if (existing.location != slot.location)
+				std::cout << "ERROR::SHADER::UNIFORM_HASH_COLLISION at location " << slot.location << std::endl;
+#endif
+			return;
+		}
+	}
+}
+
+void UniformCache::grow() {
+	std::vector<Slot> old;
+	old.swap(slots);
+	Slot empty;
+	empty.hash = 0;
+	empty.location = EMPTY;
+	slots.assign(old.empty() ? 16 : old.size() * 2, empty);
+	count = 0;
+	for (Slot& slot : old)
+		if (slot.location != EMPTY)
+			place(std::move(slot));
+}
+
+void UniformCache::copyValues(unsigned int from, unsigned int to) {
+	GLint numUniforms = 0, numSourceUniforms = 0, maxLength = 0, maxSourceLength = 0, previous = 0;
+	glGetProgramiv(to, GL_ACTIVE_UNIFORMS, &numUniforms);
+	glGetProgramiv(to, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+	glGetProgramiv(from, GL_ACTIVE_UNIFORMS, &numSourceUniforms);
+	glGetProgramiv(from, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxSourceLength);
+	if (numUniforms <= 0 || numSourceUniforms <= 0)
+		return;
+	maxLength = std::max(maxLength, maxSourceLength);
+	std::vector<char> name(maxLength + 1);
+	// type and array size of the old program's uniforms, a value is only carried over when both still match
+	std::unordered_map<std::string, std::pair<GLenum, GLint>> sourceTypes;
+	for (GLint i = 0; i < numSourceUniforms; i++) {
+		GLsizei length = 0;
+		GLint arraySize = 0;
+		GLenum type;
+		glGetActiveUniform(from, i, maxLength, &length, &arraySize, &type, name.data());
+		sourceTypes[std::string(name.data(), length)] = std::make_pair(type, arraySize);
+	}
+	glGetIntegerv(GL_CURRENT_PROGRAM, &previous);
+	GLState::useProgram(to);
+	std::string element;
+	GLfloat floats[16];
+	GLint ints[4];
+	GLuint uints[4];
+	for (GLint i = 0; i < numUniforms; i++) {
+		GLsizei length = 0;
+		GLint arraySize = 0;
+		GLenum type;
+		glGetActiveUniform(to, i, maxLength, &length, &arraySize, &type, name.data());
+		std::unordered_map<std::string, std::pair<GLenum, GLint>>::const_iterator sourceType = sourceTypes.find(std::string(name.data(), length));
+		if (sourceType == sourceTypes.end() || sourceType->second != std::make_pair(type, arraySize))
+			continue;
+		bool isArray = length > 3 && !std::strncmp(name.data() + length - 3, "[0]", 3);
+		std::string base(name.data(), isArray ? length - 3 : length);
+		for (GLint j = 0; j < (isArray ? arraySize : 1); j++) {
+			element = isArray ? base + '[' + std::to_string(j) + ']' : base;
+			GLint source = glGetUniformLocation(from, element.c_str());
+			GLint target = glGetUniformLocation(to, element.c_str());
+			if (source < 0 || target < 0)
+				continue;
+			switch (type) {
+				case GL_FLOAT: glGetUniformfv(from, source, floats); glUniform1fv(target, 1, floats); break;
+				case GL_FLOAT_VEC2: glGetUniformfv(from, source, floats); glUniform2fv(target, 1, floats); break;
+				case GL_FLOAT_VEC3: glGetUniformfv(from, source, floats); glUniform3fv(target, 1, floats); break;
+				case GL_FLOAT_VEC4: glGetUniformfv(from, source, floats); glUniform4fv(target, 1, floats); break;
+				case GL_FLOAT_MAT2: glGetUniformfv(from, source, floats); glUniformMatrix2fv(target, 1, GL_FALSE, floats); break;
+				case GL_FLOAT_MAT3: glGetUniformfv(from, source, floats); glUniformMatrix3fv(target, 1, GL_FALSE, floats); break;
+				case GL_FLOAT_MAT4: glGetUniformfv(from, source, floats); glUniformMatrix4fv(target, 1, GL_FALSE, floats); break;
+				case GL_FLOAT_MAT2x3: glGetUniformfv(from, source, floats); glUniformMatrix2x3fv(target, 1, GL_FALSE, floats); break;
+				case GL_FLOAT_MAT2x4: glGetUniformfv(from, source, floats); glUniformMatrix2x4fv(target, 1, GL_FALSE, floats); break;
+				case GL_FLOAT_MAT3x2: glGetUniformfv(from, source, floats); glUniformMatrix3x2fv(target, 1, GL_FALSE, floats); break;
+				case GL_FLOAT_MAT3x4: glGetUniformfv(from, source, floats); glUniformMatrix3x4fv(target, 1, GL_FALSE, floats); break;
+				case GL_FLOAT_MAT4x2: glGetUniformfv(from, source, floats); glUniformMatrix4x2fv(target, 1, GL_FALSE, floats); break;
+				case GL_FLOAT_MAT4x3: glGetUniformfv(from, source, floats); glUniformMatrix4x3fv(target, 1, GL_FALSE, floats); break;
+				case GL_UNSIGNED_INT: glGetUniformuiv(from, source, uints); glUniform1uiv(target, 1, uints); break;
+				case GL_UNSIGNED_INT_VEC2: glGetUniformuiv(from, source, uints); glUniform2uiv(target, 1, uints); break;
+				case GL_UNSIGNED_INT_VEC3: glGetUniformuiv(from, source, uints); glUniform3uiv(target, 1, uints); break;
+				case GL_UNSIGNED_INT_VEC4: glGetUniformuiv(from, source, uints); glUniform4uiv(target, 1, uints); break;
+				case GL_INT_VEC2: case GL_BOOL_VEC2: glGetUniformiv(from, source, ints); glUniform2iv(target, 1, ints); break;
+				case GL_INT_VEC3: case GL_BOOL_VEC3: glGetUniformiv(from, source, ints); glUniform3iv(target, 1, ints); break;
+				case GL_INT_VEC4: case GL_BOOL_VEC4: glGetUniformiv(from, source, ints); glUniform4iv(target, 1, ints); break;
+				// ints, bools and every sampler type
+				default: glGetUniformiv(from, source, ints); glUniform1iv(target, 1, ints); break;
+			}
+		}
+	}
+	GLState::useProgram(previous);
+}
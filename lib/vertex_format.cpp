@@ -0,0 +1,72 @@
+/**
+ * @file vertex_format.cpp
+ * @brief GPU vertex layouts of Mesh
+ * @date October 2026
+ */
+
+#include <learnopengl/vertex_format.h>
+#include <cstddef>
+#include <cstdint>
+
+VertexFormat VertexFormat::compact() {
+	VertexFormat format;
+	format.normals = OCTAHEDRAL_NORMALS;
+	format.halfTexCoords = true;
+	format.quantizedPositions = true;
+	return format;
+}
+
+bool VertexFormat::isCompact() const {
+	return normals != FLOAT_NORMALS || halfTexCoords || quantizedPositions;
+}
+
+unsigned int VertexFormat::getStride() const {
+	// every attribute stays 4-byte aligned, quantized positions carry a padding component
+	return (quantizedPositions ? 8 : 12) + (normals == FLOAT_NORMALS ? 12 : 4) + (halfTexCoords ? 4 : 8);
+}
+
+ShaderDefines VertexFormat::getDefines() const {
+	ShaderDefines defines;
+	if (quantizedPositions)
+		defines.push_back(std::make_pair("QUANTIZED_POSITIONS", "1"));
+	if (normals == OCTAHEDRAL_NORMALS)
+		defines.push_back(std::make_pair("OCTAHEDRAL_NORMALS", "1"));
+	return defines;
+}
+
+unsigned int VertexFormat::getKey() const {
+	return static_cast<unsigned int>(normals) << 2 | static_cast<unsigned int>(halfTexCoords) << 1
+		| static_cast<unsigned int>(quantizedPositions);
+}
+
+void VertexFormat::setupAttributes() const {
+	GLsizei stride = getStride();
+	std::size_t offset = 0;
+	// vertex positions
+	glEnableVertexAttribArray(0);
+	if (quantizedPositions) {
+		glVertexAttribPointer(0, 3, GL_UNSIGNED_SHORT, GL_TRUE, stride, (void*)offset);
+		offset += 4 * sizeof(std::uint16_t);
+	} else {
+		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void*)offset);
+		offset += 3 * sizeof(float);
+	}
+	// vertex normals
+	glEnableVertexAttribArray(1);
+	if (normals == PACKED_NORMALS) {
+		glVertexAttribPointer(1, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, (void*)offset);
+		offset += sizeof(std::uint32_t);
+	} else if (normals == OCTAHEDRAL_NORMALS) {
+		glVertexAttribPointer(1, 2, GL_SHORT, GL_TRUE, stride, (void*)offset);
+		offset += sizeof(std::uint32_t);
+	} else {
+		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void*)offset);
+		offset += 3 * sizeof(float);
+	}
+	// vertex texture coordinates
+	glEnableVertexAttribArray(2);
+	if (halfTexCoords)
+		glVertexAttribPointer(2, 2, GL_HALF_FLOAT, GL_FALSE, stride, (void*)offset);
+	else
+		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void*)offset);
+}
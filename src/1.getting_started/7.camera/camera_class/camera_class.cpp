@@ -253,7 +253,8 @@ int main(void) {
 
 		// camera/view/LookAt transformation
 		glm::mat4 view = camera.getViewMatrix();
-		glm::mat4 projection = glm::perspective(glm::radians(camera.getFOV()), static_cast<float>(SCREEN_WIDTH) / SCREEN_HEIGHT, 0.1f, 100.0f);
+		camera.setPerspective(static_cast<float>(SCREEN_WIDTH) / SCREEN_HEIGHT, 0.1f, 100.0f);
+		glm::mat4 projection = camera.getProjectionMatrix();
 		shader.setMat4("view", view);
 		shader.setMat4("projection", projection);
 
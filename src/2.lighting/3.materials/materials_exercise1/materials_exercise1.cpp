@@ -216,7 +216,8 @@ int main(void) {
 		glm::mat4 model(1.0f);
 		glm::mat4 view = camera.getViewMatrix();
 		glm::mat4 projection(1.0f);
-		projection = glm::perspective(glm::radians(camera.getFOV()), (float)SCREEN_WIDTH / (float)SCREEN_WIDTH, 0.1f, 100.0f);
+		camera.setPerspective((float)SCREEN_WIDTH / (float)SCREEN_WIDTH, 0.1f, 100.0f);
+		projection = camera.getProjectionMatrix();
 		objectShader.use();
 		objectShader.setMat4("model", model);
 		objectShader.setMat4("view", view);
@@ -13,6 +13,7 @@
 #include <stb_image.h>
 #include <learnopengl/shader_m.h>
 #include <learnopengl/camera.h>
+#include <learnopengl/texture_streamer.h>
 #include <iostream>
 
 /**
@@ -217,6 +218,9 @@ int main(void) {
 		// process keyboard input
 		processInput(window);
 
+		// stream in loaded textures
+		TextureStreamer::update();
+
 		// screen color
 		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 
@@ -230,7 +234,8 @@ int main(void) {
 			model = glm::rotate(model, glm::radians(angle), glm::vec3(1.0f, 0.3f, 0.5f));
 			glm::mat4 view = camera.getViewMatrix();
 			glm::mat4 projection(1.0f);
-			projection = glm::perspective(glm::radians(camera.getFOV()), static_cast<float>(SCREEN_WIDTH) / static_cast<float>(SCREEN_WIDTH), 0.1f, 100.0f);
+			camera.setPerspective(static_cast<float>(SCREEN_WIDTH) / static_cast<float>(SCREEN_WIDTH), 0.1f, 100.0f);
+			projection = camera.getProjectionMatrix();
 			objectShader.use();
 			objectShader.setMat4("model", model);
 			objectShader.setMat4("view", view);
@@ -257,37 +262,9 @@ int main(void) {
 }
 
 unsigned int loadTexture(const char* path, bool flipVertically) {
-	unsigned int textureId;
-	glGenTextures(1, &textureId);
-	int width, height, numChannels;
-	stbi_set_flip_vertically_on_load(flipVertically);
-	unsigned char* data = stbi_load(path, &width, &height, &numChannels, 0);
-	if (data) {
-		GLenum format;
-		switch (numChannels) {
-			case 1:
-			//default:
-				format = GL_RED;
-				break;
-			case 3:
-				format = GL_RGB;
-				break;
-			case 4: 
-				format = GL_RGBA;
-				break;
-		}
-		glBindTexture(GL_TEXTURE_2D, textureId);
-		glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-		glGenerateMipmap(GL_TEXTURE_2D);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	} else {
-		std::cout << "ERROR::TEXTURE::FAILED_TO_LOAD\n" << path << std::endl;
-	}
-	stbi_image_free(data);
-	return textureId;
+	TextureOptions options;
+	options.flipVertically = flipVertically;
+	return TextureStreamer::load(path, options);
 }
 
 void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
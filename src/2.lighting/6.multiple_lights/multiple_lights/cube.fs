@@ -36,7 +36,9 @@ struct SpotLight {
 	float quadratic;
 };
 
+#ifndef NUM_POINT_LIGHTS
 #define NUM_POINT_LIGHTS 4
+#endif
 
 in vec3 fragPos;
 in vec3 norm;
@@ -11,8 +11,9 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 #include <stb_image.h>
-#include <learnopengl/shader_m.h>
+#include <learnopengl/shader_g.h>
 #include <learnopengl/camera.h>
+#include <learnopengl/texture_streamer.h>
 #include <iostream>
 
 /**
@@ -187,8 +188,9 @@ int main(void) {
 	glBindBuffer(GL_ARRAY_BUFFER, 0);
 	glBindVertexArray(0);
 
-	// Create shader objects
-	Shader objectShader(CUBE_VERTEX_SHADER, CUBE_FRAGMENT_SHADER);
+	// Create shader objects, the point light count is compiled into the object shader
+	constexpr unsigned int NUM_POINT_LIGHTS = 4;
+	Shader objectShader(CUBE_VERTEX_SHADER, CUBE_FRAGMENT_SHADER, { { "NUM_POINT_LIGHTS", std::to_string(NUM_POINT_LIGHTS) } });
 	Shader lightShader(LIGHT_VERTEX_SHADER, LIGHT_FRAGMENT_SHADER);
 
 	// Load container texture/diffuse map
@@ -196,7 +198,6 @@ int main(void) {
 	unsigned int specularMap = loadTexture(CONTAINER_SPECULAR);
 
 	// Point light positions
-	constexpr unsigned int NUM_POINT_LIGHTS = 4;
 	glm::vec3 pointLightPositions[NUM_POINT_LIGHTS] = {
 		glm::vec3(0.7f,  0.2f,  2.0f),
 		glm::vec3(2.3f, -3.3f, -4.0f),
@@ -232,13 +233,13 @@ int main(void) {
 
 	// Set point light values (that remain constant)
 	for (int i = 0; i < NUM_POINT_LIGHTS; i++) {
-		objectShader.setVec3("pointLights[" + std::to_string(i) + "].position", pointLightPositions[i]);
-		objectShader.setVec3("pointLights[" + std::to_string(i) + "].ambient", 0.2f, 0.2f, 0.2f);
-		objectShader.setVec3("pointLights[" + std::to_string(i) + "].diffuse", 0.5f, 0.5f, 0.5f);
-		objectShader.setVec3("pointLights[" + std::to_string(i) + "].specular", 1.0f, 1.0f, 1.0f);
-		objectShader.setFloat("pointLights[" + std::to_string(i) + "].constant", 1.0f);
-		objectShader.setFloat("pointLights[" + std::to_string(i) + "].linear", 0.09f);
-		objectShader.setFloat("pointLights[" + std::to_string(i) + "].quadratic", 0.032f);
+		objectShader.set(uniformElement<glm::vec3>("pointLights", i, ".position"), pointLightPositions[i]);
+		objectShader.set(uniformElement<glm::vec3>("pointLights", i, ".ambient"), glm::vec3(0.2f, 0.2f, 0.2f));
+		objectShader.set(uniformElement<glm::vec3>("pointLights", i, ".diffuse"), glm::vec3(0.5f, 0.5f, 0.5f));
+		objectShader.set(uniformElement<glm::vec3>("pointLights", i, ".specular"), glm::vec3(1.0f, 1.0f, 1.0f));
+		objectShader.set(uniformElement<float>("pointLights", i, ".constant"), 1.0f);
+		objectShader.set(uniformElement<float>("pointLights", i, ".linear"), 0.09f);
+		objectShader.set(uniformElement<float>("pointLights", i, ".quadratic"), 0.032f);
 	}
 
 	// Set spotlight values (that remain constant)
@@ -261,6 +262,9 @@ int main(void) {
 		// process keyboard input
 		processInput(window);
 
+		// stream in loaded textures
+		TextureStreamer::update();
+
 		// screen color
 		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 
@@ -281,7 +285,8 @@ int main(void) {
 		// render cube objects
 		glm::mat4 model;
 		glm::mat4 view = camera.getViewMatrix();
-		glm::mat4 projection = glm::perspective(glm::radians(camera.getFOV()), static_cast<float>(SCREEN_WIDTH) / static_cast<float>(SCREEN_WIDTH), 0.1f, 100.0f);
+		camera.setPerspective(static_cast<float>(SCREEN_WIDTH) / static_cast<float>(SCREEN_WIDTH), 0.1f, 100.0f);
+		glm::mat4 projection = camera.getProjectionMatrix();
 		objectShader.setMat4("view", view);
 		objectShader.setMat4("projection", projection);
 		objectShader.setVec3("viewPos", camera.getPosition());
@@ -321,37 +326,9 @@ int main(void) {
 }
 
 unsigned int loadTexture(const char* path, bool flipVertically) {
-	unsigned int textureId;
-	glGenTextures(1, &textureId);
-	int width, height, numChannels;
-	stbi_set_flip_vertically_on_load(flipVertically);
-	unsigned char* data = stbi_load(path, &width, &height, &numChannels, 0);
-	if (data) {
-		GLenum format;
-		switch (numChannels) {
-			case 1:
-			//default:
-				format = GL_RED;
-				break;
-			case 3:
-				format = GL_RGB;
-				break;
-			case 4: 
-				format = GL_RGBA;
-				break;
-		}
-		glBindTexture(GL_TEXTURE_2D, textureId);
-		glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-		glGenerateMipmap(GL_TEXTURE_2D);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	} else {
-		std::cout << "ERROR::TEXTURE::FAILED_TO_LOAD\n" << path << std::endl;
-	}
-	stbi_image_free(data);
-	return textureId;
+	TextureOptions options;
+	options.flipVertically = flipVertically;
+	return TextureStreamer::load(path, options);
 }
 
 void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
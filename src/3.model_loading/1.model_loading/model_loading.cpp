@@ -14,6 +14,8 @@
 #include <learnopengl/shader_g.h>
 #include <learnopengl/camera.h>
 #include <learnopengl/model.h>
+#include <learnopengl/gl_state.h>
+#include <learnopengl/texture_streamer.h>
 #include <iostream>
 
 /**
@@ -104,7 +106,7 @@ int main(void) {
 	}
 
 	// enable OpenGL features
-	glEnable(GL_DEPTH_TEST);
+	GLState::enable(GL_DEPTH_TEST);
 
 	// create light source object
 	float lightVertices[] = {
@@ -139,36 +141,35 @@ int main(void) {
 
 	// Copy vertex data to GPU and set vertex position attribute for object
 	glGenVertexArrays(1, &lightVao);
-	glBindVertexArray(lightVao);
-	glBindBuffer(GL_ARRAY_BUFFER, lightVbo);
+	GLState::bindVertexArray(lightVao);
+	GLState::bindBuffer(GL_ARRAY_BUFFER, lightVbo);
 	glBufferData(GL_ARRAY_BUFFER, sizeof(lightVertices), lightVertices, GL_STATIC_DRAW);
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), reinterpret_cast<void*>(0));
 	glEnableVertexAttribArray(0);
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+	GLState::bindVertexArray(0);
 
 	// Set vertex position attribute for light source
 	glGenVertexArrays(1, &lightVao);
-	glBindVertexArray(lightVao);
-	glBindBuffer(GL_ARRAY_BUFFER, lightVbo);
+	GLState::bindVertexArray(lightVao);
+	GLState::bindBuffer(GL_ARRAY_BUFFER, lightVbo);
 	glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), reinterpret_cast<void*>(0));
 	glEnableVertexAttribArray(0);
 
 	// copy indices into element buffer
 	glGenBuffers(1, &lightEbo);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, lightEbo);
+	GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, lightEbo);
 	glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(lightIndices), lightIndices, GL_STATIC_DRAW);
 
 	// unbind VBO and VAO
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-	glBindVertexArray(0);
+	GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+	GLState::bindVertexArray(0);
 
 	// unbind EBO after VAO to keep EBO data bound to VAO
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	GLState::bindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 
 	// create model object
-	stbi_set_flip_vertically_on_load(true);
-	Model object(MODEL_PATH);
+	Model object(MODEL_PATH, true);
 
 	// Create shader objects
 	Shader objectShader(MODEL_VERTEX_SHADER, MODEL_FRAGMENT_SHADER);
@@ -184,6 +185,9 @@ int main(void) {
 		// process keyboard input
 		processInput(window);
 
+		// stream in loaded textures
+		TextureStreamer::update();
+
 		// screen color
 		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 
@@ -194,7 +198,8 @@ int main(void) {
 		glm::vec3 lightPos(0.0f);
 		glm::mat4 model(1.0f);
 		glm::mat4 view = camera.getViewMatrix();
-		glm::mat4 projection = glm::perspective(glm::radians(camera.getFOV()), static_cast<float>(SCREEN_WIDTH) / static_cast<float>(SCREEN_WIDTH), 0.1f, 100.0f);
+		camera.setPerspective(static_cast<float>(SCREEN_WIDTH) / static_cast<float>(SCREEN_WIDTH), 0.1f, 100.0f);
+		glm::mat4 projection = camera.getProjectionMatrix();
 		lightShader.use();
 		lightPos.x = 5.0f * sin(currentFrame * glm::radians(90.0f));
 		lightPos.z = 5.0f * cos(currentFrame * glm::radians(90.0f));
@@ -203,7 +208,7 @@ int main(void) {
 		lightShader.setMat4("model", model);
 		lightShader.setMat4("view", view);
 		lightShader.setMat4("projection", projection);
-		glBindVertexArray(lightVao);
+		GLState::bindVertexArray(lightVao);
 		glDrawElements(GL_TRIANGLES, sizeof(lightIndices) / sizeof(float), GL_UNSIGNED_INT, 0);
 
 		// render loaded model
@@ -223,7 +228,7 @@ int main(void) {
 		objectShader.setMat4("model", model);
 		objectShader.setMat4("view", view);
 		objectShader.setMat4("projection", projection);
-		object.draw(objectShader);
+		object.draw(objectShader, model, camera.getFrustum());
 
 		// swap buffers and poll IO events
 		glfwSwapBuffers(window);
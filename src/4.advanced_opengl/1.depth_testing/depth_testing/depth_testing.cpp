@@ -12,6 +12,7 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <learnopengl/shader_g.h>
 #include <learnopengl/camera.h>
+#include <learnopengl/texture_streamer.h>
 #include <stb_image.h>
 #include <iostream>
 
@@ -220,6 +221,9 @@ int main(void) {
 		// process input
 		processInput(window);
 
+		// stream in loaded textures
+		TextureStreamer::update();
+
 		// set color
 		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 
@@ -230,7 +234,8 @@ int main(void) {
 		shader.use();
 		glm::mat4 model = glm::mat4(1.0f);
 		glm::mat4 view = camera.getViewMatrix();
-		glm::mat4 projection = glm::perspective(glm::radians(camera.getFOV()), ASPECT_RATIO, NEAR_PLANE, FAR_PLANE);
+		camera.setPerspective(ASPECT_RATIO, NEAR_PLANE, FAR_PLANE);
+		glm::mat4 projection = camera.getProjectionMatrix();
 		shader.setMat4("view", view);
 		shader.setMat4("projection", projection);
 
@@ -269,32 +274,9 @@ int main(void) {
 }
 
 unsigned int loadTexture(const char* path, bool flipVertically) {
-	unsigned int textureID;
-	glGenTextures(1, &textureID);
-	int width, height, nrChannels;
-	stbi_set_flip_vertically_on_load(flipVertically);
-	unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
-	if (data) {
-		GLenum format;
-		if (nrChannels == 1)
-			format = GL_RED;
-		else if (nrChannels == 3)
-			format = GL_RGB;
-		else if (nrChannels == 4)
-			format = GL_RGBA;
-		glBindTexture(GL_TEXTURE_2D, textureID);
-		glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-		glGenerateMipmap(GL_TEXTURE_2D);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	}
-	else {
-		std::cout << "ERROR::TEXTURE::FAILED_TO_LOAD\n" << path << std::endl;
-	}
-	stbi_image_free(data);
-	return textureID;
+	TextureOptions options;
+	options.flipVertically = flipVertically;
+	return TextureStreamer::load(path, options);
 }
 
 void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
@@ -209,7 +209,8 @@ int main(void) {
 		shader.use();
 		glm::mat4 model = glm::mat4(1.0f);
 		glm::mat4 view = camera.getViewMatrix();
-		glm::mat4 projection = glm::perspective(glm::radians(camera.getFOV()), ASPECT_RATIO, NEAR_PLANE, FAR_PLANE);
+		camera.setPerspective(ASPECT_RATIO, NEAR_PLANE, FAR_PLANE);
+		glm::mat4 projection = camera.getProjectionMatrix();
 		shader.setMat4("view", view);
 		shader.setMat4("projection", projection);
 
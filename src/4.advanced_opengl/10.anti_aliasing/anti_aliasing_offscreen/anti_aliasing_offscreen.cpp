@@ -238,7 +238,8 @@ int main(void) {
 		// render cube
 		glm::mat4 model = glm::mat4(1.0f);
 		glm::mat4 view = camera.getViewMatrix();
-		glm::mat4 projection = glm::perspective(glm::radians(camera.getFOV()), aspectRatio, 0.1f, 100.0f);
+		camera.setPerspective(aspectRatio, 0.1f, 100.0f);
+		glm::mat4 projection = camera.getProjectionMatrix();
 		shader.use();
 		shader.setMat4("model", model);
 		shader.setMat4("view", view);
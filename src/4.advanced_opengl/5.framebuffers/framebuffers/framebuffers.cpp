@@ -13,8 +13,9 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 // Custom libs
-#include <learnopengl/shader_m.h>
+#include <learnopengl/shader_variants.h>
 #include <learnopengl/camera.h>
+#include <learnopengl/texture_streamer.h>
 // Image loading
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -79,6 +80,9 @@ float aspectRatio = SCREEN_WIDTH / SCREEN_HEIGHT;
 float lastX = SCREEN_WIDTH / 2;
 float lastY = SCREEN_HEIGHT / 2;
 bool firstMouse = true;
+// post-processing effect of the screen shader, selected with the number keys
+const unsigned int NUM_EFFECTS = 7;
+unsigned int screenEffect = 0;
 // timing
 float deltaTime = 0.0f;
 float lastFrame = 0.0f;
@@ -113,7 +117,7 @@ int main(void) {
 
 	// create shader program objects
 	Shader objectShader(OBJECT_VERT_SHADER, OBJECT_FRAG_SHADER);	
-	Shader screenShader(SCREEN_VERT_SHADER, SCREEN_FRAG_SHADER);
+	ShaderVariants screenShaders(SCREEN_VERT_SHADER, SCREEN_FRAG_SHADER);
 
 	// establist vertices
 	float cubeVertices[] = {
@@ -229,8 +233,13 @@ int main(void) {
 	// activate shaders before setting uniforms
 	objectShader.use();
 	objectShader.setInt("texture1", 0);
-	screenShader.use();
-	screenShader.setInt("screenTexture", 0);
+	// build every effect up front so switching never stalls on the compiler
+	Shader* screenShader[NUM_EFFECTS];
+	for (unsigned int i = 0; i < NUM_EFFECTS; i++) {
+		screenShader[i] = &screenShaders.get({ { "EFFECT", std::to_string(i) } });
+		screenShader[i]->use();
+		screenShader[i]->setInt("screenTexture", 0);
+	}
 
 	// framebuffer object
 	unsigned int fbo;
@@ -277,6 +286,9 @@ int main(void) {
 		// process input
 		processInput(window);
 
+		// stream in loaded textures
+		TextureStreamer::update();
+
 		// use custom framebuffer
 		glBindFramebuffer(GL_FRAMEBUFFER, fbo);
 		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
@@ -287,7 +299,8 @@ int main(void) {
 		objectShader.use();
 		glm::mat4 model = glm::mat4(1.0f);
 		glm::mat4 view = camera.getViewMatrix();
-		glm::mat4 projection = glm::perspective(glm::radians(camera.getFOV()), aspectRatio, 0.1f, 100.0f);
+		camera.setPerspective(aspectRatio, 0.1f, 100.0f);
+		glm::mat4 projection = camera.getProjectionMatrix();
 		objectShader.setMat4("view", view);
 		objectShader.setMat4("projection", projection);
 
@@ -317,7 +330,7 @@ int main(void) {
 		glClear(GL_COLOR_BUFFER_BIT);
 
 		// render screen quad
-		screenShader.use();
+		screenShader[screenEffect]->use();
 		glBindVertexArray(quadVAO);
 		glDisable(GL_DEPTH_TEST);
 		glBindTexture(GL_TEXTURE_2D, colorBufferTexture);
@@ -340,32 +353,9 @@ int main(void) {
 }
 
 unsigned int loadTexture(const char* path, bool flipVertically) {
-	unsigned int textureID;
-	glGenTextures(1, &textureID);
-	int width, height, nrChannels;
-	stbi_set_flip_vertically_on_load(flipVertically);
-	unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
-	if (data) {
-		GLenum format;
-		if (nrChannels == 1)
-			format = GL_RED;
-		else if (nrChannels == 3)
-			format = GL_RGB;
-		else if (nrChannels == 4)
-			format = GL_RGBA;
-		glBindTexture(GL_TEXTURE_2D, textureID);
-		glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-		glGenerateMipmap(GL_TEXTURE_2D);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	}
-	else {
-		std::cout << "ERROR::TEXTURE::FAILED_TO_LOAD\n" << path << std::endl;
-	}
-	stbi_image_free(data);
-	return textureID;
+	TextureOptions options;
+	options.flipVertically = flipVertically;
+	return TextureStreamer::load(path, options);
 }
 
 void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
@@ -402,4 +392,7 @@ void processInput(GLFWwindow* window) {
 		camera.processKeyboard(CameraMovement::LEFT, deltaTime);
 	if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
 		camera.processKeyboard(CameraMovement::RIGHT, deltaTime);
+	for (unsigned int i = 0; i < NUM_EFFECTS; i++)
+		if (glfwGetKey(window, GLFW_KEY_0 + i) == GLFW_PRESS)
+			screenEffect = i;
 }
\ No newline at end of file
@@ -1,5 +1,11 @@
 #version 330 core
 
+// post-processing effect, selected at compile time
+// 0: none, 1: inversion, 2: grayscale, 3: weighted grayscale, 4: sharpen, 5: blur, 6: edge detection
+#ifndef EFFECT
+#define EFFECT 0
+#endif
+
 in vec2 texCoords;
 
 uniform sampler2D screenTexture;
@@ -7,100 +13,61 @@ uniform sampler2D screenTexture;
 out vec4 fragColor;
 
 void main() {
-	// render fragment as normal
-	fragColor = texture(screenTexture, texCoords);
-
+#if EFFECT == 1
 	// invert colors
-	// fragColor = vec4(vec3(1.0f - texture(screenTexture, texCoords)), 1.0f);
-
+	fragColor = vec4(vec3(1.0f - texture(screenTexture, texCoords)), 1.0f);
+#elif EFFECT == 2
 	// grayscale
-	// fragColor = texture(screenTexture, texCoords);
-	// float average = (fragColor.r, + fragColor.g + fragColor.b) / 3.0f;
-	// fragColor = vec4(average, average, average, 1.0f);
-
+	fragColor = texture(screenTexture, texCoords);
+	float average = (fragColor.r + fragColor.g + fragColor.b) / 3.0f;
+	fragColor = vec4(average, average, average, 1.0f);
+#elif EFFECT == 3
 	// grayscale with weighted channels based on human eye color sensitivity
-	// fragColor = texture(screenTexture, texCoords);
-	// float average = 0.2126f * fragColor.r + 0.7152 * fragColor.g + 0.0722 * fragColor.b;
-	// fragColor = vec4(average, average, average, 1.0f);
-
-	// using a kernel (convolution matrix) to sharpen the fragment
-	// const float offset = 1.0f / 300.0f;  
-    // vec2 offsets[9] = vec2[](
-    //     vec2(-offset,  offset), // top-left
-    //     vec2( 0.0f,    offset), // top-center
-    //     vec2( offset,  offset), // top-right
-    //     vec2(-offset,  0.0f),   // center-left
-    //     vec2( 0.0f,    0.0f),   // center-center
-    //     vec2( offset,  0.0f),   // center-right
-    //     vec2(-offset, -offset), // bottom-left
-    //     vec2( 0.0f,   -offset), // bottom-center
-    //     vec2( offset, -offset)  // bottom-right    
-    // );
-    // float kernel[9] = float[](
-    //     -1, -1, -1,
-    //     -1,  9, -1,
-    //     -1, -1, -1
-    // );
-    // vec3 sampleTex[9];
-    // for(int i = 0; i < 9; i++) {
-    //     sampleTex[i] = vec3(texture(screenTexture, texCoords.st + offsets[i]));
-    // }
-    // vec3 col = vec3(0.0);
-    // for(int i = 0; i < 9; i++)
-    //     col += sampleTex[i] * kernel[i];
-    // fragColor = vec4(col, 1.0);
-
-    // using a kernel to create a blur effect
-    // const float offset = 1.0f / 300.0f;  
-    // vec2 offsets[9] = vec2[](
-    //     vec2(-offset,  offset), // top-left
-    //     vec2( 0.0f,    offset), // top-center
-    //     vec2( offset,  offset), // top-right
-    //     vec2(-offset,  0.0f),   // center-left
-    //     vec2( 0.0f,    0.0f),   // center-center
-    //     vec2( offset,  0.0f),   // center-right
-    //     vec2(-offset, -offset), // bottom-left
-    //     vec2( 0.0f,   -offset), // bottom-center
-    //     vec2( offset, -offset)  // bottom-right    
-    // );
-    // float kernel[9] = float[](
-    //     1.0 / 16, 2.0 / 16, 1.0 / 16,
-    //     2.0 / 16, 4.0 / 16, 2.0 / 16,
-    //     1.0 / 16, 2.0 / 16, 1.0 / 16  
-    // );
-    // vec3 sampleTex[9];
-    // for(int i = 0; i < 9; i++) {
-    //     sampleTex[i] = vec3(texture(screenTexture, texCoords.st + offsets[i]));
-    // }
-    // vec3 col = vec3(0.0);
-    // for(int i = 0; i < 9; i++)
-    //     col += sampleTex[i] * kernel[i];
-    // fragColor = vec4(col, 1.0);
-
-    // using a kernel to create an edge detection effect
-    // const float offset = 1.0f / 300.0f;  
-    // vec2 offsets[9] = vec2[](
-    //     vec2(-offset,  offset), // top-left
-    //     vec2( 0.0f,    offset), // top-center
-    //     vec2( offset,  offset), // top-right
-    //     vec2(-offset,  0.0f),   // center-left
-    //     vec2( 0.0f,    0.0f),   // center-center
-    //     vec2( offset,  0.0f),   // center-right
-    //     vec2(-offset, -offset), // bottom-left
-    //     vec2( 0.0f,   -offset), // bottom-center
-    //     vec2( offset, -offset)  // bottom-right    
-    // );
-    // float kernel[9] = float[](
-    //     1, 1, 1,
-    //     1, -8, 1,
-    //     1, 1, 1
-    // );
-    // vec3 sampleTex[9];
-    // for(int i = 0; i < 9; i++) {
-    //     sampleTex[i] = vec3(texture(screenTexture, texCoords.st + offsets[i]));
-    // }
-    // vec3 col = vec3(0.0);
-    // for(int i = 0; i < 9; i++)
-    //     col += sampleTex[i] * kernel[i];
-    // fragColor = vec4(col, 1.0);
-}
\ No newline at end of file
+	fragColor = texture(screenTexture, texCoords);
+	float average = 0.2126f * fragColor.r + 0.7152 * fragColor.g + 0.0722 * fragColor.b;
+	fragColor = vec4(average, average, average, 1.0f);
+#elif EFFECT >= 4 && EFFECT <= 6
+	// using a kernel (convolution matrix)
+	const float offset = 1.0f / 300.0f;
+    vec2 offsets[9] = vec2[](
+        vec2(-offset,  offset), // top-left
+        vec2( 0.0f,    offset), // top-center
+        vec2( offset,  offset), // top-right
+        vec2(-offset,  0.0f),   // center-left
+        vec2( 0.0f,    0.0f),   // center-center
+        vec2( offset,  0.0f),   // center-right
+        vec2(-offset, -offset), // bottom-left
+        vec2( 0.0f,   -offset), // bottom-center
+        vec2( offset, -offset)  // bottom-right
+    );
+#if EFFECT == 4
+    // sharpen
+    float kernel[9] = float[](
+        -1, -1, -1,
+        -1,  9, -1,
+        -1, -1, -1
+    );
+#elif EFFECT == 5
+    // blur
+    float kernel[9] = float[](
+        1.0 / 16, 2.0 / 16, 1.0 / 16,
+        2.0 / 16, 4.0 / 16, 2.0 / 16,
+        1.0 / 16, 2.0 / 16, 1.0 / 16
+    );
+#else
+    // edge detection
+    float kernel[9] = float[](
+        1, 1, 1,
+        1, -8, 1,
+        1, 1, 1
+    );
+#endif
+    vec3 col = vec3(0.0);
+    for(int i = 0; i < 9; i++)
+        col += vec3(texture(screenTexture, texCoords.st + offsets[i])) * kernel[i];
+    fragColor = vec4(col, 1.0);
+#else
+	// render fragment as normal
+	fragColor = texture(screenTexture, texCoords);
+#endif
+}
@@ -15,6 +15,7 @@
 // Custom libs
 #include <learnopengl/shader_m.h>
 #include <learnopengl/camera.h>
+#include <learnopengl/texture_streamer.h>
 // Image loading
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -277,6 +278,9 @@ int main(void) {
 		// process input
 		processInput(window);
 
+		// stream in loaded textures
+		TextureStreamer::update();
+
 		// first render pass: mirror
 		// note: rear-view mirror only works along the x-axis (yaw)
 		glBindFramebuffer(GL_FRAMEBUFFER, fbo);
@@ -287,11 +291,10 @@ int main(void) {
 		objectShader.use();
 		glm::mat4 model = glm::mat4(1.0f);
 		camera.setYaw(camera.getYaw() + 180.0f);  // rotate camera vector 180 degrees
-		camera.processMouseMovement(0, 0, false); // ensure camera vectors are updated
 		glm::mat4 view = camera.getViewMatrix();
-		camera.setYaw(camera.getYaw() - 180.0f);  // reset camera to original orientation 
-		camera.processMouseMovement(0, 0, true);  // ensure camera vectors are updated
-		glm::mat4 projection = glm::perspective(glm::radians(camera.getFOV()), aspectRatio, 0.1f, 100.0f);
+		camera.setYaw(camera.getYaw() - 180.0f);  // reset camera to original orientation
+		camera.setPerspective(aspectRatio, 0.1f, 100.0f);
+		glm::mat4 projection = camera.getProjectionMatrix();
 		objectShader.setMat4("view", view);
 		objectShader.setMat4("projection", projection);
 		// cubes
@@ -321,7 +324,8 @@ int main(void) {
 		objectShader.use();
 		model = glm::mat4(1.0f);
 		view = camera.getViewMatrix();
-		projection = glm::perspective(glm::radians(camera.getFOV()), aspectRatio, 0.1f, 100.0f);
+		camera.setPerspective(aspectRatio, 0.1f, 100.0f);
+		projection = camera.getProjectionMatrix();
 		objectShader.setMat4("view", view);
 		objectShader.setMat4("projection", projection);
 		// cubes
@@ -367,32 +371,9 @@ int main(void) {
 }
 
 unsigned int loadTexture(const char* path, bool flipVertically) {
-	unsigned int textureID;
-	glGenTextures(1, &textureID);
-	int width, height, nrChannels;
-	stbi_set_flip_vertically_on_load(flipVertically);
-	unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
-	if (data) {
-		GLenum format;
-		if (nrChannels == 1)
-			format = GL_RED;
-		else if (nrChannels == 3)
-			format = GL_RGB;
-		else if (nrChannels == 4)
-			format = GL_RGBA;
-		glBindTexture(GL_TEXTURE_2D, textureID);
-		glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-		glGenerateMipmap(GL_TEXTURE_2D);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	}
-	else {
-		std::cout << "ERROR::TEXTURE::FAILED_TO_LOAD\n" << path << std::endl;
-	}
-	stbi_image_free(data);
-	return textureID;
+	TextureOptions options;
+	options.flipVertically = flipVertically;
+	return TextureStreamer::load(path, options);
 }
 
 void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
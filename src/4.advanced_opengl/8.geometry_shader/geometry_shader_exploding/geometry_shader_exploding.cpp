@@ -16,6 +16,7 @@
 #include <learnopengl/shader_g.h>
 #include <learnopengl/camera.h>
 #include <learnopengl/model.h>
+#include <learnopengl/texture_streamer.h>
 // Image loading
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -104,11 +105,8 @@ int main(void) {
 	// create shader program object
 	Shader shader(VERT_SHADER, FRAG_SHADER, GEOM_SHADER);
 
-	// tell stb_image.h to flip loaded texture's on the y-axis (before loading model).
-	stbi_set_flip_vertically_on_load(true);
-
 	// create model object
-	Model object(MODEL);
+	Model object(MODEL, true);
 
 	// render loop
 	while (!glfwWindowShouldClose(window)) {
@@ -120,6 +118,9 @@ int main(void) {
 		// keyboard
 		processInput(window);
 
+		// stream in loaded textures
+		TextureStreamer::update();
+
 		// set color
 		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 
@@ -130,7 +131,8 @@ int main(void) {
 		shader.use();
 		glm::mat4 model = glm::mat4(1.0f);
 		glm::mat4 view = camera.getViewMatrix();
-		glm::mat4 projection = glm::perspective(glm::radians(camera.getFOV()), (float)SCREEN_WIDTH / (float)SCREEN_HEIGHT, 0.1f, 100.0f);
+		camera.setPerspective((float)SCREEN_WIDTH / (float)SCREEN_HEIGHT, 0.1f, 100.0f);
+		glm::mat4 projection = camera.getProjectionMatrix();
 		shader.setMat4("model", model);
 		shader.setMat4("view", view);
 		shader.setMat4("projection", projection);
@@ -16,6 +16,7 @@
 #include <learnopengl/shader_g.h>
 #include <learnopengl/camera.h>
 #include <learnopengl/model.h>
+#include <learnopengl/texture_streamer.h>
 // Image loading
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -107,11 +108,8 @@ int main(void) {
 	Shader shader(DEFAULT_VERT_SHADER, DEFAULT_FRAG_SHADER);
 	Shader normalShader(NORMAL_VERT_SHADER, NORMAL_FRAG_SHADER, NORMAL_GEOM_SHADER);
 
-	// tell stb_image.h to flip loaded texture's on the y-axis (before loading model).
-	stbi_set_flip_vertically_on_load(true);
-
 	// create model object
-	Model object(MODEL);
+	Model object(MODEL, true);
 
 	// render loop
 	while (!glfwWindowShouldClose(window)) {
@@ -123,6 +121,9 @@ int main(void) {
 		// keyboard
 		processInput(window);
 
+		// stream in loaded textures
+		TextureStreamer::update();
+
 		// set color
 		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 
@@ -133,7 +134,8 @@ int main(void) {
 		shader.use();
 		glm::mat4 model = glm::mat4(1.0f);
 		glm::mat4 view = camera.getViewMatrix();
-		glm::mat4 projection = glm::perspective(glm::radians(camera.getFOV()), (float)SCREEN_WIDTH / (float)SCREEN_HEIGHT, 0.1f, 100.0f);
+		camera.setPerspective((float)SCREEN_WIDTH / (float)SCREEN_HEIGHT, 0.1f, 100.0f);
+		glm::mat4 projection = camera.getProjectionMatrix();
 		shader.setMat4("model", model);
 		shader.setMat4("view", view);
 		shader.setMat4("projection", projection);
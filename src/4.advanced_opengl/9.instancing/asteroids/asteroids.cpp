@@ -16,11 +16,14 @@
 #include <learnopengl/shader_g.h>
 #include <learnopengl/camera.h>
 #include <learnopengl/model.h>
+#include <learnopengl/culling.h>
+#include <learnopengl/texture_streamer.h>
 // Image loading
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 // C++ libs
 #include <iostream>
+#include <vector>
 
 /**
  * Handle window resizing
@@ -105,9 +108,11 @@ int main(void) {
 	Shader shader(VERT_SHADER, FRAG_SHADER);
 
 	// load models
-	stbi_set_flip_vertically_on_load(true);
-	Model asteroid(ASTEROID);
-	Model planet(PLANET);
+	Model asteroid(ASTEROID, true);
+	Model planet(PLANET, true);
+	// both are only drawn, their geometry does not need to stay in system memory
+	asteroid.releaseMeshData();
+	planet.releaseMeshData();
 
 	// asteroid placement
 	const unsigned int NUM_ASTEROIDS = 1000;
@@ -138,6 +143,12 @@ int main(void) {
 		// 4. now add to list of matrices
 		modelMatrices[i] = model;
 	}
+	// LOD each asteroid was drawn with last frame, for hysteresis
+	std::vector<unsigned int> asteroidLods(NUM_ASTEROIDS, 0);
+	// world-space bounds of the asteroids, which never move, and the ones in view this frame
+	BoundingSpheres asteroidSpheres;
+	asteroidSpheres.assign(modelMatrices, NUM_ASTEROIDS, asteroid.getBoundsCenter(), asteroid.getBoundsRadius());
+	std::vector<unsigned int> visibleAsteroids;
 
 	// render loop
 	while (!glfwWindowShouldClose(window)) {
@@ -148,6 +159,9 @@ int main(void) {
 		// process input
 		processInput(window);
 
+		// stream in loaded textures
+		TextureStreamer::update();
+
 		// set color
 		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 
@@ -156,7 +170,8 @@ int main(void) {
 
 		// view and model matrices
 		glm::mat4 view = camera.getViewMatrix();
-		glm::mat4 projection = glm::perspective(glm::radians(camera.getFOV()), (float)SCREEN_WIDTH / (float)SCREEN_HEIGHT, 0.1f, 1000.0f);
+		camera.setPerspective((float)SCREEN_WIDTH / (float)SCREEN_HEIGHT, 0.1f, 1000.0f);
+		glm::mat4 projection = camera.getProjectionMatrix();
 		shader.use();
 		shader.setMat4("view", view);
 		shader.setMat4("projection", projection);
@@ -166,18 +181,24 @@ int main(void) {
 		model = glm::translate(model, glm::vec3(0.0f, -3.0f, 0.0f));
 		model = glm::scale(model, glm::vec3(4.0f, 4.0f, 4.0f));
 		shader.setMat4("model", model);
-		planet.draw(shader);
+		const Frustum& frustum = camera.getFrustum();
+		planet.draw(shader, model, frustum);
 		
 		// render asteroids
-		for (unsigned int i = 0; i < NUM_ASTEROIDS; i++) {
+		asteroidSpheres.cull(frustum, visibleAsteroids);
+		for (unsigned int i : visibleAsteroids) {
 			shader.setMat4("model", modelMatrices[i]);
-			asteroid.draw(shader);
+			float screenSize = asteroid.getScreenSize(view * modelMatrices[i], projection, static_cast<float>(SCREEN_HEIGHT));
+			asteroidLods[i] = asteroid.selectLod(screenSize, asteroidLods[i]);
+			asteroid.draw(shader, asteroidLods[i]);
 		}
 
 		glfwSwapBuffers(window);
 		glfwPollEvents();
 	}
 
+	Culling::printCounters();
+
 	delete[] modelMatrices;
 	glfwTerminate();
 	return EXIT_SUCCESS;
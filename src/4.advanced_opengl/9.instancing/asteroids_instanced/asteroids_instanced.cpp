@@ -16,11 +16,16 @@
 #include <learnopengl/shader_g.h>
 #include <learnopengl/camera.h>
 #include <learnopengl/model.h>
+#include <learnopengl/culling.h>
+#include <learnopengl/gl_state.h>
+#include <learnopengl/texture_streamer.h>
 // Image loading
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 // C++ libs
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 /**
  * Handle window resizing
@@ -101,16 +106,25 @@ int main(void) {
 	}
 
 	// configure global OpenGL state
-	glEnable(GL_DEPTH_TEST);
+	GLState::enable(GL_DEPTH_TEST);
 
 	// create shader program objects
-	Shader planetShader(PLANET_VERT_SHADER, PLANET_FRAG_SHADER);
+	// vertex fetch limits this demo, so both models pack their vertices: the planet is drawn through Mesh::draw,
+	// which supplies the position decoding uniforms, and uses the 16-byte compact format; the asteroids are drawn
+	// instanced without those uniforms, so they keep float positions and pack only normals and UVs (20 bytes)
+	VertexFormat planetFormat = VertexFormat::compact();
+	VertexFormat asteroidFormat;
+	asteroidFormat.normals = VertexFormat::PACKED_NORMALS;
+	asteroidFormat.halfTexCoords = true;
+	Shader planetShader(PLANET_VERT_SHADER, PLANET_FRAG_SHADER, planetFormat.getDefines());
 	Shader asteroidShader(ASTEROID_VERT_SHADER, ASTEROID_FRAG_SHADER);
 
 	// load models
-	stbi_set_flip_vertically_on_load(true);
-	Model asteroid(ASTEROID);
-	Model planet(PLANET);
+	Model asteroid(ASTEROID, true, asteroidFormat);
+	Model planet(PLANET, true, planetFormat);
+	// both are only drawn, their geometry does not need to stay in system memory
+	asteroid.releaseMeshData();
+	planet.releaseMeshData();
 
 	// asteroid placement
 	const unsigned int NUM_ASTEROIDS = 10000;
@@ -142,32 +156,18 @@ int main(void) {
 		modelMatrices[i] = model;
 	}
 
-	// configure instance array
-	unsigned int instanceVBO;
-	glGenBuffers(1, &instanceVBO);
-	glBindBuffer(GL_ARRAY_BUFFER, instanceVBO);
-	glBufferData(GL_ARRAY_BUFFER, NUM_ASTEROIDS * sizeof(glm::mat4), &modelMatrices[0], GL_STATIC_DRAW);
-	for (unsigned int i = 0; i < asteroid.getNumMeshes(); i++) {
-		unsigned int instanceVAO = asteroid.getMeshVAO(i);
-		glBindVertexArray(instanceVAO);
-		// vertex attributes
-		// maximum amount of data allowed for a vertex attribute is equal to a vec4
-		// mat4 is basically 4 vec4s, we must reserve 4 vertex attributes for this specific matrix
-		std::size_t vec4Size = sizeof(glm::vec4);
-		glEnableVertexAttribArray(3);
-		glVertexAttribPointer(3, 4, GL_FLOAT, GL_FALSE, 4 * vec4Size, (void*)0);
-		glEnableVertexAttribArray(4);
-		glVertexAttribPointer(4, 4, GL_FLOAT, GL_FALSE, 4 * vec4Size, (void*)vec4Size);
-		glEnableVertexAttribArray(5);
-		glVertexAttribPointer(5, 4, GL_FLOAT, GL_FALSE, 4 * vec4Size, (void*)(2 * vec4Size));
-		glEnableVertexAttribArray(6);
-		glVertexAttribPointer(6, 4, GL_FLOAT, GL_FALSE, 4 * vec4Size, (void*)(3 * vec4Size));
-		glVertexAttribDivisor(3, 1);
-		glVertexAttribDivisor(4, 1);
-		glVertexAttribDivisor(5, 1);
-		glVertexAttribDivisor(6, 1);
-		glBindVertexArray(0);
-	}
+	// LOD each asteroid was drawn with last frame, for hysteresis
+	std::vector<unsigned int> asteroidLods(NUM_ASTEROIDS, 0);
+	// the matrices grouped by LOD, lodStarts[lod] is the first of each group
+	std::vector<glm::mat4> sortedMatrices(NUM_ASTEROIDS);
+	std::vector<unsigned int> lodStarts(std::max(asteroid.getNumLods(), 1u) + 1);
+	// world-space bounds of the asteroids, which never move, and the ones in view this frame
+	BoundingSpheres asteroidSpheres;
+	asteroidSpheres.assign(modelMatrices, NUM_ASTEROIDS, asteroid.getBoundsCenter(), asteroid.getBoundsRadius());
+	std::vector<unsigned int> visibleAsteroids;
+	// camera version the buckets were built for, they only change when the camera does
+	unsigned long long bucketedVersion = 0;
+	bool bucketed = false;
 
 	// render loop
 	while (!glfwWindowShouldClose(window)) {
@@ -178,6 +178,9 @@ int main(void) {
 		// process input
 		processInput(window);
 
+		// stream in loaded textures
+		TextureStreamer::update();
+
 		// set color
 		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 
@@ -185,8 +188,9 @@ int main(void) {
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 		// view and model matrices
-		glm::mat4 view = camera.getViewMatrix();
-		glm::mat4 projection = glm::perspective(glm::radians(camera.getFOV()), (float)SCREEN_WIDTH / (float)SCREEN_HEIGHT, 0.1f, 1000.0f);
+		camera.setPerspective((float)SCREEN_WIDTH / (float)SCREEN_HEIGHT, 0.1f, 1000.0f);
+		const glm::mat4& view = camera.getViewMatrix();
+		const glm::mat4& projection = camera.getProjectionMatrix();
 		
 		// render planet
 		glm::mat4 model = glm::mat4(1.0f);
@@ -196,26 +200,41 @@ int main(void) {
 		planetShader.setMat4("model", model);
 		planetShader.setMat4("view", view);
 		planetShader.setMat4("projection", projection);
-		planet.draw(planetShader);
+		const Frustum& frustum = camera.getFrustum();
+		planet.draw(planetShader, model, frustum);
 		
 		// render asteroids
 		asteroidShader.use();
 		asteroidShader.setMat4("view", view);
 		asteroidShader.setMat4("projection", projection);
-		// asteroid texture needs to be activated, otherwise the planet texture will display on the asteroid
-		// asteroid texture currently isn't loading
-		/*glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, asteroid.getTextureID(0));*/
-		for (unsigned int i = 0; i < asteroid.getNumMeshes(); i++) {
-			glBindVertexArray(asteroid.getMeshVAO(i));
-			glDrawElementsInstanced(GL_TRIANGLES, asteroid.getMeshNumIndices(i), GL_UNSIGNED_INT, 0, NUM_ASTEROIDS);
-			glBindVertexArray(0);
+		// bucket the visible asteroids by LOD so every level is a single instanced draw
+		if (!bucketed || camera.getVersion() != bucketedVersion) {
+			asteroidSpheres.cull(frustum, visibleAsteroids);
+			std::fill(lodStarts.begin(), lodStarts.end(), 0);
+			for (unsigned int i : visibleAsteroids) {
+				float screenSize = asteroid.getScreenSize(view * modelMatrices[i], projection, static_cast<float>(SCREEN_HEIGHT));
+				asteroidLods[i] = asteroid.selectLod(screenSize, asteroidLods[i]);
+				lodStarts[asteroidLods[i] + 1]++;
+			}
+			for (std::size_t lod = 1; lod < lodStarts.size(); lod++)
+				lodStarts[lod] += lodStarts[lod - 1];
+			std::vector<unsigned int> lodFill(lodStarts.begin(), lodStarts.end() - 1);
+			for (unsigned int i : visibleAsteroids)
+				sortedMatrices[lodFill[asteroidLods[i]]++] = modelMatrices[i];
+			bucketedVersion = camera.getVersion();
+			bucketed = true;
 		}
+		// the model streams the matrices of each level through its instance buffer
+		for (unsigned int lod = 0; lod + 1 < lodStarts.size(); lod++)
+			asteroid.drawInstanced(asteroidShader, sortedMatrices.data() + lodStarts[lod], lodStarts[lod + 1] - lodStarts[lod], lod);
+		GLState::bindVertexArray(0);
 
 		glfwSwapBuffers(window);
 		glfwPollEvents();
 	}
 
+	Culling::printCounters();
+
 	delete[] modelMatrices;
 	glfwTerminate();
 	return EXIT_SUCCESS;
@@ -255,4 +274,4 @@ void processInput(GLFWwindow* window) {
 		camera.processKeyboard(CameraMovement::LEFT, deltaTime);
 	if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
 		camera.processKeyboard(CameraMovement::RIGHT, deltaTime);
-}
\ No newline at end of file
+}
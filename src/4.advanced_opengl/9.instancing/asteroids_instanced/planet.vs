@@ -2,6 +2,8 @@
 layout (location = 0) in vec3 aPos;
 layout (location = 2) in vec2 aTexCoords;
 
+#include <learnopengl/vertex_format.glsl>
+
 uniform mat4 model;
 uniform mat4 view;
 uniform mat4 projection;
@@ -9,6 +11,6 @@ uniform mat4 projection;
 out vec2 texCoords;
 
 void main() {
-	gl_Position = projection * view * model * vec4(aPos, 1.0f);
+	gl_Position = projection * view * model * vec4(decodePosition(aPos), 1.0f);
 	texCoords = aTexCoords;
 }
\ No newline at end of file
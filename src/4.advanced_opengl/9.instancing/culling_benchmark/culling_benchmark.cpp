@@ -0,0 +1,133 @@
+/**
+ * @file culling_benchmark.cpp
+ * @brief Objects culled per microsecond by every supported culling path
+ * @date October 2026
+ */
+
+// GLM
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+// Custom libs
+#include <learnopengl/culling.h>
+#include <learnopengl/parallel.h>
+// C++ libs
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// the largest is past Culling's threshold for splitting a batch over threads, and is also timed on one thread
+const std::size_t BATCH_SIZES[] = { 1000, 10000, 100000, 1000000 };
+// every measurement repeats the cull until this much time has passed
+const double MIN_SECONDS = 0.25;
+const unsigned int SEED = 13;
+// objects are scattered in front of the camera so part of each batch survives
+const glm::vec3 SCENE_MIN(-60.0f, -60.0f, -110.0f);
+const glm::vec3 SCENE_MAX(60.0f, 60.0f, 10.0f);
+const float MAX_SIZE = 2.0f;
+
+/**
+ * Cull bounds repeatedly with the current path
+ * @param bounds - BoundingSpheres or BoundingBoxes
+ * @param frustum - the frustum to cull against
+ * @param visible - receives the indices of the last cull
+ * @return Objects culled per microsecond
+ */
+template<typename Bounds>
+double measure(const Bounds& bounds, const Frustum& frustum, std::vector<unsigned int>& visible) {
+	typedef std::chrono::steady_clock Clock;
+	// warm up the caches and the output's allocation
+	bounds.cull(frustum, visible);
+	unsigned long long culledObjects = 0;
+	Clock::time_point start = Clock::now();
+	double seconds = 0.0;
+	while (seconds < MIN_SECONDS) {
+		bounds.cull(frustum, visible);
+		culledObjects += bounds.size();
+		seconds = std::chrono::duration<double>(Clock::now() - start).count();
+	}
+	return static_cast<double>(culledObjects) / (seconds * 1.0e6);
+}
+
+/**
+ * Time every supported path on one batch and check they agree
+ * @param name - what the bounds are, for the report
+ * @param bounds - BoundingSpheres or BoundingBoxes
+ * @param frustum - the frustum to cull against
+ * @return Whether every path produced the same indices
+ */
+template<typename Bounds>
+bool report(const char* name, const Bounds& bounds, const Frustum& frustum) {
+	std::vector<unsigned int> expected, visible;
+	bool agree = true;
+	const Culling::Path paths[] = { Culling::Path::SCALAR, Culling::Path::SSE, Culling::Path::AVX2 };
+	for (Culling::Path path : paths) {
+		if (path > Culling::getBestPath())
+			break;
+		Culling::setPath(path);
+		double rate = measure(bounds, frustum, visible);
+		if (path == Culling::Path::SCALAR)
+			expected = visible;
+		bool match = visible == expected;
+		agree = agree && match;
+		std::cout << name << "\t" << bounds.size() << "\t" << Culling::getPathName(path) << "\t" << rate << " objects/us\t"
+			<< visible.size() << " visible" << (match ? "" : "\tMISMATCH") << std::endl;
+	}
+	Culling::setPath(Culling::getBestPath());
+	return agree;
+}
+
+/**
+ * Time the best path on one thread and split over parallelFor
+ * @param name - what the bounds are, for the report
+ * @param bounds - BoundingSpheres or BoundingBoxes, large enough to be split
+ * @param frustum - the frustum to cull against
+ * @return Whether both produced the same indices
+ */
+template<typename Bounds>
+bool reportThreading(const char* name, const Bounds& bounds, const Frustum& frustum) {
+	std::vector<unsigned int> single, threaded;
+	Culling::setParallel(false);
+	double singleRate = measure(bounds, frustum, single);
+	Culling::setParallel(true);
+	double threadedRate = measure(bounds, frustum, threaded);
+	bool match = single == threaded;
+	std::cout << name << "\t" << bounds.size() << "\t" << Culling::getPathName(Culling::getPath()) << "\t" << singleRate
+		<< " objects/us on 1 thread, " << threadedRate << " on " << workerCount() << " (" << threadedRate / singleRate << "x)"
+		<< (match ? "" : "\tMISMATCH") << std::endl;
+	return match;
+}
+
+int main(void) {
+	glm::mat4 projection = glm::perspective(glm::radians(45.0f), 800.0f / 600.0f, 0.1f, 100.0f);
+	glm::mat4 view = glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	Frustum frustum = Frustum::fromMatrix(projection * view);
+
+	std::mt19937 random(SEED);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	std::cout << "best path: " << Culling::getPathName(Culling::getBestPath()) << std::endl;
+	bool agree = true;
+	for (std::size_t size : BATCH_SIZES) {
+		BoundingSpheres spheres;
+		BoundingBoxes boxes;
+		for (std::size_t i = 0; i < size; i++) {
+			glm::vec3 center = SCENE_MIN + glm::vec3(unit(random), unit(random), unit(random)) * (SCENE_MAX - SCENE_MIN);
+			glm::vec3 extent = glm::vec3(unit(random), unit(random), unit(random)) * (0.5f * MAX_SIZE);
+			spheres.add(center, glm::length(extent));
+			boxes.add(center - extent, center + extent);
+		}
+		agree = report("spheres", spheres, frustum) && agree;
+		agree = report("boxes", boxes, frustum) && agree;
+		if (size == BATCH_SIZES[sizeof(BATCH_SIZES) / sizeof(BATCH_SIZES[0]) - 1]) {
+			agree = reportThreading("spheres", spheres, frustum) && agree;
+			agree = reportThreading("boxes", boxes, frustum) && agree;
+		}
+	}
+	Culling::printCounters();
+	if (!agree) {
+		std::cout << "ERROR::CULLING::PATHS_DISAGREE" << std::endl;
+		return EXIT_FAILURE;
+	}
+	return EXIT_SUCCESS;
+}
@@ -15,15 +15,18 @@
 // Custom libs
 #include <learnopengl/shader_g.h>
 #include <learnopengl/camera.h>
+#include <learnopengl/culling.h>
+#include <learnopengl/texture_streamer.h>
 // image loading
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
 // C++ libs
 #include <iostream>
+#include <vector>
 
 // scene rendering stuff
 
-void renderScene(const Shader& shader);
+void renderScene(const Shader& shader, const Frustum& frustum);
 void renderCube();
 void renderQuad();
 
@@ -89,6 +92,9 @@ float deltaTime = 0.0f;
 float lastFrame = 0.0f;
 // meshes
 unsigned int planeVAO;
+std::vector<glm::mat4> cubeModels;
+BoundingBoxes cubeBounds;
+std::vector<unsigned int> visibleCubes;
 
 int main(void) {
 	// initialize GLFW and create window
@@ -179,6 +185,19 @@ int main(void) {
 	// light info
 	glm::vec3 lightPos(-2.0f, 4.0f, -1.0f);
 
+	// place the cubes once, each pass draws only the ones its frustum reaches
+	glm::mat4 model = glm::mat4(1.0f);
+	model = glm::translate(model, glm::vec3(0.0f, 1.5f, 0.0));
+	cubeModels.push_back(glm::scale(model, glm::vec3(0.5f)));
+	model = glm::mat4(1.0f);
+	model = glm::translate(model, glm::vec3(2.0f, 0.0f, 1.0));
+	cubeModels.push_back(glm::scale(model, glm::vec3(0.5f)));
+	model = glm::mat4(1.0f);
+	model = glm::translate(model, glm::vec3(-1.0f, 0.0f, 2.0));
+	model = glm::rotate(model, glm::radians(60.0f), glm::normalize(glm::vec3(1.0, 0.0, 1.0)));
+	cubeModels.push_back(glm::scale(model, glm::vec3(0.25)));
+	cubeBounds.assign(cubeModels.data(), cubeModels.size(), glm::vec3(-1.0f), glm::vec3(1.0f));
+
 	// render loop
 	while (!glfwWindowShouldClose(window)) {
 		// per-frame time logic
@@ -189,6 +208,9 @@ int main(void) {
 		// process input
 		processInput(window);
 
+		// stream in loaded textures
+		TextureStreamer::update();
+
 		// render
 		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -205,7 +227,7 @@ int main(void) {
 		glClear(GL_DEPTH_BUFFER_BIT);
 		glActiveTexture(GL_TEXTURE0);
 		glBindTexture(GL_TEXTURE_2D, woodTexture);
-		renderScene(simpleDepthShader);
+		renderScene(simpleDepthShader, Frustum::fromMatrix(lightSpaceMatrix));
 		glBindFramebuffer(GL_FRAMEBUFFER, 0);
 
 		// render depth map to quad for visual debugging
@@ -231,29 +253,18 @@ int main(void) {
 	return EXIT_SUCCESS;
 }
 
-void renderScene(const Shader& shader) {
+void renderScene(const Shader& shader, const Frustum& frustum) {
 	// floor
 	glm::mat4 model = glm::mat4(1.0f);
 	shader.setMat4("model", model);
 	glBindVertexArray(planeVAO);
 	glDrawArrays(GL_TRIANGLES, 0, 6);
-	// cubes
-	model = glm::mat4(1.0f);
-	model = glm::translate(model, glm::vec3(0.0f, 1.5f, 0.0));
-	model = glm::scale(model, glm::vec3(0.5f));
-	shader.setMat4("model", model);
-	renderCube();
-	model = glm::mat4(1.0f);
-	model = glm::translate(model, glm::vec3(2.0f, 0.0f, 1.0));
-	model = glm::scale(model, glm::vec3(0.5f));
-	shader.setMat4("model", model);
-	renderCube();
-	model = glm::mat4(1.0f);
-	model = glm::translate(model, glm::vec3(-1.0f, 0.0f, 2.0));
-	model = glm::rotate(model, glm::radians(60.0f), glm::normalize(glm::vec3(1.0, 0.0, 1.0)));
-	model = glm::scale(model, glm::vec3(0.25));
-	shader.setMat4("model", model);
-	renderCube();
+	// cubes, only those inside the pass's frustum
+	cubeBounds.cull(frustum, visibleCubes);
+	for (unsigned int i : visibleCubes) {
+		shader.setMat4("model", cubeModels[i]);
+		renderCube();
+	}
 }
 
 unsigned int cubeVAO = 0;
@@ -355,32 +366,9 @@ void renderQuad() {
 }
 
 unsigned int loadTexture(const char* path, bool flipVertically) {
-	unsigned int textureID;
-	glGenTextures(1, &textureID);
-	int width, height, nrChannels;
-	stbi_set_flip_vertically_on_load(flipVertically);
-	unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
-	if (data) {
-		GLenum format;
-		if (nrChannels == 1)
-			format = GL_RED;
-		else if (nrChannels == 3)
-			format = GL_RGB;
-		else if (nrChannels == 4)
-			format = GL_RGBA;
-		glBindTexture(GL_TEXTURE_2D, textureID);
-		glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-		glGenerateMipmap(GL_TEXTURE_2D);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	}
-	else {
-		std::cout << "ERROR::TEXTURE::FAILED_TO_LOAD\n" << path << std::endl;
-	}
-	stbi_image_free(data);
-	return textureID;
+	TextureOptions options;
+	options.flipVertically = flipVertically;
+	return TextureStreamer::load(path, options);
 }
 
 void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
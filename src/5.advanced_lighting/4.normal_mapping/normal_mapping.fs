@@ -18,9 +18,11 @@ uniform vec3 viewPos;
 
 void main() {           
      // obtain normal from normal map in range [0,1]
-    vec3 normal = texture(normalMap, fs_in.texCoords).rgb;
-    // transform normal vector to range [-1,1]
-    normal = normalize(normal * 2.0f - 1.0f);  // this normal is in tangent space
+    vec3 normal;
+    // transform normal vector to range [-1,1], only x and y are stored so rebuild z from the unit length
+    normal.xy = texture(normalMap, fs_in.texCoords).rg * 2.0f - 1.0f;
+    normal.z = sqrt(max(1.0f - dot(normal.xy, normal.xy), 0.0f));
+    normal = normalize(normal);  // this normal is in tangent space
     // get diffuse color
     vec3 color = texture(diffuseMap, fs_in.texCoords).rgb;
     // ambient
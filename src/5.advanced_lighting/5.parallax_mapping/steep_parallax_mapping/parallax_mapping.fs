@@ -29,8 +29,11 @@ void main() {
 
     // sample diffuse and normal map with new texture coordinates
     vec3 color = texture(diffuseMap, texCoords).rgb;
-    vec3 normal = texture(normalMap, texCoords).rgb;
-    normal = normalize(normal * 2.0f - 1.0f);  // this normal is in tangent space
+    // only x and y are stored, z is rebuilt from the unit length
+    vec3 normal;
+    normal.xy = texture(normalMap, texCoords).rg * 2.0f - 1.0f;
+    normal.z = sqrt(max(1.0f - dot(normal.xy, normal.xy), 0.0f));
+    normal = normalize(normal);  // this normal is in tangent space
     
     // ambient
     vec3 ambient = 0.1f * color;
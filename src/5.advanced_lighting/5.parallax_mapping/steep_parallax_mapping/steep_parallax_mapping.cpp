@@ -15,6 +15,7 @@
 // Custom libs
 #include <learnopengl/shader_g.h>
 #include <learnopengl/camera.h>
+#include <learnopengl/texture_streamer.h>
 // image loading
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -28,10 +29,11 @@ void renderQuad();
 /**
  * Reads a provided texture into memory
  * @param path - the path to the texture
+ * @param content - what the texture holds, deciding its compression
  * @param flipVertically - determines whether to flip the texture along the y-axis
  * @return The a texture ID
  */
-unsigned int loadTexture(const char* path, bool flipVertically = false);
+unsigned int loadTexture(const char* path, TextureContent content = TextureContent::COLOR, bool flipVertically = false);
 
  /**
   * Handle window resizing
@@ -121,8 +123,8 @@ int main(void) {
 
 	// load texture
 	unsigned int woodTexture = loadTexture(WOOD_DIFFUSE);
-	unsigned int toyBoxBumpMap = loadTexture(TOY_BOX_NORMAL);
-	unsigned int toyBoxHeightMap = loadTexture(TOY_BOX_DISPLACEMENT);
+	unsigned int toyBoxBumpMap = loadTexture(TOY_BOX_NORMAL, TextureContent::NORMAL_MAP);
+	unsigned int toyBoxHeightMap = loadTexture(TOY_BOX_DISPLACEMENT, TextureContent::HEIGHT_MAP);
 
 	// set uniforms
 	shader.use();
@@ -143,13 +145,17 @@ int main(void) {
 		// process input
 		processInput(window);
 
+		// stream in loaded textures
+		TextureStreamer::update();
+
 		// render
 		glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 		// view/projection matrices
 		glm::mat4 view = camera.getViewMatrix();
-		glm::mat4 projection = glm::perspective(glm::radians(camera.getFOV()), aspectRatio, 0.1f, 100.0f);
+		camera.setPerspective(aspectRatio, 0.1f, 100.0f);
+		glm::mat4 projection = camera.getProjectionMatrix();
 
 		// render parallax-mapped quad
 		shader.use();
@@ -261,33 +267,11 @@ void renderQuad() {
 	glBindVertexArray(0);
 }
 
-unsigned int loadTexture(const char* path, bool flipVertically) {
-	unsigned int textureID;
-	glGenTextures(1, &textureID);
-	int width, height, nrChannels;
-	stbi_set_flip_vertically_on_load(flipVertically);
-	unsigned char* data = stbi_load(path, &width, &height, &nrChannels, 0);
-	if (data) {
-		GLenum format;
-		if (nrChannels == 1)
-			format = GL_RED;
-		else if (nrChannels == 3)
-			format = GL_RGB;
-		else if (nrChannels == 4)
-			format = GL_RGBA;
-		glBindTexture(GL_TEXTURE_2D, textureID);
-		glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
-		glGenerateMipmap(GL_TEXTURE_2D);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-	}
-	else {
-		std::cout << "ERROR::TEXTURE::FAILED_TO_LOAD\n" << path << std::endl;
-	}
-	stbi_image_free(data);
-	return textureID;
+unsigned int loadTexture(const char* path, TextureContent content, bool flipVertically) {
+	TextureOptions options;
+	options.content = content;
+	options.flipVertically = flipVertically;
+	return TextureStreamer::load(path, options);
 }
 
 void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
@@ -16,6 +16,8 @@
 #include <learnopengl/shader_g.h>
 #include <learnopengl/camera.h>
 #include <learnopengl/model.h>
+#include <learnopengl/gl_state.h>
+#include <learnopengl/texture_streamer.h>
 // image loading
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -112,18 +114,17 @@ int main(void) {
 	}
 
 	// configure global OpenGL state
-	glEnable(GL_DEPTH_TEST);
+	GLState::enable(GL_DEPTH_TEST);
 
-	// create shader program objects
+	// create shader program objects, the light count is compiled into the lighting pass
+	const unsigned int NR_LIGHTS = 32;
 	Shader geometryPassShader(GEOMETRY_PASS_VERT, GEOMETRY_PASS_FRAG);
-	Shader lightingPassShader(LIGHTING_PASS_VERT, LIGHTING_PASS_FRAG);
+	Shader lightingPassShader(LIGHTING_PASS_VERT, LIGHTING_PASS_FRAG, { { "NR_LIGHTS", std::to_string(NR_LIGHTS) } });
 	Shader lightBoxShader(LIGHT_BOX_VERT, LIGHT_BOX_FRAG	);
 
-	// flip y-axis of loaded textures before loading model
-	stbi_set_flip_vertically_on_load(true);
-
 	// load model
-	Model backpack(BACKPACK);
+	Model backpack(BACKPACK, true);
+	backpack.releaseMeshData();
 	std::vector<glm::vec3> backpackPositions;
 	backpackPositions.push_back(glm::vec3(-3.0, -0.5, -3.0));
 	backpackPositions.push_back(glm::vec3(0.0, -0.5, -3.0));
@@ -138,25 +139,25 @@ int main(void) {
 	// configure g-buffer framebuffer
 	unsigned int gBuffer;
 	glGenFramebuffers(1, &gBuffer);
-	glBindFramebuffer(GL_FRAMEBUFFER, gBuffer);
+	GLState::bindFramebuffer(GL_FRAMEBUFFER, gBuffer);
 	unsigned int gPosition, gNormal, gAlbedoSpec;
 	// position color buffer
 	glGenTextures(1, &gPosition);
-	glBindTexture(GL_TEXTURE_2D, gPosition);
+	GLState::bindTexture(GL_TEXTURE_2D, gPosition);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, screenWidth, screenHeight, 0, GL_RGBA, GL_FLOAT, nullptr);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gPosition, 0);
 	// normal color buffer
 	glGenTextures(1, &gNormal);
-	glBindTexture(GL_TEXTURE_2D, gNormal);
+	GLState::bindTexture(GL_TEXTURE_2D, gNormal);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, screenWidth, screenHeight, 0, GL_RGBA, GL_FLOAT, nullptr);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, gNormal, 0);
 	// color (diffuse) + specular color buffer
 	glGenTextures(1, &gAlbedoSpec);
-	glBindTexture(GL_TEXTURE_2D, gAlbedoSpec);
+	GLState::bindTexture(GL_TEXTURE_2D, gAlbedoSpec);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, screenWidth, screenHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -173,10 +174,9 @@ int main(void) {
 	// check framebuffer completion
 	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 		std::cout << "Framebuffer not complete!" << std::endl;
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
 
 	// lighting
-	const unsigned int NR_LIGHTS = 32;
 	std::vector<glm::vec3> lightPositions;
 	std::vector<glm::vec3> lightColors;
 	srand(13);
@@ -209,59 +209,65 @@ int main(void) {
 		// process input
 		processInput(window);
 
+		// stream in loaded textures
+		TextureStreamer::update();
+
 		// render
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 		// 1. geometry pass: render scene's geometry/color data into g-buffer
-		glBindFramebuffer(GL_FRAMEBUFFER, gBuffer);
+		GLState::bindFramebuffer(GL_FRAMEBUFFER, gBuffer);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 		glm::mat4 model = glm::mat4(1.0f);
 		glm::mat4 view = camera.getViewMatrix();
-		glm::mat4 projection = glm::perspective(glm::radians(camera.getFOV()), aspectRatio, 0.1f, 100.0f);
+		camera.setPerspective(aspectRatio, 0.1f, 100.0f);
+		glm::mat4 projection = camera.getProjectionMatrix();
 		geometryPassShader.use();
 		geometryPassShader.setMat4("view", view);
 		geometryPassShader.setMat4("projection", projection);
+		glm::mat4 viewProjection = projection * view;
 		for (unsigned int i = 0; i < backpackPositions.size(); i++) {
 			model = glm::mat4(1.0f);
 			model = glm::translate(model, backpackPositions[i]);
 			model = glm::scale(model, glm::vec3(0.5f));
 			geometryPassShader.setMat4("model", model);
-			backpack.draw(geometryPassShader);
+			// skip the meshlets outside the view or facing away from the camera
+			backpack.drawClusters(geometryPassShader, model, viewProjection, camera.getPosition());
 		}
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
 
 		// 2. lighting pass: calculate lighting by iterating over a screen filled quad pixel-by-pixel using the gbuffer's content.
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 		lightingPassShader.use();
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, gPosition);
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, gNormal);
-		glActiveTexture(GL_TEXTURE2);
-		glBindTexture(GL_TEXTURE_2D, gAlbedoSpec);
+		GLState::activeTexture(GL_TEXTURE0);
+		GLState::bindTexture(GL_TEXTURE_2D, gPosition);
+		GLState::activeTexture(GL_TEXTURE1);
+		GLState::bindTexture(GL_TEXTURE_2D, gNormal);
+		GLState::activeTexture(GL_TEXTURE2);
+		GLState::bindTexture(GL_TEXTURE_2D, gAlbedoSpec);
 		// send light relevant uniforms
 		for (unsigned int i = 0; i < lightPositions.size(); i++) {
-			lightingPassShader.setVec3("lights[" + std::to_string(i) + "].position", lightPositions[i]);
-			lightingPassShader.setVec3("lights[" + std::to_string(i) + "].color", lightColors[i]);
+			lightingPassShader.set(uniformElement<glm::vec3>("lights", i, ".position"), lightPositions[i]);
+			lightingPassShader.set(uniformElement<glm::vec3>("lights", i, ".color"), lightColors[i]);
 			// update attenuation parameters and calculate radius
 			const float linear = 0.7f;
 			const float quadratic = 1.8f;
-			lightingPassShader.setFloat("lights[" + std::to_string(i) + "].linear", linear);
-			lightingPassShader.setFloat("lights[" + std::to_string(i) + "].quadratic", quadratic);
+			lightingPassShader.set(uniformElement<float>("lights", i, ".linear"), linear);
+			lightingPassShader.set(uniformElement<float>("lights", i, ".quadratic"), quadratic);
 		}
 		lightingPassShader.setVec3("viewPos", camera.getPosition());
 		// finally render quad
 		renderQuad();
 	
 		// 2.5. copy content of geometry's depth buffer to default framebuffer's depth buffer
-		glBindFramebuffer(GL_READ_FRAMEBUFFER, gBuffer);
-		glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0); // write to default framebuffer
+		GLState::bindFramebuffer(GL_READ_FRAMEBUFFER, gBuffer);
+		GLState::bindFramebuffer(GL_DRAW_FRAMEBUFFER, 0); // write to default framebuffer
 		// blit to default framebuffer. Note that this may or may not work as the internal formats of both the FBO and default framebuffer have to match.
 		// the internal formats are implementation defined. This works on all of my systems, but if it doesn't on yours you'll likely have to write to the 		
 		// depth buffer in another shader stage (or somehow see to match the default framebuffer's internal format with the FBO's internal format).
 		glBlitFramebuffer(0, 0, screenWidth, screenHeight, 0, 0, screenWidth, screenHeight, GL_DEPTH_BUFFER_BIT, GL_NEAREST);
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
 
 		// 3. render lights on top of scene
 		lightBoxShader.use();
@@ -280,6 +286,9 @@ int main(void) {
 		glfwSwapBuffers(window);
 		glfwPollEvents();
 	}
+	GLState::printCounters();
+	TextureCache::printStats();
+	GeometryArena::printStats();
 
 	// optionally deallocate all resources
 	glDeleteFramebuffers(1, &gBuffer);
@@ -307,17 +316,17 @@ void renderQuad() {
 		// setup plane VAO
 		glGenVertexArrays(1, &quadVAO);
 		glGenBuffers(1, &quadVBO);
-		glBindVertexArray(quadVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+		GLState::bindVertexArray(quadVAO);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, quadVBO);
 		glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), &quadVertices, GL_STATIC_DRAW);
 		glEnableVertexAttribArray(0);
 		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
 		glEnableVertexAttribArray(1);
 		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
 	}
-	glBindVertexArray(quadVAO);
+	GLState::bindVertexArray(quadVAO);
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-	glBindVertexArray(0);
+	GLState::bindVertexArray(0);
 }
 
 // render a 1x1 3D cube in NDC
@@ -373,23 +382,23 @@ void renderCube() {
 		glGenVertexArrays(1, &cubeVAO);
 		glGenBuffers(1, &cubeVBO);
 		// fill buffer
-		glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, cubeVBO);
 		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 		// link vertex attributes
-		glBindVertexArray(cubeVAO);
+		GLState::bindVertexArray(cubeVAO);
 		glEnableVertexAttribArray(0);
 		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
 		glEnableVertexAttribArray(1);
 		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
 		glEnableVertexAttribArray(2);
 		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		glBindVertexArray(0);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+		GLState::bindVertexArray(0);
 	}
 	// render Cube
-	glBindVertexArray(cubeVAO);
+	GLState::bindVertexArray(cubeVAO);
 	glDrawArrays(GL_TRIANGLES, 0, 36);
-	glBindVertexArray(0);
+	GLState::bindVertexArray(0);
 }
 
 void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
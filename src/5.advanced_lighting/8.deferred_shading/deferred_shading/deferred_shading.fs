@@ -12,7 +12,9 @@ struct Light {
     float linear;
     float quadratic;
 };
-const int NR_LIGHTS = 32;
+#ifndef NR_LIGHTS
+#define NR_LIGHTS 32
+#endif
 uniform Light lights[NR_LIGHTS];
 uniform vec3 viewPos;
 
@@ -13,8 +13,12 @@ struct Light {
     float quadratic;
     float radius;
 };
-const int NR_LIGHTS = 32;
+#ifndef NR_LIGHTS
+#define NR_LIGHTS 32
+#endif
 uniform Light lights[NR_LIGHTS];
+// lights in view, packed to the front of lights
+uniform int numLights;
 uniform vec3 viewPos;
 
 out vec4 fragColor;
@@ -29,7 +33,7 @@ void main() {
     // then calculate lighting as usual
     vec3 lighting  = diffuse * 0.1f; // hard-coded ambient component
     vec3 viewDir  = normalize(viewPos - fragPos);
-    for(int i = 0; i < NR_LIGHTS; i++) {
+    for(int i = 0; i < numLights; i++) {
         // calculate distance from light source and current fragment
         float distance = length(lights[i].position - fragPos);
         if (distance < lights[i].radius) {
@@ -14,8 +14,12 @@
 #include <glm/gtc/type_ptr.hpp>
 // Custom libs
 #include <learnopengl/shader_g.h>
+#include <learnopengl/shader_library.h>
+#include <learnopengl/shader_watcher.h>
 #include <learnopengl/camera.h>
 #include <learnopengl/model.h>
+#include <learnopengl/gl_state.h>
+#include <learnopengl/texture_streamer.h>
 // image loading
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
@@ -116,28 +120,28 @@ int main(void) {
 	}
 
 	// configure global OpenGL state
-	glEnable(GL_DEPTH_TEST);
+	GLState::enable(GL_DEPTH_TEST);
 
-	// create shader program objects
-	Shader geometryPassShader(GEOMETRY_PASS_VERT, GEOMETRY_PASS_FRAG);
-	Shader lightingPassShader(SSAO_VERT, LIGHTING_PASS_FRAG);
-	Shader ssaoBlur(SSAO_VERT, BLUR_FRAG);
-	Shader ssao(SSAO_VERT, SSAO_FRAG);
-
-	// flip y-axis of loaded textures before loading model
-	stbi_set_flip_vertically_on_load(true);
+	// queue every shader program so the driver builds them while the model and buffers load
+	ShaderLibrary shaders;
+	shaders.add("geometryPass", GEOMETRY_PASS_VERT, GEOMETRY_PASS_FRAG);
+	shaders.add("lightingPass", SSAO_VERT, LIGHTING_PASS_FRAG);
+	shaders.add("ssaoBlur", SSAO_VERT, BLUR_FRAG);
+	shaders.add("ssao", SSAO_VERT, SSAO_FRAG);
+	shaders.compileAll();
 
 	// load model
-	Model backpack(BACKPACK);
+	Model backpack(BACKPACK, true);
+	backpack.releaseMeshData();
 
 	// configure g-buffer framebuffer
 	unsigned int gBuffer;
 	glGenFramebuffers(1, &gBuffer);
-	glBindFramebuffer(GL_FRAMEBUFFER, gBuffer);
+	GLState::bindFramebuffer(GL_FRAMEBUFFER, gBuffer);
 	unsigned int gPosition, gNormal, gAlbedo;
 	// position color buffer
 	glGenTextures(1, &gPosition);
-	glBindTexture(GL_TEXTURE_2D, gPosition);
+	GLState::bindTexture(GL_TEXTURE_2D, gPosition);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, screenWidth, screenHeight, 0, GL_RGBA, GL_FLOAT, nullptr);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -146,14 +150,14 @@ int main(void) {
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, gPosition, 0);
 	// normal color buffer
 	glGenTextures(1, &gNormal);
-	glBindTexture(GL_TEXTURE_2D, gNormal);
+	GLState::bindTexture(GL_TEXTURE_2D, gNormal);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16F, screenWidth, screenHeight, 0, GL_RGBA, GL_FLOAT, nullptr);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT1, GL_TEXTURE_2D, gNormal, 0);
 	// color (diffuse) + specular color buffer
 	glGenTextures(1, &gAlbedo);
-	glBindTexture(GL_TEXTURE_2D, gAlbedo);
+	GLState::bindTexture(GL_TEXTURE_2D, gAlbedo);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, screenWidth, screenHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -170,16 +174,16 @@ int main(void) {
 	// check framebuffer completion
 	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 		std::cout << "Framebuffer not complete!" << std::endl;
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
 
 	// configure SSAO framebuffers
 	unsigned int ssaoFBO, ssaoBlurFBO;
 	glGenFramebuffers(1, &ssaoFBO);  glGenFramebuffers(1, &ssaoBlurFBO);
-	glBindFramebuffer(GL_FRAMEBUFFER, ssaoFBO);
+	GLState::bindFramebuffer(GL_FRAMEBUFFER, ssaoFBO);
 	unsigned int ssaoColorBuffer, ssaoColorBufferBlur;
 	// color buffer
 	glGenTextures(1, &ssaoColorBuffer);
-	glBindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
+	GLState::bindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, screenWidth, screenHeight, 0, GL_RED, GL_FLOAT, NULL);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -187,16 +191,16 @@ int main(void) {
 	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 		std::cout << "SSAO Framebuffer not complete!" << std::endl;
 	// blur stage
-	glBindFramebuffer(GL_FRAMEBUFFER, ssaoBlurFBO);
+	GLState::bindFramebuffer(GL_FRAMEBUFFER, ssaoBlurFBO);
 	glGenTextures(1, &ssaoColorBufferBlur);
-	glBindTexture(GL_TEXTURE_2D, ssaoColorBufferBlur);
+	GLState::bindTexture(GL_TEXTURE_2D, ssaoColorBufferBlur);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, screenWidth, screenHeight, 0, GL_RED, GL_FLOAT, NULL);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
 	glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, ssaoColorBufferBlur, 0);
 	if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 		std::cout << "SSAO Blur Framebuffer not complete!" << std::endl;
-	glBindFramebuffer(GL_FRAMEBUFFER, 0);
+	GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
 
 	// generate sample kernel
 	std::uniform_real_distribution<GLfloat> randomFloats(0.0, 1.0); // generates random floats between 0.0 and 1.0
@@ -220,7 +224,7 @@ int main(void) {
 		ssaoNoise.push_back(noise);
 	}
 	unsigned int noiseTexture; glGenTextures(1, &noiseTexture);
-	glBindTexture(GL_TEXTURE_2D, noiseTexture);
+	GLState::bindTexture(GL_TEXTURE_2D, noiseTexture);
 	glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA32F, 4, 4, 0, GL_RGB, GL_FLOAT, &ssaoNoise[0]);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -232,6 +236,11 @@ int main(void) {
 	glm::vec3 lightColor = glm::vec3(0.2, 0.2, 0.7);
 
 	// shader configuration
+	Shader& geometryPassShader = shaders.get("geometryPass");
+	Shader& lightingPassShader = shaders.get("lightingPass");
+	Shader& ssaoBlur = shaders.get("ssaoBlur");
+	Shader& ssao = shaders.get("ssao");
+	shaders.printTimings();
 	lightingPassShader.use();
 	lightingPassShader.setInt("gPosition", 0);
 	lightingPassShader.setInt("gNormal", 1);
@@ -244,6 +253,13 @@ int main(void) {
 	ssaoBlur.use();
 	ssaoBlur.setInt("ssaoInput", 0);
 
+	// rebuild programs whenever their source files are saved
+	ShaderWatcher watcher;
+	watcher.watch(geometryPassShader);
+	watcher.watch(lightingPassShader);
+	watcher.watch(ssaoBlur);
+	watcher.watch(ssao);
+
 	// render loop
 	while (!glfwWindowShouldClose(window)) {
 		// per-frame time logic
@@ -251,19 +267,26 @@ int main(void) {
 		deltaTime = currentFrame - lastFrame;
 		lastFrame = currentFrame;
 
+		// swap in any edited shaders
+		watcher.update();
+
 		// process input
 		processInput(window);
 
+		// stream in loaded textures
+		TextureStreamer::update();
+
 		// render
 		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
 		// 1. geometry pass: render scene's geometry/color data into g-buffer
-		glBindFramebuffer(GL_FRAMEBUFFER, gBuffer);
+		GLState::bindFramebuffer(GL_FRAMEBUFFER, gBuffer);
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 		glm::mat4 model = glm::mat4(1.0f);
 		glm::mat4 view = camera.getViewMatrix();
-		glm::mat4 projection = glm::perspective(glm::radians(camera.getFOV()), aspectRatio, 0.1f, 50.0f);
+		camera.setPerspective(aspectRatio, 0.1f, 50.0f);
+		glm::mat4 projection = camera.getProjectionMatrix();
 		geometryPassShader.use();
 		geometryPassShader.setMat4("view", view);
 		geometryPassShader.setMat4("projection", projection);
@@ -281,34 +304,34 @@ int main(void) {
 		model = glm::rotate(model, glm::radians(-90.0f), glm::vec3(1.0, 0.0, 0.0));
 		model = glm::scale(model, glm::vec3(1.0f));
 		geometryPassShader.setMat4("model", model);
-		backpack.draw(geometryPassShader);
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		backpack.draw(geometryPassShader, model, camera.getFrustum());
+		GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
 
 		// 2. generate SSAO texture
-		glBindFramebuffer(GL_FRAMEBUFFER, ssaoFBO);
+		GLState::bindFramebuffer(GL_FRAMEBUFFER, ssaoFBO);
 		glClear(GL_COLOR_BUFFER_BIT);
 		ssao.use();
 		// send kernel + rotation 
 		for (unsigned int i = 0; i < 64; i++)
-			ssao.setVec3("samples[" + std::to_string(i) + "]", ssaoKernel[i]);
+			ssao.set(uniformElement<glm::vec3>("samples", i), ssaoKernel[i]);
 		ssao.setMat4("projection", projection);
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, gPosition);
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, gNormal);
-		glActiveTexture(GL_TEXTURE2);
-		glBindTexture(GL_TEXTURE_2D, noiseTexture);
+		GLState::activeTexture(GL_TEXTURE0);
+		GLState::bindTexture(GL_TEXTURE_2D, gPosition);
+		GLState::activeTexture(GL_TEXTURE1);
+		GLState::bindTexture(GL_TEXTURE_2D, gNormal);
+		GLState::activeTexture(GL_TEXTURE2);
+		GLState::bindTexture(GL_TEXTURE_2D, noiseTexture);
 		renderQuad();
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
 
 		// 3. blur SSAO texture to remove noise
-		glBindFramebuffer(GL_FRAMEBUFFER, ssaoBlurFBO);
+		GLState::bindFramebuffer(GL_FRAMEBUFFER, ssaoBlurFBO);
 		glClear(GL_COLOR_BUFFER_BIT);
 		ssaoBlur.use();
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
+		GLState::activeTexture(GL_TEXTURE0);
+		GLState::bindTexture(GL_TEXTURE_2D, ssaoColorBuffer);
 		renderQuad();
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		GLState::bindFramebuffer(GL_FRAMEBUFFER, 0);
 
 		// 4. lighting pass: traditional deferred Blinn-Phong lighting with added screen-space ambient occlusion
 		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
@@ -322,20 +345,24 @@ int main(void) {
 		const float quadratic = 0.032f;
 		lightingPassShader.setFloat("light.linear", linear);
 		lightingPassShader.setFloat("light.quadratic", quadratic);
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, gPosition);
-		glActiveTexture(GL_TEXTURE1);
-		glBindTexture(GL_TEXTURE_2D, gNormal);
-		glActiveTexture(GL_TEXTURE2);
-		glBindTexture(GL_TEXTURE_2D, gAlbedo);
-		glActiveTexture(GL_TEXTURE3); // add extra SSAO texture to lighting pass
-		glBindTexture(GL_TEXTURE_2D, ssaoColorBufferBlur);
+		GLState::activeTexture(GL_TEXTURE0);
+		GLState::bindTexture(GL_TEXTURE_2D, gPosition);
+		GLState::activeTexture(GL_TEXTURE1);
+		GLState::bindTexture(GL_TEXTURE_2D, gNormal);
+		GLState::activeTexture(GL_TEXTURE2);
+		GLState::bindTexture(GL_TEXTURE_2D, gAlbedo);
+		GLState::activeTexture(GL_TEXTURE3); // add extra SSAO texture to lighting pass
+		GLState::bindTexture(GL_TEXTURE_2D, ssaoColorBufferBlur);
 		renderQuad();
 
 		// glfw: swap buffers and poll IO events
 		glfwSwapBuffers(window);
 		glfwPollEvents();
 	}
+	GLState::printCounters();
+	TextureCache::printStats();
+	GeometryArena::printStats();
+	Culling::printCounters();
 
 	// optionally deallocate all resources
 	glDeleteFramebuffers(1, &gBuffer);
@@ -363,17 +390,17 @@ void renderQuad() {
 		// setup plane VAO
 		glGenVertexArrays(1, &quadVAO);
 		glGenBuffers(1, &quadVBO);
-		glBindVertexArray(quadVAO);
-		glBindBuffer(GL_ARRAY_BUFFER, quadVBO);
+		GLState::bindVertexArray(quadVAO);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, quadVBO);
 		glBufferData(GL_ARRAY_BUFFER, sizeof(quadVertices), &quadVertices, GL_STATIC_DRAW);
 		glEnableVertexAttribArray(0);
 		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)0);
 		glEnableVertexAttribArray(1);
 		glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(float), (void*)(3 * sizeof(float)));
 	}
-	glBindVertexArray(quadVAO);
+	GLState::bindVertexArray(quadVAO);
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-	glBindVertexArray(0);
+	GLState::bindVertexArray(0);
 }
 
 // render a 1x1 3D cube in NDC
@@ -429,23 +456,23 @@ void renderCube() {
 		glGenVertexArrays(1, &cubeVAO);
 		glGenBuffers(1, &cubeVBO);
 		// fill buffer
-		glBindBuffer(GL_ARRAY_BUFFER, cubeVBO);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, cubeVBO);
 		glBufferData(GL_ARRAY_BUFFER, sizeof(vertices), vertices, GL_STATIC_DRAW);
 		// link vertex attributes
-		glBindVertexArray(cubeVAO);
+		GLState::bindVertexArray(cubeVAO);
 		glEnableVertexAttribArray(0);
 		glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)0);
 		glEnableVertexAttribArray(1);
 		glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(3 * sizeof(float)));
 		glEnableVertexAttribArray(2);
 		glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, 8 * sizeof(float), (void*)(6 * sizeof(float)));
-		glBindBuffer(GL_ARRAY_BUFFER, 0);
-		glBindVertexArray(0);
+		GLState::bindBuffer(GL_ARRAY_BUFFER, 0);
+		GLState::bindVertexArray(0);
 	}
 	// render Cube
-	glBindVertexArray(cubeVAO);
+	GLState::bindVertexArray(cubeVAO);
 	glDrawArrays(GL_TRIANGLES, 0, 36);
-	glBindVertexArray(0);
+	GLState::bindVertexArray(0);
 }
 
 float lerp(float a, float b, float f) {
@@ -7,6 +7,8 @@
 
 #include "game.h"
 
+#include <algorithm>
+
 Game::Game(unsigned int width, unsigned int height)
     : State(GAME_ACTIVE), Keys(), Width(width), Height(height) {
 
@@ -20,6 +22,29 @@ void Game::init() {
 
 }
 
+void Game::queueKey(int key, bool pressed, double time) {
+    if (key >= 0 && key < 1024)
+        this->keyEvents.push_back(KeyEvent{ time, key, pressed });
+}
+
+void Game::applyInput(double tickTime) {
+    for (int key : this->pendingReleases)
+        this->Keys[key] = false;
+    this->pendingReleases.clear();
+    std::vector<int> pressed;
+    while (!this->keyEvents.empty() && this->keyEvents.front().time <= tickTime) {
+        KeyEvent event = this->keyEvents.front();
+        this->keyEvents.pop_front();
+        if (event.pressed) {
+            this->Keys[event.key] = true;
+            pressed.push_back(event.key);
+        } else if (std::find(pressed.begin(), pressed.end(), event.key) != pressed.end())
+            this->pendingReleases.push_back(event.key);
+        else
+            this->Keys[event.key] = false;
+    }
+}
+
 void Game::update(float dt) {
 
 }
@@ -28,7 +53,7 @@ void Game::processInput(float dt) {
 
 }
 
-void Game::render() {
+void Game::render(float alpha) {
 
 }
 
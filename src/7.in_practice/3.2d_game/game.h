@@ -9,6 +9,9 @@
 #define GAME_H
 #pragma once
 
+#include <deque>
+#include <vector>
+
 /**
  * Represents the current state of the game
  */
@@ -34,10 +37,24 @@ public:
     ~Game();
     // initialize game state (load all shaders/textures/levels)
     void init();
-    // game loop
+    // key events stamped with the time they arrived, held until the tick they fall in
+    void queueKey(int key, bool pressed, double time);
+    // bring Keys up to the end of a tick; a key pressed during the tick reads as held for it even if already released
+    void applyInput(double tickTime);
+    // game loop, input and update run once per fixed tick of dt seconds
     void processInput(float dt);
     void update(float dt);
-    void render();
+    // alpha in [0, 1) blends the previous tick's state towards the current one, unused until the game has moving state
+    void render(float alpha);
+private:
+    struct KeyEvent {
+        double time;
+        int key;
+        bool pressed;
+    };
+    std::deque<KeyEvent> keyEvents;
+    // released during the tick they were pressed in, cleared at the start of the next
+    std::vector<int> pendingReleases;
 };
 
 #endif
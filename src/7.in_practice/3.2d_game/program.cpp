@@ -13,6 +13,9 @@
 // Game files
 #include "game.h"
 #include "resource_manager.h"
+#include <learnopengl/fixed_timestep.h>
+#include <learnopengl/gl_state.h>
+#include <learnopengl/texture_streamer.h>
 
 /**
  * Handle window resizing
@@ -38,6 +41,8 @@ const int OPENGL_VERSION_MINOR = 3;
 const unsigned int SCR_WIDTH = 800;
 const unsigned int SCR_HEIGHT = 600;
 const char* WINDOW_NAME = "Breakout";
+// simulation
+const double SIMULATION_TICK = 1.0 / 120.0;
 // Game
 Game breakout(SCR_WIDTH, SCR_HEIGHT);
 
@@ -66,34 +71,38 @@ int main() {
 
     // configure global OpenGL state
     glViewport(0, 0, SCR_WIDTH, SCR_HEIGHT);
-    glEnable(GL_BLEND);
-    glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+    GLState::enable(GL_BLEND);
+    GLState::blendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
     // initialize game
     breakout.init();
 
-    // deltaTime variables
-    float deltaTime = 0.0f;
-    float lastFrame = 0.0f;
+    // the game advances in fixed ticks however long a frame takes
+    FixedTimestepLoop loop(SIMULATION_TICK);
+    const float dt = static_cast<float>(loop.getTick());
 
     // render loop
     while (!glfwWindowShouldClose(window)) {
-        // per-frame time logic
-        float currentFrame = static_cast<float>(glfwGetTime());
-        deltaTime = currentFrame - lastFrame;
-        lastFrame = currentFrame;
         glfwPollEvents();
 
-        // manage user input
-        breakout.processInput(deltaTime);
+        // stream in loaded textures
+        TextureStreamer::update();
 
-        // update game state
-        breakout.update(deltaTime);
+        // run every tick that elapsed since the last frame, each sees only the key events stamped before it ended
+        unsigned int ticks = loop.advance();
+        for (unsigned int i = 0; i < ticks; i++) {
+            breakout.applyInput(loop.getTickTime(i));
+            breakout.processInput(dt);
+            breakout.update(dt);
+        }
 
-        // render
+        // render between the last two ticks
         glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
         glClear(GL_COLOR_BUFFER_BIT);
-        breakout.render();
+        breakout.render(loop.getAlpha());
+
+        // GLFW only delivers events when polled, so sample again after rendering rather than just once a frame
+        glfwPollEvents();
 
         glfwSwapBuffers(window);
     }
@@ -111,12 +120,9 @@ void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
 void keyCallback(GLFWwindow* window, int key, int scancode, int action, int mode) {
     if (key == GLFW_KEY_ESCAPE && action == GLFW_PRESS)
         glfwSetWindowShouldClose(window, true);
-    if (key >= 0 && key < 1024) {
-        if (action == GLFW_PRESS)
-            breakout.Keys[key] = true;
-        else if (action == GLFW_RELEASE)
-            breakout.Keys[key] = false;
-    }
+    // stamped on the simulation's clock so each lands in the tick it happened during
+    if (action == GLFW_PRESS || action == GLFW_RELEASE)
+        breakout.queueKey(key, action == GLFW_PRESS, FixedTimestepLoop::now());
 }
 
 /*******************************************************************
@@ -6,10 +6,10 @@
  */
 
 #include "resource_manager.h"
+#include <learnopengl/gl_state.h>
 #include <iostream>
 #include <sstream>
 #include <fstream>
-#include <stb_image.h>
 
  // Instantiate static variables
 std::map<std::string, Texture2D>    ResourceManager::textures;
@@ -36,11 +36,15 @@ Texture2D ResourceManager::getTexture(std::string name) {
 
 void ResourceManager::clear() {
     // (properly) delete all shaders	
-    for (auto shader : shaders)
+    for (auto shader : shaders) {
+        GLState::forgetProgram(shader.second.id);
         glDeleteProgram(shader.second.id);
+    }
     // (properly) delete all textures
-    for (auto texture : textures)
+    for (auto texture : textures) {
+        GLState::forgetTexture(texture.second.id);
         glDeleteTextures(1, &texture.second.id);
+    }
 }
 
 Shader ResourceManager::loadShaderFromFile(const char* vShaderFile, const char* fShaderFile, const char* gShaderFile) {
@@ -90,13 +94,8 @@ Texture2D ResourceManager::loadTextureFromFile(const char* file, bool alpha) {
         texture.internalFormat = GL_RGBA;
         texture.imageFormat = GL_RGBA;
     }
-    // load image
-    int width, height, nrChannels;
-    unsigned char* data = stbi_load(file, &width, &height, &nrChannels, 0);
-    // now generate texture
-    texture.generate(width, height, data);
-    // and finally free image data
-    stbi_image_free(data);
+    // load image in the background
+    texture.load(file);
     return texture;
 }
 
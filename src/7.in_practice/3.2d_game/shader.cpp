@@ -7,13 +7,22 @@
 
 #include "shader.h"
 #include <iostream>
+#include <learnopengl/program_cache.h>
+#include <learnopengl/gl_state.h>
 
 Shader& Shader::use() {
-    glUseProgram(this->id);
+    // uniform setters with useShader = true land here on every call, repeats are skipped
+    GLState::useProgram(this->id);
     return *this;
 }
 
 void Shader::compile(const char* vertexSource, const char* fragmentSource, const char* geometrySource) {
+    // reuse the driver binary from a previous launch if these exact sources were linked before
+    const char* sources[] = { vertexSource, fragmentSource, geometrySource };
+    std::uint64_t cacheKey = ProgramCache::computeKey(sources, 3);
+    this->id = glCreateProgram();
+    if (ProgramCache::load(cacheKey, this->id))
+        return;
     unsigned int sVertex, sFragment, gShader;
     // vertex Shader
     sVertex = glCreateShader(GL_VERTEX_SHADER);
@@ -33,13 +42,14 @@ void Shader::compile(const char* vertexSource, const char* fragmentSource, const
         checkCompileErrors(gShader, "GEOMETRY");
     }
     // shader program
-    this->id = glCreateProgram();
     glAttachShader(this->id, sVertex);
     glAttachShader(this->id, sFragment);
     if (geometrySource != nullptr)
         glAttachShader(this->id, gShader);
+    ProgramCache::prepare(this->id);
     glLinkProgram(this->id);
-    checkCompileErrors(this->id, "PROGRAM");
+    if (checkCompileErrors(this->id, "PROGRAM"))
+        ProgramCache::store(cacheKey, this->id);
     // delete the shaders as they're linked into our program now and no longer necessary
     glDeleteShader(sVertex);
     glDeleteShader(sFragment);
@@ -101,7 +111,7 @@ void Shader::setMatrix4(const char* name, const glm::mat4& matrix, bool useShade
     glUniformMatrix4fv(glGetUniformLocation(this->id, name), 1, false, glm::value_ptr(matrix));
 }
 
-void Shader::checkCompileErrors(unsigned int object, std::string type) {
+bool Shader::checkCompileErrors(unsigned int object, std::string type) {
     int success;
     char infoLog[1024];
     if (type != "PROGRAM") {
@@ -121,6 +131,7 @@ void Shader::checkCompileErrors(unsigned int object, std::string type) {
                 << std::endl;
         }
     }
+    return success;
 }
 
 /*******************************************************************
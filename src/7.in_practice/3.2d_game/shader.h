@@ -22,7 +22,7 @@
 class Shader {
 private:
     // checks if compilation or linking failed and if so, print the error logs
-    void checkCompileErrors(unsigned int object, std::string type);
+    bool checkCompileErrors(unsigned int object, std::string type);
 public:
     // state
     unsigned int id;
@@ -7,6 +7,7 @@
 
 #include <iostream>
 #include "texture.h"
+#include <learnopengl/gl_state.h>
 
 Texture2D::Texture2D()
     : width(0), height(0), internalFormat(GL_RGB), imageFormat(GL_RGB), wrapS(GL_REPEAT), wrapT(GL_REPEAT), filterMin(GL_LINEAR), filterMax(GL_LINEAR) {
@@ -16,20 +17,29 @@ Texture2D::Texture2D()
 void Texture2D::generate(unsigned int width, unsigned int height, unsigned char* data) {
     this->width = width;
     this->height = height;
-    // create Texture
-    glBindTexture(GL_TEXTURE_2D, this->id);
-    glTexImage2D(GL_TEXTURE_2D, 0, this->internalFormat, width, height, 0, this->imageFormat, GL_UNSIGNED_BYTE, data);
-    // set Texture wrap and filter modes
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, this->wrapS);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, this->wrapT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, this->filterMin);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, this->filterMax);
-    // unbind texture
-    glBindTexture(GL_TEXTURE_2D, 0);
+    // queue the upload, the texture shows a placeholder until the streamer copies the data over
+    TextureOptions options = this->getOptions();
+    TextureStreamer::upload(this->id, width, height, options.channels, data, options);
+}
+
+void Texture2D::load(const char* file) {
+    // decoded on a worker thread, width and height stay 0
+    TextureStreamer::load(this->id, file, this->getOptions());
 }
 
 void Texture2D::bind() const {
-    glBindTexture(GL_TEXTURE_2D, this->id);
+    GLState::bindTexture(GL_TEXTURE_2D, this->id);
+}
+
+TextureOptions Texture2D::getOptions() const {
+    TextureOptions options;
+    // a single wrap mode covers both axes
+    options.wrap = this->wrapS;
+    options.minFilter = this->filterMin;
+    options.magFilter = this->filterMax;
+    options.mipmaps = false;
+    options.channels = this->imageFormat == GL_RGBA ? 4 : this->imageFormat == GL_RED ? 1 : 3;
+    return options;
 }
 
 /*******************************************************************
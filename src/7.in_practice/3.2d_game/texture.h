@@ -10,6 +10,7 @@
 #pragma once
 
 #include <glad/glad.h>
+#include <learnopengl/texture_streamer.h>
 
 /**
  * @class Texture2D - can store and configure a texture in OpenGL.
@@ -33,8 +34,13 @@ public:
     Texture2D();
     // generates texture from image data
     void generate(unsigned int width, unsigned int height, unsigned char* data);
+    // streams the texture from an image file
+    void load(const char* file);
     // binds the texture as the current active GL_TEXTURE_2D texture object
     void bind() const;
+private:
+    // streaming options matching the texture configuration
+    TextureOptions getOptions() const;
 };
 
 #endif